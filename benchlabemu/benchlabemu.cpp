@@ -0,0 +1,218 @@
+﻿// <copyright file="benchlabemu.cpp" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include <sys/resource.h>
+
+#include "cmd_line.h"
+#include "emulator.h"
+
+
+/// <summary>
+/// Set by the signal handler to request the emulator to exit.
+/// </summary>
+static volatile std::sig_atomic_t exit_requested = 0;
+
+
+/// <summary>
+/// Requests the main loop to exit.
+/// </summary>
+static void on_signal(int) {
+    exit_requested = 1;
+}
+
+
+/// <summary>
+/// Answer the CPU time the process has consumed so far.
+/// </summary>
+static std::chrono::microseconds cpu_time(void) {
+    using namespace std::chrono;
+    struct rusage usage;
+    ::getrusage(RUSAGE_SELF, &usage);
+    return seconds(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec)
+        + microseconds(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec);
+}
+
+
+/// <summary>
+/// Tracks the progress between two reports.
+/// </summary>
+struct report_state {
+    std::chrono::microseconds cpu;
+    std::uint64_t samples;
+    std::chrono::steady_clock::time_point time;
+};
+
+
+/// <summary>
+/// Prints the sample rate and the CPU load since <paramref name="last" />
+/// and updates it to the current state.
+/// </summary>
+static void report(_Inout_ report_state& last, _In_ const emulator& emulator) {
+    using namespace std::chrono;
+    const report_state now { cpu_time(), emulator.samples(),
+        steady_clock::now() };
+
+    const auto wall = duration<double>(now.time - last.time).count();
+    if (wall > 0.0) {
+        const auto cpu = duration<double>(now.cpu - last.cpu).count();
+        const auto& faults = emulator.faults();
+        std::printf("%.1f samples/s, %.1f %% CPU, %llu commands in total, "
+            "faults: %llu stalls, %llu truncations, %llu drops, "
+            "%llu spurious\n",
+            (now.samples - last.samples) / wall,
+            100.0 * cpu / wall,
+            static_cast<unsigned long long>(emulator.commands()),
+            static_cast<unsigned long long>(faults.stalls),
+            static_cast<unsigned long long>(faults.truncations),
+            static_cast<unsigned long long>(faults.drops),
+            static_cast<unsigned long long>(faults.spurious));
+        std::fflush(stdout);
+    }
+
+    last = now;
+}
+
+
+/// <summary>
+/// The entry point of the Benchlab emulator, which creates a pseudo-terminal
+/// that can be opened by the library like a real device.
+/// </summary>
+/// <param name="argc">The number of command line arguments.</param>
+/// <param name="argv">The list of command line arguments.</param>
+/// <returns>Zero in case of success, a non-zero value otherwise.</returns>
+int main(_In_ const int argc, _In_reads_(argc) const char **argv) {
+    cmd_line cmd_line(argc, argv);
+
+    if (cmd_line.help()) {
+        cmd_line::usage(argv[0]);
+        return 0;
+    }
+
+    auto primary = ::posix_openpt(O_RDWR | O_NOCTTY | O_CLOEXEC);
+    if (primary < 0) {
+        std::perror("posix_openpt");
+        return -1;
+    }
+
+    if ((::grantpt(primary) != 0) || (::unlockpt(primary) != 0)) {
+        std::perror("Unlocking the pseudo-terminal failed");
+        return -1;
+    }
+
+    const std::string path(::ptsname(primary));
+
+    // Keep the subordinate side open ourselves, because otherwise, the
+    // primary side would be hung up whenever the library closes the device.
+    // We also put it in raw mode such that nothing the library sends before
+    // configuring the terminal is echoed.
+    auto subordinate = ::open(path.c_str(), O_RDWR | O_NOCTTY | O_CLOEXEC);
+    if (subordinate < 0) {
+        std::perror("Opening the subordinate terminal failed");
+        return -1;
+    }
+
+    {
+        struct termios tio;
+        if (::tcgetattr(subordinate, &tio) == 0) {
+            ::cfmakeraw(&tio);
+            ::tcsetattr(subordinate, TCSANOW, &tio);
+        }
+    }
+
+    if (!cmd_line.link().empty()) {
+        ::unlink(cmd_line.link().c_str());
+        if (::symlink(path.c_str(), cmd_line.link().c_str()) != 0) {
+            std::perror("Creating the symbolic link failed");
+            return -1;
+        }
+    }
+
+    std::signal(SIGINT, on_signal);
+    std::signal(SIGTERM, on_signal);
+
+    std::printf("%s\n", path.c_str());
+    std::fflush(stdout);
+
+    emulator emulator(cmd_line, primary);
+    report_state last { cpu_time(), 0, std::chrono::steady_clock::now() };
+    const auto interval = cmd_line.report();
+    std::array<std::uint8_t, 256> buffer;
+    int retval = 0;
+
+    while (!exit_requested) {
+        const auto now = std::chrono::steady_clock::now();
+        auto timeout = -1;
+
+        if (interval.count() > 0) {
+            const auto due = last.time + interval;
+            if (now >= due) {
+                report(last, emulator);
+                continue;
+            }
+
+            timeout = static_cast<int>(std::chrono::duration_cast<
+                std::chrono::milliseconds>(due - now).count()) + 1;
+        }
+
+        struct pollfd pfd { primary, POLLIN, 0 };
+        auto status = ::poll(&pfd, 1, timeout);
+        if (status < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            std::perror("poll");
+            retval = -1;
+            break;
+        }
+
+        if ((pfd.revents & POLLIN) == 0) {
+            continue;
+        }
+
+        auto cnt = ::read(primary, buffer.data(), buffer.size());
+        if (cnt < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            std::perror("read");
+            retval = -1;
+            break;
+        }
+
+        auto hr = emulator.process(buffer.data(), cnt,
+            std::chrono::steady_clock::now());
+        if (FAILED(hr)) {
+            std::fprintf(stderr, "Sending a response failed with error "
+                "%ld.\n", static_cast<long>(hr));
+            retval = -1;
+            break;
+        }
+    }
+
+    if (!cmd_line.link().empty()) {
+        ::unlink(cmd_line.link().c_str());
+    }
+
+    ::close(subordinate);
+    ::close(primary);
+
+    return retval;
+}
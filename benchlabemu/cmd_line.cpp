@@ -0,0 +1,179 @@
+﻿// <copyright file="cmd_line.cpp" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#include "cmd_line.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+
+template<class TIterator>
+static TIterator find_switch(TIterator begin, TIterator end,
+        const char *name) {
+    assert(name != nullptr);
+    return std::find_if(begin, end, [name](const char *s) {
+        return (std::strcmp(s, name) == 0);
+    });
+}
+
+
+template<class TIterator>
+static TIterator find_argument(TIterator begin, TIterator end,
+        const char *name) {
+    auto retval = ::find_switch(begin, end, name);
+    return (retval != end) ? ++retval : retval;
+}
+
+
+/*
+ * cmd_line::cmd_line
+ */
+cmd_line::cmd_line(_In_ const int argc, _In_reads_(argc) const char **argv)
+        : _faults { 0.0f, std::chrono::microseconds::zero(), 0, 0.0f, 0.0f,
+            std::chrono::milliseconds(1000), 0.0f },
+        _firmware(1),
+        _frequency(1.0f),
+        _help(false),
+        _latency(0),
+        _name("Emulator"),
+        _report(1000),
+        _waveform(waveform_type::sine) {
+    const auto begin = argv;
+    const auto end = argv + argc;
+
+    {
+        auto it = ::find_argument(begin, end, "--drop");
+        if (it != end) {
+            this->_faults.drop = static_cast<float>(std::atof(*it));
+        }
+    }
+
+    {
+        auto it = ::find_argument(begin, end, "--firmware");
+        if (it != end) {
+            this->_firmware = static_cast<std::uint8_t>(std::atoi(*it));
+        }
+    }
+
+    {
+        auto it = ::find_argument(begin, end, "--frequency");
+        if (it != end) {
+            this->_frequency = static_cast<float>(std::atof(*it));
+        }
+    }
+
+    {
+        auto it = ::find_switch(begin, end, "--help");
+        this->_help = (it != end);
+    }
+
+    {
+        auto it = ::find_argument(begin, end, "--jitter");
+        if (it != end) {
+            this->_faults.jitter = std::chrono::microseconds(std::atoll(*it));
+        }
+    }
+
+    {
+        auto it = ::find_argument(begin, end, "--latency");
+        if (it != end) {
+            this->_latency = std::chrono::microseconds(std::atoll(*it));
+        }
+    }
+
+    {
+        auto it = ::find_argument(begin, end, "--link");
+        if (it != end) {
+            this->_link = *it;
+        }
+    }
+
+    {
+        auto it = ::find_argument(begin, end, "--name");
+        if (it != end) {
+            this->_name = *it;
+        }
+    }
+
+    {
+        auto it = ::find_argument(begin, end, "--report");
+        if (it != end) {
+            this->_report = std::chrono::milliseconds(std::atoll(*it));
+        }
+    }
+
+    {
+        auto it = ::find_argument(begin, end, "--seed");
+        if (it != end) {
+            this->_faults.seed = static_cast<std::uint32_t>(std::atoll(*it));
+        }
+    }
+
+    {
+        auto it = ::find_argument(begin, end, "--spurious");
+        if (it != end) {
+            this->_faults.spurious = static_cast<float>(std::atof(*it));
+        }
+    }
+
+    {
+        auto it = ::find_argument(begin, end, "--stall");
+        if (it != end) {
+            this->_faults.stall = static_cast<float>(std::atof(*it));
+        }
+    }
+
+    {
+        auto it = ::find_argument(begin, end, "--stall-time");
+        if (it != end) {
+            this->_faults.stall_time = std::chrono::milliseconds(
+                std::atoll(*it));
+        }
+    }
+
+    {
+        auto it = ::find_argument(begin, end, "--truncate");
+        if (it != end) {
+            this->_faults.truncate = static_cast<float>(std::atof(*it));
+        }
+    }
+
+    {
+        auto it = ::find_argument(begin, end, "--waveform");
+        if ((it != end) && !::parse_waveform(this->_waveform, *it)) {
+            std::fprintf(stderr, "Unknown waveform \"%s\".\n", *it);
+            this->_help = true;
+        }
+    }
+}
+
+
+/*
+ * cmd_line::usage
+ */
+void cmd_line::usage(_In_z_ const char *programme) {
+    std::printf("Usage: %s [options]\n"
+        "  --drop <p>             Probability of dropping a byte of a sample.\n"
+        "  --firmware <version>   Firmware version to report (default: 1).\n"
+        "  --frequency <Hz>       Frequency of the waveform (default: 1).\n"
+        "  --jitter <us>          Maximum random delay added to samples.\n"
+        "  --latency <us>         Delay before each response (default: 0).\n"
+        "  --link <path>          Create a symbolic link to the terminal.\n"
+        "  --name <name>          Initial name of the device.\n"
+        "  --report <ms>          Interval of the rate and CPU reports, zero\n"
+        "                         to disable them (default: 1000).\n"
+        "  --seed <n>             Seed for the random faults (default: 0).\n"
+        "  --spurious <p>         Probability of extra bytes after a sample.\n"
+        "  --stall <p>            Probability of stalling before a sample.\n"
+        "  --stall-time <ms>      Duration of a stall (default: 1000).\n"
+        "  --truncate <p>         Probability of truncating a sample.\n"
+        "  --waveform <type>      constant, sine, square, sawtooth or noise\n"
+        "                         (default: sine).\n",
+        programme);
+}
@@ -0,0 +1,112 @@
+﻿// <copyright file="cmd_line.h" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#pragma once
+
+#include <chrono>
+#include <cinttypes>
+#include <string>
+
+#include "faults.h"
+#include "waveform.h"
+
+
+/// <summary>
+/// Holds the results of processing the command line arguments.
+/// </summary>
+class cmd_line final {
+
+public:
+
+    /// <summary>
+    /// Initialises a new instance.
+    /// </summary>
+    /// <param name="argc"></param>
+    /// <param name="argv"></param>
+    cmd_line(_In_ const int argc, _In_reads_(argc) const char **argv);
+
+    /// <summary>
+    /// Answer the faults to be injected into the sensor readings.
+    /// </summary>
+    inline const fault_config& faults(void) const noexcept {
+        return this->_faults;
+    }
+
+    /// <summary>
+    /// Answer the firmware version reported in the vendor data.
+    /// </summary>
+    inline std::uint8_t firmware(void) const noexcept {
+        return this->_firmware;
+    }
+
+    /// <summary>
+    /// Answer the frequency of the <see cref="waveform" /> in Hertz.
+    /// </summary>
+    inline float frequency(void) const noexcept {
+        return this->_frequency;
+    }
+
+    /// <summary>
+    /// Answer whether the user asked for the usage instructions.
+    /// </summary>
+    inline bool help(void) const noexcept {
+        return this->_help;
+    }
+
+    /// <summary>
+    /// Answer the time between receiving a command and sending the response.
+    /// </summary>
+    inline std::chrono::microseconds latency(void) const noexcept {
+        return this->_latency;
+    }
+
+    /// <summary>
+    /// Answer the path of a symbolic link to the pseudo-terminal that should
+    /// be created, which is empty if no link should be created.
+    /// </summary>
+    inline const std::string& link(void) const noexcept {
+        return this->_link;
+    }
+
+    /// <summary>
+    /// Answer the initial name of the emulated device.
+    /// </summary>
+    inline const std::string& name(void) const noexcept {
+        return this->_name;
+    }
+
+    /// <summary>
+    /// Answer the interval in which the emulator reports the sample rate and
+    /// its CPU load, which is zero if no reports should be printed.
+    /// </summary>
+    inline std::chrono::milliseconds report(void) const noexcept {
+        return this->_report;
+    }
+
+    /// <summary>
+    /// Answer the shape of the power readings emitted by the emulator.
+    /// </summary>
+    inline waveform_type waveform(void) const noexcept {
+        return this->_waveform;
+    }
+
+    /// <summary>
+    /// Prints the usage instructions to the console.
+    /// </summary>
+    static void usage(_In_z_ const char *programme);
+
+private:
+
+    fault_config _faults;
+    std::uint8_t _firmware;
+    float _frequency;
+    bool _help;
+    std::chrono::microseconds _latency;
+    std::string _link;
+    std::string _name;
+    std::chrono::milliseconds _report;
+    waveform_type _waveform;
+};
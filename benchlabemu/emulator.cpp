@@ -0,0 +1,304 @@
+﻿// <copyright file="emulator.cpp" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#include "emulator.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+
+#include <unistd.h>
+
+
+/*
+ * emulator::emulator
+ */
+emulator::emulator(_In_ const cmd_line& cmd_line, _In_ const int fd)
+        : _commands(0),
+        _fault_counters(),
+        _faults(cmd_line.faults()),
+        _fd(fd),
+        _firmware(cmd_line.firmware()),
+        _latency(cmd_line.latency()),
+        _name { 0 },
+        _rng(cmd_line.faults().seed),
+        _samples(0),
+        _uid { 0 },
+        _waveform(cmd_line.waveform(), cmd_line.frequency()) {
+    const auto& name = cmd_line.name();
+    std::copy_n(name.begin(), (std::min)(name.size(), this->_name.size()),
+        this->_name.begin());
+
+    // Derive a stable UID from the name, which allows for distinguishing
+    // multiple emulators running at the same time.
+    for (std::size_t i = 0; i < name.size(); ++i) {
+        this->_uid[i % this->_uid.size()] ^= static_cast<std::uint8_t>(
+            name[i] + i);
+    }
+
+    for (auto& profile : this->_fan_profiles) {
+        for (auto& f : profile) {
+            std::memset(&f, 0, sizeof(f));
+            f.fan_mode = benchlab_fan_mode::temperature_control;
+            f.temperature_source = benchlab_temperature_source::automatic;
+            f.temperature[0] = 300;
+            f.temperature[1] = 600;
+            f.duty[0] = 20;
+            f.duty[1] = 100;
+            f.ramp_step = 1;
+            f.fixed_duty = 50;
+            f.min_duty = 20;
+            f.max_duty = 100;
+            f.fan_stop = benchlab_fan_stop::off;
+        }
+    }
+
+    for (auto& r : this->_rgb_profiles) {
+        std::memset(&r, 0, sizeof(r));
+        r.mode = benchlab_rgb_mode::rainbow_cycle;
+        r.direction = benchlab_rgb_direction::clockwise;
+        r.speed = 5;
+    }
+}
+
+
+/*
+ * emulator::process
+ */
+HRESULT emulator::process(_In_reads_bytes_(cnt) const void *data,
+        _In_ const std::size_t cnt,
+        _In_ const clock_type::time_point received) {
+    assert(data != nullptr);
+    auto src = static_cast<const std::uint8_t *>(data);
+    this->_input.insert(this->_input.end(), src, src + cnt);
+
+    auto cur = this->_input.begin();
+    while (cur != this->_input.end()) {
+        const auto command = static_cast<benchlab_command>(*cur);
+        const auto size = parameter_size(command);
+
+        if (static_cast<std::size_t>(this->_input.end() - cur) < size + 1) {
+            // Wait for the rest of the parameters to arrive.
+            break;
+        }
+
+        auto hr = this->execute(command, &*cur + 1, received);
+        if (FAILED(hr)) {
+            return hr;
+        }
+
+        cur += size + 1;
+    }
+
+    this->_input.erase(this->_input.begin(), cur);
+    return S_OK;
+}
+
+
+/*
+ * emulator::parameter_size
+ */
+std::size_t emulator::parameter_size(_In_ const benchlab_command command) {
+    switch (command) {
+        case benchlab_command::action:
+            // Action, button, press/release and duration.
+            return 4;
+
+        case benchlab_command::write_name:
+            return std::tuple_size<decltype(emulator::_name)>::value;
+
+        case benchlab_command::read_fan_profile:
+            // Profile and fan.
+            return 2;
+
+        case benchlab_command::write_fan_profile:
+            return 2 + sizeof(benchlab_fan_config);
+
+        case benchlab_command::read_rgb:
+            return 1;
+
+        case benchlab_command::write_rgb:
+            return 1 + sizeof(benchlab_rgb_config);
+
+        default:
+            return 0;
+    }
+}
+
+
+/*
+ * emulator::execute
+ */
+HRESULT emulator::execute(_In_ const benchlab_command command,
+        _In_reads_bytes_(parameter_size(command)) const std::uint8_t *params,
+        _In_ const clock_type::time_point received) {
+    ++this->_commands;
+
+    switch (command) {
+        case benchlab_command::welcome: {
+            static constexpr char welcome[] = "BENCHLAB";
+            return this->respond(welcome, sizeof(welcome), received);
+        }
+
+        case benchlab_command::read_sensors: {
+            benchlab_sensor_readings readings;
+            this->_waveform(readings, received);
+            ++this->_samples;
+            return this->respond(readings, received);
+        }
+
+        case benchlab_command::action:
+            if (params[0] == static_cast<std::uint8_t>(
+                    benchlab_action::button)) {
+                std::printf("Button %hhu pressed for %d ms.\n", params[1],
+                    params[3] * 100);
+            }
+            return S_OK;
+
+        case benchlab_command::read_name:
+            return this->respond(this->_name.data(), this->_name.size(),
+                received);
+
+        case benchlab_command::write_name:
+            std::copy_n(params, this->_name.size(), this->_name.begin());
+            return S_OK;
+
+        case benchlab_command::read_fan_profile:
+            if ((params[0] >= BENCHLAB_FAN_PROFILES)
+                    || (params[1] >= BENCHLAB_FANS)) {
+                return S_OK;
+            } else {
+                auto& f = this->_fan_profiles[params[0]][params[1]];
+                return this->respond(&f, sizeof(f), received);
+            }
+
+        case benchlab_command::write_fan_profile:
+            if ((params[0] < BENCHLAB_FAN_PROFILES)
+                    && (params[1] < BENCHLAB_FANS)) {
+                auto& f = this->_fan_profiles[params[0]][params[1]];
+                std::memcpy(&f, params + 2, sizeof(f));
+            }
+            return S_OK;
+
+        case benchlab_command::read_rgb:
+            if (params[0] >= BENCHLAB_RGB_PROFILES) {
+                return S_OK;
+            } else {
+                auto& r = this->_rgb_profiles[params[0]];
+                return this->respond(&r, sizeof(r), received);
+            }
+
+        case benchlab_command::write_rgb:
+            if (params[0] < BENCHLAB_RGB_PROFILES) {
+                auto& r = this->_rgb_profiles[params[0]];
+                std::memcpy(&r, params + 1, sizeof(r));
+            }
+            return S_OK;
+
+        case benchlab_command::read_uid:
+            return this->respond(this->_uid.data(), this->_uid.size(),
+                received);
+
+        case benchlab_command::read_vendor_data: {
+            const std::array<std::uint8_t, 3> vendor_data {
+                BENCHLAB_VENDOR_ID, BENCHLAB_PRODUCT_ID, this->_firmware
+            };
+            return this->respond(vendor_data.data(), vendor_data.size(),
+                received);
+        }
+
+        default:
+            // The calibration commands are not used by the library, so we
+            // do not know their parameters and silently drop them.
+            std::fprintf(stderr, "Ignoring unsupported command %hhu.\n",
+                static_cast<std::uint8_t>(command));
+            return S_OK;
+    }
+}
+
+
+/*
+ * emulator::respond
+ */
+HRESULT emulator::respond(_In_reads_bytes_(cnt) const void *data,
+        _In_ const std::size_t cnt,
+        _In_ const clock_type::time_point received) {
+    assert(data != nullptr);
+
+    const auto due = received + this->_latency;
+    if (due > clock_type::now()) {
+        std::this_thread::sleep_until(due);
+    }
+
+    auto cur = static_cast<const std::uint8_t *>(data);
+    auto rem = cnt;
+
+    while (rem > 0) {
+        auto written = ::write(this->_fd, cur, rem);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            return static_cast<HRESULT>(-errno);
+        }
+
+        cur += written;
+        rem -= written;
+    }
+
+    return S_OK;
+}
+
+
+/*
+ * emulator::respond
+ */
+HRESULT emulator::respond(_In_ const benchlab_sensor_readings& readings,
+        _In_ const clock_type::time_point received) {
+    std::vector<std::uint8_t> response(sensor_frame::size);
+    sensor_frame::encode(response.data(), readings);
+    auto due = received;
+
+    if (this->_faults.jitter.count() > 0) {
+        std::uniform_int_distribution<std::int64_t> dist(0,
+            this->_faults.jitter.count());
+        due += std::chrono::microseconds(dist(this->_rng));
+    }
+
+    if (this->roll(this->_faults.stall)) {
+        ++this->_fault_counters.stalls;
+        due += this->_faults.stall_time;
+    }
+
+    if (this->roll(this->_faults.truncate)) {
+        ++this->_fault_counters.truncations;
+        std::uniform_int_distribution<std::size_t> dist(1,
+            response.size() - 1);
+        response.resize(dist(this->_rng));
+    }
+
+    if (this->roll(this->_faults.drop)) {
+        ++this->_fault_counters.drops;
+        std::uniform_int_distribution<std::size_t> dist(0,
+            response.size() - 1);
+        response.erase(response.begin() + dist(this->_rng));
+    }
+
+    if (this->roll(this->_faults.spurious)) {
+        ++this->_fault_counters.spurious;
+        std::uniform_int_distribution<int> cnt(1, 4);
+        std::uniform_int_distribution<int> value(0, 255);
+        for (auto i = cnt(this->_rng); i > 0; --i) {
+            response.push_back(static_cast<std::uint8_t>(value(this->_rng)));
+        }
+    }
+
+    return this->respond(response.data(), response.size(), due);
+}
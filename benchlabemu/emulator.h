@@ -0,0 +1,138 @@
+﻿// <copyright file="emulator.h" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cinttypes>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#include "libbenchlab/constants.h"
+#include "libbenchlab/types.h"
+
+#include "protocol.h"
+#include "sensor_frame.h"
+
+#include "cmd_line.h"
+#include "faults.h"
+#include "waveform.h"
+
+
+/// <summary>
+/// Emulates the firmware of a Benchlab device on the primary side of a
+/// pseudo-terminal.
+/// </summary>
+/// <remarks>
+/// The emulator processes the commands in the order in which they arrive and
+/// answers each of them with the exact bytes the firmware would send, i.e.
+/// the raw memory of the structures from <c>libbenchlab/types.h</c>.
+/// </remarks>
+class emulator final {
+
+public:
+
+    typedef std::chrono::steady_clock clock_type;
+
+    /// <summary>
+    /// Initialises a new instance.
+    /// </summary>
+    /// <param name="cmd_line">The configuration of the emulated device.
+    /// </param>
+    /// <param name="fd">The primary side of the pseudo-terminal that the
+    /// responses are written to.</param>
+    emulator(_In_ const cmd_line& cmd_line, _In_ const int fd);
+
+    /// <summary>
+    /// Answer the number of commands that have been answered so far.
+    /// </summary>
+    inline std::uint64_t commands(void) const noexcept {
+        return this->_commands;
+    }
+
+    /// <summary>
+    /// Answer the number of faults that have been injected so far.
+    /// </summary>
+    inline const fault_counters& faults(void) const noexcept {
+        return this->_fault_counters;
+    }
+
+    /// <summary>
+    /// Appends the given input to the command queue and answers all commands
+    /// that are complete.
+    /// </summary>
+    /// <param name="data">The bytes received from the library.</param>
+    /// <param name="cnt">The number of bytes received.</param>
+    /// <param name="received">The point in time when the input arrived,
+    /// which the latency of the responses is relative to.</param>
+    /// <returns><c>S_OK</c> in case of success, an error code if writing a
+    /// response failed.</returns>
+    HRESULT process(_In_reads_bytes_(cnt) const void *data,
+        _In_ const std::size_t cnt,
+        _In_ const clock_type::time_point received);
+
+    /// <summary>
+    /// Answer the number of sensor readings that have been sent so far.
+    /// </summary>
+    inline std::uint64_t samples(void) const noexcept {
+        return this->_samples;
+    }
+
+private:
+
+    /// <summary>
+    /// Answer the number of parameter bytes following the given
+    /// <paramref name="command" />.
+    /// </summary>
+    static std::size_t parameter_size(_In_ const benchlab_command command);
+
+    /// <summary>
+    /// Executes the given <paramref name="command" />.
+    /// </summary>
+    HRESULT execute(_In_ const benchlab_command command,
+        _In_reads_bytes_(parameter_size(command)) const std::uint8_t *params,
+        _In_ const clock_type::time_point received);
+
+    /// <summary>
+    /// Writes the given response once the configured latency has elapsed.
+    /// </summary>
+    HRESULT respond(_In_reads_bytes_(cnt) const void *data,
+        _In_ const std::size_t cnt,
+        _In_ const clock_type::time_point received);
+
+    /// <summary>
+    /// Writes the given sensor <paramref name="readings" /> after applying
+    /// the configured faults.
+    /// </summary>
+    HRESULT respond(_In_ const benchlab_sensor_readings& readings,
+        _In_ const clock_type::time_point received);
+
+    /// <summary>
+    /// Answer whether an event with probability <paramref name="p" /> occurs.
+    /// </summary>
+    inline bool roll(_In_ const float p) {
+        return (p > 0.0f) && (std::uniform_real_distribution<float>()(
+            this->_rng) < p);
+    }
+
+    std::uint64_t _commands;
+    std::array<std::array<benchlab_fan_config, BENCHLAB_FANS>,
+        BENCHLAB_FAN_PROFILES> _fan_profiles;
+    fault_counters _fault_counters;
+    fault_config _faults;
+    int _fd;
+    std::uint8_t _firmware;
+    std::vector<std::uint8_t> _input;
+    std::chrono::microseconds _latency;
+    std::array<char, 32> _name;
+    std::array<benchlab_rgb_config, BENCHLAB_RGB_PROFILES> _rgb_profiles;
+    std::minstd_rand _rng;
+    std::uint64_t _samples;
+    std::array<std::uint8_t, 12> _uid;
+    waveform _waveform;
+};
@@ -0,0 +1,71 @@
+﻿// <copyright file="faults.h" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#pragma once
+
+#include <chrono>
+#include <cinttypes>
+
+
+/// <summary>
+/// Configures the faults injected into the responses to
+/// <see cref="benchlab_command::read_sensors" />.
+/// </summary>
+/// <remarks>
+/// All probabilities are evaluated independently per response, i.e. a single
+/// response can be affected by multiple faults.
+/// </remarks>
+struct fault_config final {
+
+    /// <summary>
+    /// The probability of removing a single random byte from the response.
+    /// </summary>
+    float drop;
+
+    /// <summary>
+    /// The maximum random delay added to the configured latency.
+    /// </summary>
+    std::chrono::microseconds jitter;
+
+    /// <summary>
+    /// The seed of the random number generator, which makes runs
+    /// reproducible.
+    /// </summary>
+    std::uint32_t seed;
+
+    /// <summary>
+    /// The probability of appending up to four random bytes to the response.
+    /// </summary>
+    float spurious;
+
+    /// <summary>
+    /// The probability of holding back the response for
+    /// <see cref="stall_time" />.
+    /// </summary>
+    float stall;
+
+    /// <summary>
+    /// The duration of a stall, which should be longer than the read timeout
+    /// of the library to provoke a timeout.
+    /// </summary>
+    std::chrono::milliseconds stall_time;
+
+    /// <summary>
+    /// The probability of cutting off the response at a random position.
+    /// </summary>
+    float truncate;
+};
+
+
+/// <summary>
+/// Counts the faults that have actually been injected.
+/// </summary>
+struct fault_counters final {
+    std::uint64_t drops;
+    std::uint64_t spurious;
+    std::uint64_t stalls;
+    std::uint64_t truncations;
+};
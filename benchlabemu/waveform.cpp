@@ -0,0 +1,120 @@
+﻿// <copyright file="waveform.cpp" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#include "waveform.h"
+
+#include <cmath>
+#include <cstring>
+#include <iterator>
+
+
+/*
+ * ::parse_waveform
+ */
+bool parse_waveform(_Out_ waveform_type& dst, _In_z_ const char *name) {
+    static const struct {
+        const char *name;
+        waveform_type type;
+    } types[] = {
+        { "constant", waveform_type::constant },
+        { "sine", waveform_type::sine },
+        { "square", waveform_type::square },
+        { "sawtooth", waveform_type::sawtooth },
+        { "noise", waveform_type::noise },
+    };
+
+    for (auto& t : types) {
+        if (std::strcmp(t.name, name) == 0) {
+            dst = t.type;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+/*
+ * waveform::waveform
+ */
+waveform::waveform(_In_ const waveform_type type, _In_ const float frequency)
+    : _epoch(clock_type::now()), _frequency(frequency), _type(type) { }
+
+
+/*
+ * waveform::operator ()
+ */
+void waveform::operator ()(_Out_ benchlab_sensor_readings& dst,
+        _In_ const clock_type::time_point now) {
+    // The nominal voltages of the rails of an ATX power supply in millivolts,
+    // which we assign round-robin to the power sensors.
+    static constexpr std::int16_t rails[] = { 12000, 5000, 3300 };
+    const auto w = this->evaluate(now);
+
+    std::memset(&dst, 0, sizeof(dst));
+
+    for (std::size_t i = 0; i < BENCHLAB_VIN_SENSORS; ++i) {
+        dst.vin[i] = rails[i % std::size(rails)];
+    }
+
+    dst.vdd = 3300;
+    dst.vref = 1212;
+    dst.tchip = 40;
+
+    for (std::size_t i = 0; i < BENCHLAB_TEMPERATURE_SENSORS; ++i) {
+        dst.ts[i] = static_cast<std::int16_t>(350 + 50 * w);
+    }
+
+    dst.tamb = 225;
+    dst.hum = 450;
+    dst.external_fan_duty = 50;
+
+    for (std::size_t i = 0; i < BENCHLAB_POWER_SENSORS; ++i) {
+        auto& r = dst.power_readings[i];
+        r.voltage = rails[i % std::size(rails)];
+        // Let the current swing between 0.5 A and 1.5 A times the index of the
+        // sensor such that the sensors are distinguishable.
+        r.current = static_cast<std::int32_t>((i + 1) * (1000 + 500 * w));
+        r.power = static_cast<std::int32_t>(
+            static_cast<std::int64_t>(r.voltage) * r.current / 1000);
+    }
+
+    for (std::size_t i = 0; i < BENCHLAB_FANS; ++i) {
+        auto& f = dst.fans[i];
+        f.enable = 1;
+        f.duty = static_cast<std::uint8_t>(50 + 25 * w);
+        f.tach = static_cast<std::uint16_t>(1200 + 600 * w);
+    }
+}
+
+
+/*
+ * waveform::evaluate
+ */
+float waveform::evaluate(_In_ const clock_type::time_point now) {
+    constexpr auto pi = 3.14159265358979323846f;
+    const auto t = std::chrono::duration<float>(now - this->_epoch).count();
+    const auto phase = t * this->_frequency - std::floor(t * this->_frequency);
+
+    switch (this->_type) {
+        case waveform_type::sine:
+            return std::sin(2.0f * pi * phase);
+
+        case waveform_type::square:
+            return (phase < 0.5f) ? 1.0f : -1.0f;
+
+        case waveform_type::sawtooth:
+            return 2.0f * phase - 1.0f;
+
+        case waveform_type::noise:
+            return std::uniform_real_distribution<float>(-1.0f, 1.0f)(
+                this->_rng);
+
+        case waveform_type::constant:
+        default:
+            return 0.0f;
+    }
+}
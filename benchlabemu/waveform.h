@@ -0,0 +1,76 @@
+﻿// <copyright file="waveform.h" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#pragma once
+
+#include <chrono>
+#include <random>
+
+#include "libbenchlab/types.h"
+
+
+/// <summary>
+/// The shapes of the load that the emulator can simulate.
+/// </summary>
+enum class waveform_type {
+    constant,
+    sine,
+    square,
+    sawtooth,
+    noise
+};
+
+
+/// <summary>
+/// Parses the name of a <see cref="waveform_type" />.
+/// </summary>
+/// <param name="dst">Receives the waveform in case of success.</param>
+/// <param name="name">The name of the waveform.</param>
+/// <returns><c>true</c> if <paramref name="name" /> designates a valid
+/// waveform, <c>false</c> otherwise.</returns>
+bool parse_waveform(_Out_ waveform_type& dst, _In_z_ const char *name);
+
+
+/// <summary>
+/// Synthesises sensor readings that follow a configurable waveform.
+/// </summary>
+/// <remarks>
+/// All readings are produced in the raw units of the firmware, i.e.
+/// voltages in millivolts, currents in milliamperes, powers in milliwatts,
+/// and temperatures and humidity in tenths.
+/// </remarks>
+class waveform final {
+
+public:
+
+    typedef std::chrono::steady_clock clock_type;
+
+    /// <summary>
+    /// Initialises a new instance.
+    /// </summary>
+    /// <param name="type">The shape of the load.</param>
+    /// <param name="frequency">The frequency of the load in Hertz.</param>
+    waveform(_In_ const waveform_type type, _In_ const float frequency);
+
+    /// <summary>
+    /// Fills <paramref name="dst" /> with the readings at
+    /// <paramref name="now" />.
+    /// </summary>
+    void operator ()(_Out_ benchlab_sensor_readings& dst,
+        _In_ const clock_type::time_point now);
+
+private:
+
+    /// <summary>
+    /// Evaluates the normalised waveform in [-1, 1] at <paramref name="now" />.
+    /// </summary>
+    float evaluate(_In_ const clock_type::time_point now);
+
+    clock_type::time_point _epoch;
+    float _frequency;
+    std::minstd_rand _rng;
+    waveform_type _type;
+};
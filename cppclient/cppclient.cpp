@@ -28,6 +28,7 @@
 #endif /* defined(_WIN32) */
 
 #include "libbenchlab/benchlab.h"
+#include "libbenchlab/channel_descriptors.h"
 
 
 /// <summary>
@@ -35,52 +36,13 @@
 /// </summary>
 /// <param name="src"></param>
 /// <param name="sample"></param>
-/// <param name="ctx"></param>
 void on_sample(_In_ benchlab_handle src,
         _In_ const benchlab_sample *sample,
-        _In_opt_ void *ctx) {
-    typedef std::vector<std::basic_string<benchlab_char>> sensor_list;
-    auto& sensors = *static_cast<sensor_list *>(ctx);
-    _Analysis_assume_(sensors != nullptr);
-
-    for (std::size_t i = 0; i < BENCHLAB_VIN_SENSORS; ++i) {
-        std::_tcout << _T("Input voltage #") << i << _T(": ")
-            << sample->input_voltage[i] << _T(" V") << std::endl;
-    }
-
-    std::_tcout << _T("Supply voltage: ")
-        << sample->supply_voltage << _T(" V") << std::endl;
-    std::_tcout << _T("Reference voltage: ")
-        << sample->reference_voltage << _T(" V") << std::endl;
-    std::_tcout << _T("Chip temperature: ")
-        << sample->chip_temperature << _T("°C") << std::endl;
-
-    for (std::size_t i = 0; i < BENCHLAB_TEMPERATURE_SENSORS; ++i) {
-        std::_tcout << _T("Temperature #") << i << _T(": ")
-            << sample->temperatures[i] << _T(" °C") << std::endl;
-    }
-
-    std::_tcout << _T("Ambient temperature: ")
-        << sample->ambient_temperature << _T(" °C") << std::endl;
-    std::_tcout << _T("Humidity: ")
-        << sample->humidity << _T(" %") << std::endl;
-    std::_tcout << _T("External fan duty: ")
-        << sample->external_fan_duty << std::endl;
-
-    for (std::size_t i = 0; i < BENCHLAB_POWER_SENSORS; ++i) {
-        std::_tcout << _T("Voltage #") << i << _T(" (") << sensors[i]
-            << _T("): ") << sample->voltages[i] << _T(" V") << std::endl;
-        std::_tcout << _T("Current #") << i << _T(" (") << sensors[i]
-            << _T("): ") << sample->currents[i] << _T(" A") << std::endl;
-        std::_tcout << _T("Power #") << i << _T(" (") << sensors[i]
-            << _T("): ") << sample->power[i] << _T(" W") << std::endl;
-    }
-
-    for (std::size_t i = 0; i < BENCHLAB_FANS; ++i) {
-        std::_tcout << _T("Fan #") << i << _T(" speed:")
-            << sample->fan_speeds[i] << std::endl;
-        std::_tcout << _T("Fan #") << _T(" duty:")
-            << sample->fan_duties[i] << std::endl;
+        _In_opt_ void *) {
+    for (auto& d : visus::benchlab::channel_descriptors) {
+        std::_tcout << d.quantity << _T(" (") << d.name << _T("): ")
+            << visus::benchlab::channel_value(*sample, d) << _T(" ")
+            << d.unit << std::endl;
     }
 }
 
@@ -105,7 +67,6 @@ int _tmain(int argc, _TCHAR **argv) {
 
     visus::benchlab::unique_handle handle;
     HRESULT hr = S_OK;
-    auto sensors = visus::benchlab::get_power_sensors();
 
     // Initialisation phase: either open the user-defined port or probe for one
     // Benchlab device attached to the machine.
@@ -148,7 +109,7 @@ int _tmain(int argc, _TCHAR **argv) {
 
     // Stream data to 'on_sample'.
     if (SUCCEEDED(hr)) {
-        hr = benchlab_start_streaming(handle.get(), 10, &on_sample, &sensors);
+        hr = benchlab_start_streaming(handle.get(), 10, &on_sample, nullptr);
     }
 
     if (SUCCEEDED(hr)) {
@@ -9,6 +9,28 @@
 #include <sstream>
 
 
+/// <summary>
+/// The channels of a power sensor in the order they are written to a row.
+/// </summary>
+static constexpr benchlab_channel power_channels[] = {
+    benchlab_channel::voltage,
+    benchlab_channel::current,
+    benchlab_channel::power
+};
+
+
+/// <summary>
+/// Gets the descriptor of the given <paramref name="channel" /> of the
+/// power sensor <paramref name="sensor" />.
+/// </summary>
+static const benchlab_channel_descriptor& power_descriptor(
+        _In_ const benchlab_channel channel,
+        _In_ const std::size_t sensor) {
+    return visus::benchlab::channel_descriptors[
+        static_cast<std::size_t>(channel) + sensor];
+}
+
+
 /*
  * excel_output::excel_output
  */
@@ -82,19 +104,22 @@ void excel_output::open(void) {
             this->_sheet = output.pdispVal;
         }
 
-        // Cache the sensor names and write the header row.
-        this->_sensors = visus::benchlab::get_power_sensors();
-
+        // Write the header row from the channel descriptors.
         {
             const long row = 0;
             long col = 0;
             this->write_value(L"Timestamp", row, col++);
 
-            for (auto& s : this->_sensors) {
-                this->write_value(s + L" [V]", row, col++);
-                this->write_value(s + L" [A]", row, col++);
-                this->write_value(s + L" [W]", row, col++);
-                this->write_value(s + L" [S]", row, col++);
+            for (std::size_t s = 0; s < BENCHLAB_POWER_SENSORS; ++s) {
+                for (auto c : power_channels) {
+                    auto& d = power_descriptor(c, s);
+                    this->write_value(std::wstring(d.name) + L" [" + d.unit
+                        + L"]", row, col++);
+                }
+
+                auto& d = power_descriptor(power_channels[0], s);
+                this->write_value(std::wstring(d.name) + L" [S]", row,
+                    col++);
             }
         }
     }
@@ -138,16 +163,16 @@ excel_output& excel_output::operator <<(_In_ const benchlab_sample& rhs) {
     }
 
     auto row = this->last_row();
-    long col = 0, col_i, col_u;
+    long col = 0;
 
     this->write_value(rhs.timestamp, row, col++);
 
-    for (std::size_t s = 0; s < this->_sensors.size(); ++s) {
-        col_u = col++;
-        col_i = col++;
-        this->write_value(rhs.voltages[s], row, col_u);
-        this->write_value(rhs.currents[s], row, col_i);
-        this->write_value(rhs.power[s], row, col++);
+    for (std::size_t s = 0; s < BENCHLAB_POWER_SENSORS; ++s) {
+        const auto col_u = col;
+        for (auto c : power_channels) {
+            this->write_value(visus::benchlab::channel_value(rhs,
+                power_descriptor(c, s)), row, col++);
+        }
         this->write_formula(cell_name(row, col_u) + L"*"
             + cell_name(row, col_u), row, col++);
     }
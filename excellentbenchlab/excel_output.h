@@ -13,6 +13,7 @@
 #include <Windows.h>
 
 #include <libbenchlab/benchlab.h>
+#include <libbenchlab/channel_descriptors.h>
 
 #include <wil/com.h>
 #include <wil/resource.h>
@@ -191,7 +192,6 @@ private:
     wil::com_ptr<IDispatch> _book;
     wil::com_ptr<IDispatch> _books;
     wil::com_ptr<IDispatch> _excel;
-    std::vector<std::wstring> _sensors;
     wil::com_ptr<IDispatch> _sheet;
 };
 
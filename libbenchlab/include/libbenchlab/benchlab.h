@@ -17,7 +17,14 @@
 #endif /* defined(__cplusplus) */
 
 #include "libbenchlab/api.h"
+#include "libbenchlab/channel.h"
+#include "libbenchlab/clock.h"
+#include "libbenchlab/columns.h"
+#include "libbenchlab/hotplug.h"
+#include "libbenchlab/probe.h"
 #include "libbenchlab/serial.h"
+#include "libbenchlab/streaming.h"
+#include "libbenchlab/transport.h"
 
 
 #if defined(__cplusplus)
@@ -53,6 +60,32 @@ HRESULT LIBBENCHLAB_API benchlab_button_press(
 /// <c>E_HANDLE</c> if <paramref name="handle" /> is invalid.</returns>
 HRESULT LIBBENCHLAB_API benchlab_close(_In_ const benchlab_handle handle);
 
+/// <summary>
+/// Gets the delay between issuing a command and reading its response that is
+/// used for the given device, and the response latency measured when the
+/// device was opened.
+/// </summary>
+/// <remarks>
+/// The delay is either the value that has been configured in the
+/// <see cref="benchlab_serial_configuration" /> when opening the device, or
+/// the result of the calibration if
+/// <see cref="benchlab_serial_configuration::calibrate_command_sleep" /> was
+/// set.
+/// </remarks>
+/// <param name="out_command_sleep">Receives the delay in microseconds.
+/// </param>
+/// <param name="out_latency">Receives the median time in microseconds it took
+/// the device to answer a request for its vendor data when it was opened. It
+/// is safe to pass <c>nullptr</c>.</param>
+/// <param name="handle">The handle of the device to get the timing of.</param>
+/// <returns><c>S_OK</c> in case of success, <c>E_POINTER</c> if
+/// <paramref name="out_command_sleep" /> is <c>nullptr</c>, <c>E_HANDLE</c> if
+/// <paramref name="handle" /> is invalid.</returns>
+HRESULT LIBBENCHLAB_API benchlab_get_command_sleep(
+    _Out_ uint32_t *out_command_sleep,
+    _Out_opt_ uint32_t *out_latency,
+    _In_ benchlab_handle handle);
+
 /// <summary>
 /// Gets the user-defined device name of the Benchlab device.
 /// </summary>
@@ -104,6 +137,71 @@ HRESULT LIBBENCHLAB_API benchlab_get_firmware(
     _Out_ uint8_t *out_version,
     _In_ benchlab_handle handle);
 
+/// <summary>
+/// Gets the time until <see cref="benchlab_process" /> must be called for a
+/// device streaming via <see cref="benchlab_start_streaming_external" /> even
+/// if its descriptor has not become readable.
+/// </summary>
+/// <remarks>
+/// The timeout changes whenever <see cref="benchlab_process" /> is called, so
+/// it must be retrieved again before the event loop waits the next time.
+/// </remarks>
+/// <param name="out_timeout">Receives the timeout in microseconds, which is
+/// zero if <see cref="benchlab_process" /> should be called right away.
+/// </param>
+/// <param name="handle">The handle of the streaming device.</param>
+/// <returns><c>S_OK</c> in case of success, <c>E_POINTER</c> if
+/// <paramref name="out_timeout" /> is <c>nullptr</c>, <c>E_HANDLE</c> if
+/// <paramref name="handle" /> is invalid, <c>E_NOT_VALID_STATE</c> if the
+/// device is not streaming via
+/// <see cref="benchlab_start_streaming_external" />.</returns>
+HRESULT LIBBENCHLAB_API benchlab_get_next_wakeup(
+    _Out_ uint64_t *out_timeout,
+    _In_ benchlab_handle handle);
+
+/// <summary>
+/// Gets the descriptor that becomes readable when a device streaming via
+/// <see cref="benchlab_start_streaming_external" /> has sent data.
+/// </summary>
+/// <remarks>
+/// The descriptor can be registered with <c>poll</c>, <c>epoll</c> or any
+/// event loop built on them, but the caller must not read from it or close
+/// it. It remains valid until the device is closed.
+/// </remarks>
+/// <param name="out_descriptor">Receives the file descriptor.</param>
+/// <param name="handle">The handle of the streaming device.</param>
+/// <returns><c>S_OK</c> in case of success, <c>E_POINTER</c> if
+/// <paramref name="out_descriptor" /> is <c>nullptr</c>, <c>E_HANDLE</c> if
+/// <paramref name="handle" /> is invalid, <c>E_NOT_VALID_STATE</c> if the
+/// device is not streaming via
+/// <see cref="benchlab_start_streaming_external" />, <c>E_NOTIMPL</c> on
+/// Windows or if the transport of the device has no descriptor. In the latter
+/// case, the device can still be driven by calling
+/// <see cref="benchlab_process" /> after the timeout reported by
+/// <see cref="benchlab_get_next_wakeup" />.</returns>
+HRESULT LIBBENCHLAB_API benchlab_get_poll_descriptor(
+    _Out_ int *out_descriptor,
+    _In_ benchlab_handle handle);
+
+/// <summary>
+/// Gets the statistics of the current or the most recent streaming session of
+/// the given Benchlab device.
+/// </summary>
+/// <remarks>
+/// <para>This function can be called while the device is streaming. The
+/// statistics are reset when streaming is started and remain available after
+/// it has been stopped.</para>
+/// </remarks>
+/// <param name="out_statistics">Receives the statistics.</param>
+/// <param name="handle">The handle of the device to get the statistics of.
+/// </param>
+/// <returns><c>S_OK</c> in case of success, <c>E_POINTER</c> if
+/// <paramref name="out_statistics" /> is <c>nullptr</c>, <c>E_HANDLE</c> if
+/// <paramref name="handle" /> is invalid.</returns>
+HRESULT LIBBENCHLAB_API benchlab_get_streaming_statistics(
+    _Out_ benchlab_streaming_statistics *out_statistics,
+    _In_ benchlab_handle handle);
+
 /// <summary>
 /// Gets the names of the power sensors available as a multi-sz string.
 /// </summary>
@@ -148,6 +246,35 @@ HRESULT LIBBENCHLAB_API benchlab_open(_Out_ benchlab_handle *out_handle,
     _In_z_ const benchlab_char *com_port,
     _In_opt_ const benchlab_serial_configuration *config);
 
+/// <summary>
+/// Opens a handle to a Benchlab telemetry system connected via the given
+/// <paramref name="transport" />.
+/// </summary>
+/// <remarks>
+/// This function allows for connecting to emulated devices and recordings
+/// instead of real hardware. The library takes ownership of the
+/// <paramref name="transport" /> in any case, i.e. the caller must not use
+/// or destroy it after the call, even if the call failed.
+/// </remarks>
+/// <param name="out_handle">Receives the handle for the power measurement
+/// device in case of success.</param>
+/// <param name="transport">The transport connecting the library with the
+/// device.</param>
+/// <param name="config">The configuration used for the serial port. Only the
+/// timeouts and the command sleep are relevant here, because the transport
+/// has already been opened. It is safe to pass <c>nullptr</c>, in which case
+/// the function will obtain the default configuration by calling
+/// <see cref="benchlab_initialise_serial_configuration" />.</param>
+/// <returns><c>S_OK</c> in case of success,
+/// <c>E_POINTER</c> if <paramref name="out_handle"/> is <c>nullptr</c>,
+/// <c>E_HANDLE</c> if <paramref name="transport" /> is <c>nullptr</c>,
+/// <c>E_NOTIMPL</c> if the device on the other end of the transport is not a
+/// Benchlab device, or an error code if the communication failed.</returns>
+HRESULT LIBBENCHLAB_API benchlab_open_transport(
+    _Out_ benchlab_handle *out_handle,
+    _In_ benchlab_transport_handle transport,
+    _In_opt_ const benchlab_serial_configuration *config);
+
 /// <summary>
 /// Convert the given sensor <paramref name="readings" /> to a sample using
 /// Volts, Amperes and Watts rather than the internal units.
@@ -164,10 +291,70 @@ HRESULT LIBBENCHLAB_API benchlab_readings_to_sample(
     _In_ const benchlab_sensor_readings *readings,
     _In_opt_ const benchlab_timestamp *timestamp);
 
+/// <summary>
+/// Converts <paramref name="cnt" /> sensor readings to samples at once like
+/// <see cref="benchlab_readings_to_sample" />.
+/// </summary>
+/// <remarks>
+/// The conversion uses the vector instructions of the processor if
+/// available, which are determined when the function is called for the
+/// first time. The results are the same as for converting the readings one
+/// by one.
+/// </remarks>
+/// <param name="out_samples">A buffer to receive at least
+/// <paramref name="cnt" /> samples.</param>
+/// <param name="readings">The <paramref name="cnt" /> sensor readings to be
+/// converted.</param>
+/// <param name="cnt">The number of readings to be converted.</param>
+/// <param name="timestamps">An optional array of <paramref name="cnt" />
+/// timestamps to be set in the samples. If this parameter is
+/// <c>nullptr</c>, all samples receive the same timestamp created from the
+/// current system time.</param>
+/// <returns><c>S_OK</c> in case of success, <c>E_POINTER</c> if
+/// <paramref name="out_samples" /> or <paramref name="readings" /> is
+/// <c>nullptr</c> while <paramref name="cnt" /> is positive.</returns>
+HRESULT LIBBENCHLAB_API benchlab_readings_to_sample_batch(
+    _Out_writes_(cnt) benchlab_sample *out_samples,
+    _In_reads_(cnt) const benchlab_sensor_readings *readings,
+    _In_ const size_t cnt,
+    _In_reads_opt_(cnt) const benchlab_timestamp *timestamps);
+
+/// <summary>
+/// Converts <paramref name="cnt" /> frames as sent by the device into
+/// samples.
+/// </summary>
+/// <remarks>
+/// In contrast to reinterpreting the frames as
+/// <see cref="benchlab_sensor_readings" />, this function does not depend on
+/// how the compiler lays out the structures, because it parses the frames
+/// according to the wire format of the firmware.
+/// </remarks>
+/// <param name="out_samples">A buffer to receive at least
+/// <paramref name="cnt" /> samples.</param>
+/// <param name="frames">The <paramref name="cnt" /> consecutive frames of
+/// <see cref="BENCHLAB_SENSOR_FRAME_SIZE" /> bytes each.</param>
+/// <param name="cnt">The number of frames to be converted.</param>
+/// <param name="timestamps">An optional array of <paramref name="cnt" />
+/// timestamps to be set in the samples. If this parameter is
+/// <c>nullptr</c>, all samples receive the same timestamp created from the
+/// current system time.</param>
+/// <returns><c>S_OK</c> in case of success, <c>E_POINTER</c> if
+/// <paramref name="out_samples" /> or <paramref name="frames" /> is
+/// <c>nullptr</c> while <paramref name="cnt" /> is positive.</returns>
+HRESULT LIBBENCHLAB_API benchlab_frames_to_samples(
+    _Out_writes_(cnt) benchlab_sample *out_samples,
+    _In_reads_bytes_(cnt * BENCHLAB_SENSOR_FRAME_SIZE) const void *frames,
+    _In_ const size_t cnt,
+    _In_reads_opt_(cnt) const benchlab_timestamp *timestamps);
+
 /// <summary>
 /// Opens at most <paramref name="cnt" /> Benchlab telemetry devices connected
 /// to the local machine.
 /// </summary>
+/// <remarks>
+/// This function is equivalent to <see cref="benchlab_probe_ex" /> with the
+/// default probe configuration.
+/// </remarks>
 /// <param name="out_handles">A buffer to receive at least
 /// <paramref name="cnt" /> handles to devices. The caller is responsible to
 /// close all <paramref name="cnt" /> handles using
@@ -190,6 +377,96 @@ HRESULT LIBBENCHLAB_API benchlab_probe(
     _Out_writes_opt_(*cnt) benchlab_handle *out_handles,
     _Inout_ size_t *cnt);
 
+/// <summary>
+/// Opens at most <paramref name="cnt" /> Benchlab telemetry devices connected
+/// to the local machine using the specified probe configuration.
+/// </summary>
+/// <remarks>
+/// The handshakes with all candidate ports run concurrently, each of them
+/// bounded by <see cref="benchlab_probe_configuration::timeout" />. The
+/// callback in the configuration, if any, is invoked on the calling thread
+/// for every port once all handshakes have completed.
+/// </remarks>
+/// <param name="out_handles">A buffer to receive at least
+/// <paramref name="cnt" /> handles to devices. The caller is responsible to
+/// close all <paramref name="cnt" /> handles using
+/// <see cref="benchlab_close" /> unless the return value is
+/// <c>HRESULT_FROM_WIN32(ERROR_INSUFFICIENT_BUFFER)</c>, in which case
+/// <paramref name="cnt" /> will report the required buffer size, but nothing
+/// will have been returned.</param>
+/// <param name="cnt">On entry, the number of handles that can be saved to
+/// <paramref name="out_handles" />, on successful exit, the number of handles
+/// that have actually been saved. If the buffer was reported to be too small,
+/// the required size will be returned to this variable.</param>
+/// <param name="config">The probe configuration. If this is <c>nullptr</c>,
+/// the default configuration will be used.</param>
+/// <returns><c>S_OK</c> in case the operation succeeded,
+/// <c>HRESULT_FROM_WIN32(ERROR_INSUFFICIENT_BUFFER)</c> if there were more
+/// candidate ports than could be stored to <paramref name="out_handles" />,
+/// <c>E_NOT_SET</c> if no device at all was found,
+/// <c>E_INVALIDARG</c> if the configuration is invalid,
+/// another error code if the ports could not be enumerated.</returns>
+HRESULT LIBBENCHLAB_API benchlab_probe_ex(
+    _Out_writes_opt_(*cnt) benchlab_handle *out_handles,
+    _Inout_ size_t *cnt,
+    _In_opt_ const benchlab_probe_configuration *config);
+
+/// <summary>
+/// Advances the acquisition of a device streaming via
+/// <see cref="benchlab_start_streaming_external" /> as far as possible without
+/// blocking.
+/// </summary>
+/// <remarks>
+/// <para>This function must be called whenever the descriptor obtained from
+/// <see cref="benchlab_get_poll_descriptor" /> becomes readable and whenever
+/// the timeout obtained from <see cref="benchlab_get_next_wakeup" /> has
+/// expired. Calling it at other times is harmless.</para>
+/// <para>Samples are delivered to the callback from within this function.
+/// </para>
+/// <para>The function must not be called concurrently with any other function
+/// for the same device, but any number of devices can be processed on the
+/// same thread.</para>
+/// </remarks>
+/// <param name="handle">The handle of the streaming device.</param>
+/// <returns><c>S_OK</c> if the device continues streaming, <c>E_HANDLE</c>
+/// if <paramref name="handle" /> is invalid, <c>E_NOT_VALID_STATE</c> if the
+/// device is not streaming via
+/// <see cref="benchlab_start_streaming_external" />, or the error that stopped
+/// streaming. In the latter case, the device does not need to be stopped
+/// anymore.</returns>
+HRESULT LIBBENCHLAB_API benchlab_process(
+    _In_ benchlab_handle handle);
+
+/// <summary>
+/// Retrieves the samples that a device has buffered while streaming without
+/// waiting for new ones.
+/// </summary>
+/// <remarks>
+/// <para>Samples are only buffered if
+/// <see cref="benchlab_streaming_configuration::buffer_size" /> was non-zero
+/// when streaming was started. The samples remain available after streaming
+/// has stopped until it is started again.</para>
+/// <para>The samples are retrieved in the order in which they were acquired.
+/// Only a single thread may retrieve the samples of a device at any time,
+/// and it must not do so while the device is being started.</para>
+/// </remarks>
+/// <param name="out_samples">A buffer to receive at least
+/// <paramref name="cnt" /> samples.</param>
+/// <param name="cnt">On entry, the size of <paramref name="out_samples" />
+/// in number of elements, on exit the number of samples retrieved.</param>
+/// <param name="handle">The handle of the streaming device.</param>
+/// <returns><c>S_OK</c> in case of success, which includes no sample being
+/// available at the moment, <c>E_POINTER</c> if <paramref name="cnt" /> or
+/// <paramref name="out_samples" /> is <c>nullptr</c> or if
+/// <paramref name="cnt" /> is zero, <c>E_HANDLE</c> if
+/// <paramref name="handle" /> is invalid, <c>E_NOT_VALID_STATE</c> if all
+/// samples have been retrieved and the device is not streaming into a buffer
+/// anymore.</returns>
+HRESULT LIBBENCHLAB_API benchlab_poll_samples(
+    _Out_writes_to_(*cnt, *cnt) benchlab_sample *out_samples,
+    _Inout_ size_t *cnt,
+    _In_ benchlab_handle handle);
+
 /// <summary>
 /// Read a RGB profile from the Benchlab.
 /// </summary>
@@ -249,12 +526,64 @@ HRESULT LIBBENCHLAB_API benchlab_start_streaming(
     _In_ const benchlab_sample_callback callback,
     _In_opt_ void *context);
 
+/// <summary>
+/// Starts asynchronously streaming data from a Benchlab device as described by
+/// the given streaming configuration.
+/// </summary>
+/// <param name="handle">The handle of the device to stream from.</param>
+/// <param name="config">The configuration of the stream, which must have been
+/// initialised using <see cref="benchlab_initialise_streaming_configuration" />
+/// before setting the callback and any custom parameters.</param>
+/// <returns><c>S_OK</c> in case of success, <c>E_HANDLE</c> if
+/// <paramref name="handle" /> is invalid, <c>E_POINTER</c> if
+/// <paramref name="config" /> is <c>nullptr</c>, <c>E_INVALIDARG</c> if the
+/// configuration has an unsupported version or an invalid member, e.g. a
+/// period of zero, neither a callback nor a buffer or a batch callback with
+/// a batch size of zero,
+/// <c>E_NOT_VALID_STATE</c> if the device was already streaming,
+/// <c>E_NOTIMPL</c> if the configuration specifies a reactor, but the device
+/// is connected via a transport that cannot be used in a reactor.</returns>
+HRESULT LIBBENCHLAB_API benchlab_start_streaming_ex(
+    _In_ const benchlab_handle handle,
+    _In_ const benchlab_streaming_configuration *config);
+
+/// <summary>
+/// Starts streaming data from a Benchlab device without a thread, such that
+/// the acquisition can be driven from an event loop of the caller.
+/// </summary>
+/// <remarks>
+/// <para>After the device has been started, the caller waits for the
+/// descriptor obtained from <see cref="benchlab_get_poll_descriptor" /> to
+/// become readable or for the timeout obtained from
+/// <see cref="benchlab_get_next_wakeup" /> to expire and calls
+/// <see cref="benchlab_process" /> in both cases.</para>
+/// <para>Streaming is stopped via <see cref="benchlab_stop_streaming" />,
+/// which might block until the response to an outstanding request has been
+/// received.</para>
+/// </remarks>
+/// <param name="handle">The handle of the device to stream from.</param>
+/// <param name="config">The configuration of the stream, which must have been
+/// initialised using <see cref="benchlab_initialise_streaming_configuration" />
+/// before setting the callback and any custom parameters. The reactor in the
+/// configuration is ignored.</param>
+/// <returns><c>S_OK</c> in case of success, <c>E_HANDLE</c> if
+/// <paramref name="handle" /> is invalid, <c>E_POINTER</c> if
+/// <paramref name="config" /> is <c>nullptr</c>, <c>E_INVALIDARG</c> if the
+/// configuration has an unsupported version or an invalid member, e.g. a
+/// period of zero, neither a callback nor a buffer or a batch callback with
+/// a batch size of zero,
+/// <c>E_NOT_VALID_STATE</c> if the device was already streaming.</returns>
+HRESULT LIBBENCHLAB_API benchlab_start_streaming_external(
+    _In_ const benchlab_handle handle,
+    _In_ const benchlab_streaming_configuration *config);
+
 /// <summary>
 /// Stops the asynchronous streaming from the given Benchlab device.
 /// </summary>
 /// <remarks>
-/// This method blocks until the thread delivering the samples actually stopped
-/// and it is safe to invalidate any previously installed callback.
+/// This method blocks until the thread or reactor delivering the samples
+/// actually stopped and it is safe to invalidate any previously installed
+/// callback.
 /// </remarks>
 /// <param name="handle">The handle of the device to stop streaming from.</param>
 /// <returns><c>S_OK</c> in case of success, <c>E_HANDLE</c> if
@@ -263,6 +592,33 @@ HRESULT LIBBENCHLAB_API benchlab_start_streaming(
 HRESULT LIBBENCHLAB_API benchlab_stop_streaming(
     _In_ const benchlab_handle handle);
 
+/// <summary>
+/// Retrieves the samples that a device has buffered while streaming and waits
+/// for new ones if none are available.
+/// </summary>
+/// <remarks>
+/// This function behaves like <see cref="benchlab_poll_samples" /> except for
+/// blocking the calling thread until at least one sample is available, the
+/// device stops streaming or the <paramref name="timeout" /> expires. The
+/// thread acquiring the samples wakes the waiting thread without taking any
+/// lock.
+/// </remarks>
+/// <param name="out_samples">A buffer to receive at least
+/// <paramref name="cnt" /> samples.</param>
+/// <param name="cnt">On entry, the size of <paramref name="out_samples" />
+/// in number of elements, on exit the number of samples retrieved.</param>
+/// <param name="timeout">The maximum time to wait in milliseconds.</param>
+/// <param name="handle">The handle of the streaming device.</param>
+/// <returns><c>S_OK</c> if at least one sample has been retrieved,
+/// <c>HRESULT_FROM_WIN32(ERROR_TIMEOUT)</c> if no sample arrived within the
+/// <paramref name="timeout" />, or any of the errors of
+/// <see cref="benchlab_poll_samples" />.</returns>
+HRESULT LIBBENCHLAB_API benchlab_wait_samples(
+    _Out_writes_to_(*cnt, *cnt) benchlab_sample *out_samples,
+    _Inout_ size_t *cnt,
+    _In_ const uint32_t timeout,
+    _In_ benchlab_handle handle);
+
 /// <summary>
 /// Updates the RGB configuration of the given Benchlab device.
 /// </summary>
@@ -354,26 +710,58 @@ namespace benchlab {
         return hr;
     }
 
+    /// <summary>
+    /// Opens a handle to a Benchlab telemetry system connected via the given
+    /// <paramref name="transport" />.
+    /// </summary>
+    /// <param name="out_handle">Receives the handle for the power measurement
+    /// device in case of success.</param>
+    /// <param name="transport">The transport connecting the library with the
+    /// device. The library takes ownership of the transport in any case.
+    /// </param>
+    /// <param name="config">The configuration used for the device. It is safe
+    /// to pass <c>nullptr</c>.</param>
+    /// <returns><c>S_OK</c> in case of success, an error code otherwise.
+    /// </returns>
+    inline HRESULT open(_Out_ unique_handle& out_handle,
+            _Inout_ unique_transport&& transport,
+            _In_opt_ const benchlab_serial_configuration *config) {
+        benchlab_handle handle = nullptr;
+        auto hr = ::benchlab_open_transport(&handle, transport.release(),
+            config);
+        out_handle.reset(handle);
+        return hr;
+    }
+
     /// <summary>
     /// Opens all Benchlab telemetry devices connected to the local machine.
     /// </summary>
     /// <param name="out_handles">A vector that receives the handles.</param>
+    /// <param name="config">The probe configuration. It is safe to pass
+    /// <c>nullptr</c>.</param>
     /// <returns><c>S_OK</c> in case the operation succeeded, <c>E_NOT_SET</c>
     /// if no device at all was found, another error code if establishing the
     /// connection to the device failed.</returns>
-    inline HRESULT probe(_Inout_ std::vector<unique_handle>& out_handles) {
+    inline HRESULT probe(_Inout_ std::vector<unique_handle>& out_handles,
+            _In_opt_ const benchlab_probe_configuration *config = nullptr) {
         std::vector<benchlab_handle> handles(1);
         std::size_t cnt = handles.size();
         
-        auto hr = ::benchlab_probe(handles.data(), &cnt);
+        auto hr = ::benchlab_probe_ex(handles.data(), &cnt, config);
         if ((hr == HRESULT_FROM_WIN32(ERROR_INSUFFICIENT_BUFFER))) {
             handles.resize(cnt);
-            hr = ::benchlab_probe(handles.data(), &cnt);
+            hr = ::benchlab_probe_ex(handles.data(), &cnt, config);
+        }
+
+        // Only the first 'cnt' handles are valid, and none if the probe
+        // failed.
+        if (FAILED(hr)) {
+            cnt = 0;
         }
 
         out_handles.resize(cnt);
         std::transform(handles.begin(),
-            handles.end(),
+            handles.begin() + cnt,
             out_handles.begin(),
             [](benchlab_handle handle) { return unique_handle(handle); });
 
@@ -0,0 +1,282 @@
+﻿// <copyright file="channel.h" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#if !defined(_BENCHLAB_CHANNEL_H)
+#define _BENCHLAB_CHANNEL_H
+#pragma once
+
+#include "libbenchlab/api.h"
+#include "libbenchlab/types.h"
+
+
+/// <summary>
+/// Identifies the channels of a <see cref="benchlab_sample" />.
+/// </summary>
+/// <remarks>
+/// The channels are numbered in the order of the members of
+/// <see cref="benchlab_sample" />. For members that comprise several sensors,
+/// the enumeration designates the first one, and the sensors follow
+/// consecutively.
+/// </remarks>
+LIBBENCHLAB_ENUM_BEGIN(benchlab_channel, uint8_t)
+#if defined(__cplusplus)
+    input_voltage = 0,
+    supply_voltage = 13,
+    reference_voltage = 14,
+    chip_temperature = 15,
+    temperature = 16,
+    ambient_temperature = 20,
+    humidity = 21,
+    external_fan_duty = 22,
+    voltage = 23,
+    current = 34,
+    power = 45,
+    fan_speed = 56,
+    fan_duty = 65
+#else /* defined(__cplusplus) */
+#define benchlab_channel_input_voltage ((benchlab_channel) 0)
+#define benchlab_channel_supply_voltage ((benchlab_channel) 13)
+#define benchlab_channel_reference_voltage ((benchlab_channel) 14)
+#define benchlab_channel_chip_temperature ((benchlab_channel) 15)
+#define benchlab_channel_temperature ((benchlab_channel) 16)
+#define benchlab_channel_ambient_temperature ((benchlab_channel) 20)
+#define benchlab_channel_humidity ((benchlab_channel) 21)
+#define benchlab_channel_external_fan_duty ((benchlab_channel) 22)
+#define benchlab_channel_voltage ((benchlab_channel) 23)
+#define benchlab_channel_current ((benchlab_channel) 34)
+#define benchlab_channel_power ((benchlab_channel) 45)
+#define benchlab_channel_fan_speed ((benchlab_channel) 56)
+#define benchlab_channel_fan_duty ((benchlab_channel) 65)
+#endif /* defined(__cplusplus) */
+LIBBENCHLAB_ENUM_END()
+
+
+/// <summary>
+/// Identifies the types of the raw readings and the converted values of a
+/// channel.
+/// </summary>
+LIBBENCHLAB_ENUM_BEGIN(benchlab_value_type, uint8_t)
+#if defined(__cplusplus)
+    int16 = 0,
+    uint16 = 1,
+    int32 = 2,
+    uint8 = 3,
+    float32 = 4
+#else /* defined(__cplusplus) */
+#define benchlab_value_type_int16 ((benchlab_value_type) 0)
+#define benchlab_value_type_uint16 ((benchlab_value_type) 1)
+#define benchlab_value_type_int32 ((benchlab_value_type) 2)
+#define benchlab_value_type_uint8 ((benchlab_value_type) 3)
+#define benchlab_value_type_float32 ((benchlab_value_type) 4)
+#endif /* defined(__cplusplus) */
+LIBBENCHLAB_ENUM_END()
+
+
+/// <summary>
+/// Describes where a channel is found in the raw readings, how it is
+/// converted and how it is presented.
+/// </summary>
+/// <remarks>
+/// The library holds one descriptor for each of the
+/// <see cref="BENCHLAB_CHANNELS" /> channels, which can be obtained via
+/// <see cref="benchlab_get_channel_descriptor" />. C++ code can use the
+/// very same descriptors at compile time from
+/// <c>libbenchlab/channel_descriptors.h</c>.
+/// </remarks>
+typedef struct LIBBENCHLAB_API benchlab_channel_descriptor_t {
+
+    /// <summary>
+    /// The channel the descriptor belongs to.
+    /// </summary>
+    benchlab_channel channel;
+
+    /// <summary>
+    /// The zero-based index of the sensor within the <see cref="channel" />.
+    /// </summary>
+    size_t sensor;
+
+    /// <summary>
+    /// The name of the sensor, e.g. the name of a power rail. The name is
+    /// only unique in combination with the <see cref="quantity" />.
+    /// </summary>
+    const benchlab_char *name;
+
+    /// <summary>
+    /// The name of the quantity measured, e.g. &quot;Voltage&quot;.
+    /// </summary>
+    const benchlab_char *quantity;
+
+    /// <summary>
+    /// The unit of the converted value.
+    /// </summary>
+    const benchlab_char *unit;
+
+    /// <summary>
+    /// The offset of the raw reading in bytes, which is the same in a
+    /// sensor frame and in <see cref="benchlab_sensor_readings" />.
+    /// </summary>
+    size_t raw_offset;
+
+    /// <summary>
+    /// The type of the raw reading.
+    /// </summary>
+    benchlab_value_type raw_type;
+
+    /// <summary>
+    /// The divisor that scales the raw reading to the <see cref="unit" />.
+    /// </summary>
+    float divisor;
+
+    /// <summary>
+    /// Indicates whether <see cref="invalid_value" /> marks a sensor that is
+    /// not connected, in which case the converted value is the lowest
+    /// finite float.
+    /// </summary>
+    bool has_invalid_value;
+
+    /// <summary>
+    /// The raw reading of a sensor that is not connected if
+    /// <see cref="has_invalid_value" /> is set.
+    /// </summary>
+    int32_t invalid_value;
+
+    /// <summary>
+    /// The offset of the converted value in <see cref="benchlab_sample" />.
+    /// </summary>
+    size_t sample_offset;
+
+    /// <summary>
+    /// The type of the converted value in <see cref="benchlab_sample" />.
+    /// </summary>
+    benchlab_value_type sample_type;
+} benchlab_channel_descriptor;
+
+
+/// <summary>
+/// Selects a subset of the <see cref="BENCHLAB_CHANNELS" /> channels of a
+/// sample.
+/// </summary>
+/// <remarks>
+/// Bit <c>i % 64</c> of word <c>i / 64</c> selects the channel with index
+/// <c>i</c>. Masks should be filled using
+/// <see cref="benchlab_select_channel" /> and
+/// <see cref="benchlab_select_all_channels" />. A mask that is all zeros
+/// selects nothing.
+/// </remarks>
+typedef struct LIBBENCHLAB_API benchlab_channel_mask_t {
+    uint64_t bits[(BENCHLAB_CHANNELS + 63) / 64];
+} benchlab_channel_mask;
+
+
+/// <summary>
+/// The callback to be invoked when a new compact sample arrives.
+/// </summary>
+/// <remarks>
+/// A compact sample comprises only the channels selected in the
+/// <see cref="benchlab_channel_mask" /> of the stream, which are passed as
+/// <paramref name="cnt" /> floating-point <paramref name="values" /> in
+/// ascending order of the channels. The values are only valid until the
+/// callback returns.
+/// </remarks>
+typedef void (*benchlab_compact_callback)(
+    _In_ benchlab_handle source,
+    _In_ benchlab_timestamp timestamp,
+    _In_reads_(cnt) const float *values,
+    _In_ size_t cnt,
+    _In_opt_ void *context);
+
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* defined(__cplusplus) */
+
+/// <summary>
+/// Answer the number of channels selected in the given mask.
+/// </summary>
+/// <param name="out_cnt">Receives the number of selected channels, which is
+/// the number of values in a compact sample.</param>
+/// <param name="mask">The mask to be evaluated.</param>
+/// <returns><c>S_OK</c> in case of success, <c>E_POINTER</c> if any of the
+/// pointers is <c>nullptr</c>.</returns>
+HRESULT LIBBENCHLAB_API benchlab_count_channels(
+    _Out_ size_t *out_cnt,
+    _In_ const benchlab_channel_mask *mask);
+
+/// <summary>
+/// Gets the descriptor of the channel with the given index.
+/// </summary>
+/// <param name="out_descriptor">Receives the descriptor. The strings it
+/// points to are owned by the library and valid as long as the library is
+/// loaded.</param>
+/// <param name="index">The index of the channel, which must be less than
+/// <see cref="BENCHLAB_CHANNELS" />.</param>
+/// <returns><c>S_OK</c> in case of success, <c>E_POINTER</c> if
+/// <paramref name="out_descriptor" /> is <c>nullptr</c>,
+/// <c>E_INVALIDARG</c> if the <paramref name="index" /> is out of range.
+/// </returns>
+HRESULT LIBBENCHLAB_API benchlab_get_channel_descriptor(
+    _Out_ benchlab_channel_descriptor *out_descriptor,
+    _In_ const size_t index);
+
+/// <summary>
+/// Extracts the channels selected in <paramref name="mask" /> from the
+/// given sensor <paramref name="readings" /> into a compact sample.
+/// </summary>
+/// <remarks>
+/// The values are converted exactly like by
+/// <see cref="benchlab_readings_to_sample" />, but only the selected
+/// channels are converted at all.
+/// </remarks>
+/// <param name="out_values">Receives the values of the selected channels in
+/// ascending order of the channels. This parameter may be <c>nullptr</c>
+/// for measuring the required buffer size.</param>
+/// <param name="cnt">The number of values that <paramref name="out_values" />
+/// can hold on entry, the number of values written or required on exit.
+/// </param>
+/// <param name="readings">The raw readings to be converted.</param>
+/// <param name="mask">The channels to be extracted.</param>
+/// <returns><c>S_OK</c> in case of success, <c>E_POINTER</c> if any of the
+/// pointers is <c>nullptr</c>, or
+/// <c>HRESULT_FROM_WIN32(ERROR_INSUFFICIENT_BUFFER)</c> if the buffer is
+/// too small.</returns>
+HRESULT LIBBENCHLAB_API benchlab_readings_to_compact(
+    _Out_writes_to_opt_(*cnt, *cnt) float *out_values,
+    _Inout_ size_t *cnt,
+    _In_ const benchlab_sensor_readings *readings,
+    _In_ const benchlab_channel_mask *mask);
+
+/// <summary>
+/// Selects all channels in the given mask.
+/// </summary>
+/// <param name="mask">The mask to be filled.</param>
+/// <returns><c>S_OK</c> in case of success, <c>E_POINTER</c> if
+/// <paramref name="mask" /> is <c>nullptr</c>.</returns>
+HRESULT LIBBENCHLAB_API benchlab_select_all_channels(
+    _Out_ benchlab_channel_mask *mask);
+
+/// <summary>
+/// Adds the specified channel to the given mask.
+/// </summary>
+/// <param name="mask">The mask to be modified.</param>
+/// <param name="channel">The channel to be selected.</param>
+/// <param name="sensor">The zero-based index of the sensor if the
+/// <paramref name="channel" /> comprises several ones, e.g. the index of
+/// the rail for <see cref="benchlab_channel::power" />. This must be zero
+/// for channels with a single sensor.</param>
+/// <returns><c>S_OK</c> in case of success, <c>E_POINTER</c> if
+/// <paramref name="mask" /> is <c>nullptr</c>, <c>E_INVALIDARG</c> if the
+/// <paramref name="sensor" /> does not exist for the
+/// <paramref name="channel" />.</returns>
+HRESULT LIBBENCHLAB_API benchlab_select_channel(
+    _Inout_ benchlab_channel_mask *mask,
+    _In_ const benchlab_channel channel,
+    _In_ const size_t sensor);
+
+#if defined(__cplusplus)
+}
+#endif /* defined(__cplusplus) */
+
+#endif /* !defined(_BENCHLAB_CHANNEL_H) */
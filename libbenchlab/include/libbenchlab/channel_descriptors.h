@@ -0,0 +1,345 @@
+﻿// <copyright file="channel_descriptors.h" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#if !defined(_BENCHLAB_CHANNEL_DESCRIPTORS_H)
+#define _BENCHLAB_CHANNEL_DESCRIPTORS_H
+#pragma once
+
+#include "libbenchlab/channel.h"
+
+#if defined(__cplusplus)
+#include <cinttypes>
+#include <cstddef>
+#include <cstring>
+
+
+namespace visus {
+namespace benchlab {
+namespace detail {
+
+    /// <summary>
+    /// Creates a <see cref="benchlab_channel_descriptor" /> at compile time.
+    /// </summary>
+    constexpr benchlab_channel_descriptor describe_channel(
+            _In_ const benchlab_channel channel,
+            _In_ const std::size_t sensor,
+            _In_z_ const benchlab_char *name,
+            _In_z_ const benchlab_char *quantity,
+            _In_z_ const benchlab_char *unit,
+            _In_ const std::size_t raw_offset,
+            _In_ const benchlab_value_type raw_type,
+            _In_ const float divisor,
+            _In_ const bool has_invalid_value,
+            _In_ const std::int32_t invalid_value,
+            _In_ const std::size_t sample_offset,
+            _In_ const benchlab_value_type sample_type) noexcept {
+        return benchlab_channel_descriptor {
+            channel, sensor, name, quantity, unit, raw_offset, raw_type,
+            divisor, has_invalid_value, invalid_value, sample_offset,
+            sample_type
+        };
+    }
+
+    /// <summary>
+    /// The raw reading of a voltage or temperature sensor that is not
+    /// connected.
+    /// </summary>
+    constexpr std::int32_t unconnected_sensor = 0x7FFF;
+
+    constexpr benchlab_channel_descriptor input_voltage(
+            _In_ const std::size_t i,
+            _In_z_ const benchlab_char *name) noexcept {
+        return describe_channel(benchlab_channel::input_voltage, i, name,
+            BENCHLAB_STR("Input voltage"), BENCHLAB_STR("V"),
+            offsetof(benchlab_sensor_readings, vin) + i * sizeof(std::int16_t),
+            benchlab_value_type::int16, 1000.0f, true, unconnected_sensor,
+            offsetof(benchlab_sample, input_voltage) + i * sizeof(float),
+            benchlab_value_type::float32);
+    }
+
+    constexpr benchlab_channel_descriptor supply_voltage(void) noexcept {
+        return describe_channel(benchlab_channel::supply_voltage, 0,
+            BENCHLAB_STR("VDD"), BENCHLAB_STR("Supply voltage"),
+            BENCHLAB_STR("V"),
+            offsetof(benchlab_sensor_readings, vdd),
+            benchlab_value_type::uint16, 1000.0f, false, 0,
+            offsetof(benchlab_sample, supply_voltage),
+            benchlab_value_type::float32);
+    }
+
+    constexpr benchlab_channel_descriptor reference_voltage(void) noexcept {
+        return describe_channel(benchlab_channel::reference_voltage, 0,
+            BENCHLAB_STR("VREF"), BENCHLAB_STR("Reference voltage"),
+            BENCHLAB_STR("V"),
+            offsetof(benchlab_sensor_readings, vref),
+            benchlab_value_type::uint16, 1000.0f, false, 0,
+            offsetof(benchlab_sample, reference_voltage),
+            benchlab_value_type::float32);
+    }
+
+    constexpr benchlab_channel_descriptor chip_temperature(void) noexcept {
+        return describe_channel(benchlab_channel::chip_temperature, 0,
+            BENCHLAB_STR("TCHIP"), BENCHLAB_STR("Chip temperature"),
+            BENCHLAB_STR("\u00B0C"),
+            offsetof(benchlab_sensor_readings, tchip),
+            benchlab_value_type::int16, 1.0f, false, 0,
+            offsetof(benchlab_sample, chip_temperature),
+            benchlab_value_type::float32);
+    }
+
+    constexpr benchlab_channel_descriptor temperature(
+            _In_ const std::size_t i,
+            _In_z_ const benchlab_char *name) noexcept {
+        return describe_channel(benchlab_channel::temperature, i, name,
+            BENCHLAB_STR("Temperature"), BENCHLAB_STR("\u00B0C"),
+            offsetof(benchlab_sensor_readings, ts) + i * sizeof(std::int16_t),
+            benchlab_value_type::int16, 10.0f, true, unconnected_sensor,
+            offsetof(benchlab_sample, temperatures) + i * sizeof(float),
+            benchlab_value_type::float32);
+    }
+
+    constexpr benchlab_channel_descriptor ambient_temperature(void) noexcept {
+        return describe_channel(benchlab_channel::ambient_temperature, 0,
+            BENCHLAB_STR("TAMB"), BENCHLAB_STR("Ambient temperature"),
+            BENCHLAB_STR("\u00B0C"),
+            offsetof(benchlab_sensor_readings, tamb),
+            benchlab_value_type::int16, 10.0f, false, 0,
+            offsetof(benchlab_sample, ambient_temperature),
+            benchlab_value_type::float32);
+    }
+
+    constexpr benchlab_channel_descriptor humidity(void) noexcept {
+        return describe_channel(benchlab_channel::humidity, 0,
+            BENCHLAB_STR("HUM"), BENCHLAB_STR("Humidity"), BENCHLAB_STR("%"),
+            offsetof(benchlab_sensor_readings, hum),
+            benchlab_value_type::uint16, 10.0f, false, 0,
+            offsetof(benchlab_sample, humidity),
+            benchlab_value_type::float32);
+    }
+
+    constexpr benchlab_channel_descriptor external_fan_duty(void) noexcept {
+        return describe_channel(benchlab_channel::external_fan_duty, 0,
+            BENCHLAB_STR("FANEXT"), BENCHLAB_STR("Fan duty"),
+            BENCHLAB_STR("%"),
+            offsetof(benchlab_sensor_readings, external_fan_duty),
+            benchlab_value_type::uint8, 1.0f, false, 0,
+            offsetof(benchlab_sample, external_fan_duty),
+            benchlab_value_type::uint8);
+    }
+
+    constexpr benchlab_channel_descriptor voltage(
+            _In_ const std::size_t i,
+            _In_z_ const benchlab_char *name) noexcept {
+        return describe_channel(benchlab_channel::voltage, i, name,
+            BENCHLAB_STR("Voltage"), BENCHLAB_STR("V"),
+            offsetof(benchlab_sensor_readings, power_readings)
+                + i * sizeof(benchlab_power_reading)
+                + offsetof(benchlab_power_reading, voltage),
+            benchlab_value_type::int16, 1000.0f, false, 0,
+            offsetof(benchlab_sample, voltages) + i * sizeof(float),
+            benchlab_value_type::float32);
+    }
+
+    constexpr benchlab_channel_descriptor current(
+            _In_ const std::size_t i,
+            _In_z_ const benchlab_char *name) noexcept {
+        return describe_channel(benchlab_channel::current, i, name,
+            BENCHLAB_STR("Current"), BENCHLAB_STR("A"),
+            offsetof(benchlab_sensor_readings, power_readings)
+                + i * sizeof(benchlab_power_reading)
+                + offsetof(benchlab_power_reading, current),
+            benchlab_value_type::int32, 1000.0f, false, 0,
+            offsetof(benchlab_sample, currents) + i * sizeof(float),
+            benchlab_value_type::float32);
+    }
+
+    constexpr benchlab_channel_descriptor power(
+            _In_ const std::size_t i,
+            _In_z_ const benchlab_char *name) noexcept {
+        return describe_channel(benchlab_channel::power, i, name,
+            BENCHLAB_STR("Power"), BENCHLAB_STR("W"),
+            offsetof(benchlab_sensor_readings, power_readings)
+                + i * sizeof(benchlab_power_reading)
+                + offsetof(benchlab_power_reading, power),
+            benchlab_value_type::int32, 1000.0f, false, 0,
+            offsetof(benchlab_sample, power) + i * sizeof(float),
+            benchlab_value_type::float32);
+    }
+
+    constexpr benchlab_channel_descriptor fan_speed(
+            _In_ const std::size_t i,
+            _In_z_ const benchlab_char *name) noexcept {
+        return describe_channel(benchlab_channel::fan_speed, i, name,
+            BENCHLAB_STR("Fan speed"), BENCHLAB_STR("rpm"),
+            offsetof(benchlab_sensor_readings, fans)
+                + i * sizeof(benchlab_fan_reading)
+                + offsetof(benchlab_fan_reading, tach),
+            benchlab_value_type::uint16, 1.0f, false, 0,
+            offsetof(benchlab_sample, fan_speeds) + i * sizeof(std::uint16_t),
+            benchlab_value_type::uint16);
+    }
+
+    constexpr benchlab_channel_descriptor fan_duty(
+            _In_ const std::size_t i,
+            _In_z_ const benchlab_char *name) noexcept {
+        return describe_channel(benchlab_channel::fan_duty, i, name,
+            BENCHLAB_STR("Fan duty"), BENCHLAB_STR("%"),
+            offsetof(benchlab_sensor_readings, fans)
+                + i * sizeof(benchlab_fan_reading)
+                + offsetof(benchlab_fan_reading, duty),
+            benchlab_value_type::uint8, 1.0f, false, 0,
+            offsetof(benchlab_sample, fan_duties) + i * sizeof(std::uint8_t),
+            benchlab_value_type::uint8);
+    }
+
+} /* namespace detail */
+
+
+    /// <summary>
+    /// The descriptors of all channels, indexed by the number of the channel.
+    /// </summary>
+    /// <remarks>
+    /// This table is the single source of truth about the channels. The
+    /// library generates its conversion routines from it at compile time, and
+    /// it answers <see cref="benchlab_get_channel_descriptor" /> from it.
+    /// </remarks>
+    constexpr benchlab_channel_descriptor channel_descriptors[] = {
+        detail::input_voltage(0, BENCHLAB_STR("VIN1")),
+        detail::input_voltage(1, BENCHLAB_STR("VIN2")),
+        detail::input_voltage(2, BENCHLAB_STR("VIN3")),
+        detail::input_voltage(3, BENCHLAB_STR("VIN4")),
+        detail::input_voltage(4, BENCHLAB_STR("VIN5")),
+        detail::input_voltage(5, BENCHLAB_STR("VIN6")),
+        detail::input_voltage(6, BENCHLAB_STR("VIN7")),
+        detail::input_voltage(7, BENCHLAB_STR("VIN8")),
+        detail::input_voltage(8, BENCHLAB_STR("VIN9")),
+        detail::input_voltage(9, BENCHLAB_STR("VIN10")),
+        detail::input_voltage(10, BENCHLAB_STR("VIN11")),
+        detail::input_voltage(11, BENCHLAB_STR("VIN12")),
+        detail::input_voltage(12, BENCHLAB_STR("VIN13")),
+        detail::supply_voltage(),
+        detail::reference_voltage(),
+        detail::chip_temperature(),
+        detail::temperature(0, BENCHLAB_STR("TS1")),
+        detail::temperature(1, BENCHLAB_STR("TS2")),
+        detail::temperature(2, BENCHLAB_STR("TS3")),
+        detail::temperature(3, BENCHLAB_STR("TS4")),
+        detail::ambient_temperature(),
+        detail::humidity(),
+        detail::external_fan_duty(),
+        detail::voltage(0, BENCHLAB_STR("EPS1")),
+        detail::voltage(1, BENCHLAB_STR("EPS2")),
+        detail::voltage(2, BENCHLAB_STR("ATX3V")),
+        detail::voltage(3, BENCHLAB_STR("ATX5V")),
+        detail::voltage(4, BENCHLAB_STR("ATX5VSB")),
+        detail::voltage(5, BENCHLAB_STR("ATX12V")),
+        detail::voltage(6, BENCHLAB_STR("PCIE1")),
+        detail::voltage(7, BENCHLAB_STR("PCIE2")),
+        detail::voltage(8, BENCHLAB_STR("PCIE3")),
+        detail::voltage(9, BENCHLAB_STR("HPWR1")),
+        detail::voltage(10, BENCHLAB_STR("HPWR2")),
+        detail::current(0, BENCHLAB_STR("EPS1")),
+        detail::current(1, BENCHLAB_STR("EPS2")),
+        detail::current(2, BENCHLAB_STR("ATX3V")),
+        detail::current(3, BENCHLAB_STR("ATX5V")),
+        detail::current(4, BENCHLAB_STR("ATX5VSB")),
+        detail::current(5, BENCHLAB_STR("ATX12V")),
+        detail::current(6, BENCHLAB_STR("PCIE1")),
+        detail::current(7, BENCHLAB_STR("PCIE2")),
+        detail::current(8, BENCHLAB_STR("PCIE3")),
+        detail::current(9, BENCHLAB_STR("HPWR1")),
+        detail::current(10, BENCHLAB_STR("HPWR2")),
+        detail::power(0, BENCHLAB_STR("EPS1")),
+        detail::power(1, BENCHLAB_STR("EPS2")),
+        detail::power(2, BENCHLAB_STR("ATX3V")),
+        detail::power(3, BENCHLAB_STR("ATX5V")),
+        detail::power(4, BENCHLAB_STR("ATX5VSB")),
+        detail::power(5, BENCHLAB_STR("ATX12V")),
+        detail::power(6, BENCHLAB_STR("PCIE1")),
+        detail::power(7, BENCHLAB_STR("PCIE2")),
+        detail::power(8, BENCHLAB_STR("PCIE3")),
+        detail::power(9, BENCHLAB_STR("HPWR1")),
+        detail::power(10, BENCHLAB_STR("HPWR2")),
+        detail::fan_speed(0, BENCHLAB_STR("FAN1")),
+        detail::fan_speed(1, BENCHLAB_STR("FAN2")),
+        detail::fan_speed(2, BENCHLAB_STR("FAN3")),
+        detail::fan_speed(3, BENCHLAB_STR("FAN4")),
+        detail::fan_speed(4, BENCHLAB_STR("FAN5")),
+        detail::fan_speed(5, BENCHLAB_STR("FAN6")),
+        detail::fan_speed(6, BENCHLAB_STR("FAN7")),
+        detail::fan_speed(7, BENCHLAB_STR("FAN8")),
+        detail::fan_speed(8, BENCHLAB_STR("FAN9")),
+        detail::fan_duty(0, BENCHLAB_STR("FAN1")),
+        detail::fan_duty(1, BENCHLAB_STR("FAN2")),
+        detail::fan_duty(2, BENCHLAB_STR("FAN3")),
+        detail::fan_duty(3, BENCHLAB_STR("FAN4")),
+        detail::fan_duty(4, BENCHLAB_STR("FAN5")),
+        detail::fan_duty(5, BENCHLAB_STR("FAN6")),
+        detail::fan_duty(6, BENCHLAB_STR("FAN7")),
+        detail::fan_duty(7, BENCHLAB_STR("FAN8")),
+        detail::fan_duty(8, BENCHLAB_STR("FAN9"))
+    };
+
+    static_assert(sizeof(channel_descriptors) / sizeof(*channel_descriptors)
+        == BENCHLAB_CHANNELS, "There is a descriptor for every channel.");
+
+namespace detail {
+
+    /// <summary>
+    /// Answer whether the <see cref="channel_descriptors" /> are indexed by
+    /// the number of the channel.
+    /// </summary>
+    constexpr bool is_channel_order(void) noexcept {
+        for (std::size_t i = 0; i < BENCHLAB_CHANNELS; ++i) {
+            auto& d = channel_descriptors[i];
+            if (static_cast<std::size_t>(d.channel) + d.sensor != i) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+} /* namespace detail */
+
+    static_assert(detail::is_channel_order(), "The channel descriptors are "
+        "ordered by the number of the channel.");
+
+    /// <summary>
+    /// Gets the converted value of the channel described by
+    /// <paramref name="descriptor" /> from <paramref name="sample" />.
+    /// </summary>
+    /// <remarks>
+    /// This allows for writing all channels of a sample in a generic way,
+    /// e.g. by iterating over <see cref="channel_descriptors" />.
+    /// </remarks>
+    inline float channel_value(_In_ const benchlab_sample& sample,
+            _In_ const benchlab_channel_descriptor& descriptor) noexcept {
+        auto src = reinterpret_cast<const std::uint8_t *>(&sample)
+            + descriptor.sample_offset;
+
+        switch (descriptor.sample_type) {
+            case benchlab_value_type::uint16: {
+                std::uint16_t retval;
+                std::memcpy(&retval, src, sizeof(retval));
+                return retval;
+            }
+
+            case benchlab_value_type::uint8:
+                return *src;
+
+            default: {
+                float retval;
+                std::memcpy(&retval, src, sizeof(retval));
+                return retval;
+            }
+        }
+    }
+
+} /* namespace benchlab */
+} /* namespace visus */
+#endif /* defined(__cplusplus) */
+
+#endif /* !defined(_BENCHLAB_CHANNEL_DESCRIPTORS_H) */
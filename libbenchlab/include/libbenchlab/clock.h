@@ -0,0 +1,187 @@
+﻿// <copyright file="clock.h" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#if !defined(_BENCHLAB_CLOCK_H)
+#define _BENCHLAB_CLOCK_H
+#pragma once
+
+#include "libbenchlab/api.h"
+#include "libbenchlab/timestamp.h"
+#include "libbenchlab/types.h"
+
+
+/// <summary>
+/// Identifies the clocks that can be used for timestamping samples.
+/// </summary>
+typedef enum LIBBENCHLAB_ENUM benchlab_clock_t {
+
+    /// <summary>
+    /// The system time as returned by <see cref="benchlab_make_timestamp" />,
+    /// which is a <c>FILETIME</c> in UTC.
+    /// </summary>
+    LIBBENCHLAB_ENUM_SCOPE(benchlab_clock, system) = 0,
+
+    /// <summary>
+    /// The high-resolution wall clock, which is <c>CLOCK_REALTIME</c> on
+    /// Linux and <c>GetSystemTimePreciseAsFileTime</c> on Windows. The
+    /// timestamps are <c>FILETIME</c>s in UTC.
+    /// </summary>
+    LIBBENCHLAB_ENUM_SCOPE(benchlab_clock, realtime) = 1,
+
+    /// <summary>
+    /// A monotonic clock that is not subject to NTP adjustments, which is
+    /// <c>CLOCK_MONOTONIC_RAW</c> on Linux and the performance counter on
+    /// Windows. The timestamps are in units of 100 ns from an unspecified
+    /// point in time.
+    /// </summary>
+    LIBBENCHLAB_ENUM_SCOPE(benchlab_clock, monotonic_raw) = 2,
+
+    /// <summary>
+    /// International Atomic Time, which is <c>CLOCK_TAI</c> on Linux and
+    /// unsupported on Windows. The timestamps are in units of 100 ns since
+    /// 1st January 1601 (TAI), i.e. they do not include leap seconds.
+    /// </summary>
+    LIBBENCHLAB_ENUM_SCOPE(benchlab_clock, tai) = 3,
+
+    /// <summary>
+    /// The time stamp counter of x86 processors, which must be invariant.
+    /// The timestamps are raw ticks, which can be converted into wall time
+    /// using <see cref="benchlab_correlate_clock" />.
+    /// </summary>
+    LIBBENCHLAB_ENUM_SCOPE(benchlab_clock, tsc) = 4
+} benchlab_clock;
+
+
+/// <summary>
+/// Identifies the point in time when a sample is timestamped.
+/// </summary>
+typedef enum LIBBENCHLAB_ENUM benchlab_timestamp_point_t {
+
+    /// <summary>
+    /// The time when the last byte of the response has been received.
+    /// </summary>
+    LIBBENCHLAB_ENUM_SCOPE(benchlab_timestamp_point, completion) = 0,
+
+    /// <summary>
+    /// The time when the command requesting the sample has been issued.
+    /// </summary>
+    LIBBENCHLAB_ENUM_SCOPE(benchlab_timestamp_point, request) = 1,
+
+    /// <summary>
+    /// The middle between <see cref="request" /> and
+    /// <see cref="completion" />, which is the best estimate of when the
+    /// device has sampled its sensors.
+    /// </summary>
+    LIBBENCHLAB_ENUM_SCOPE(benchlab_timestamp_point, midpoint) = 2
+} benchlab_timestamp_point;
+
+
+/// <summary>
+/// Relates a reading of a <see cref="benchlab_clock" /> to the wall time.
+/// </summary>
+/// <remarks>
+/// A timestamp <c>t</c> of the clock corresponds to the wall time
+/// <c>wall_time + (t - reference) * 10000000 / frequency</c>, which is what
+/// <see cref="benchlab_clock_to_wall_time" /> computes. As clocks drift
+/// against each other, a correlation should be refreshed for long
+/// recordings.
+/// </remarks>
+typedef struct LIBBENCHLAB_API benchlab_clock_correlation_t {
+
+    /// <summary>
+    /// The clock that has been correlated.
+    /// </summary>
+    benchlab_clock clock;
+
+    /// <summary>
+    /// The reading of the clock.
+    /// </summary>
+    benchlab_timestamp reference;
+
+    /// <summary>
+    /// The wall time at the same instant as a <c>FILETIME</c> in UTC.
+    /// </summary>
+    benchlab_timestamp wall_time;
+
+    /// <summary>
+    /// The number of ticks of the clock per second.
+    /// </summary>
+    double frequency;
+
+    /// <summary>
+    /// The maximum error of <see cref="wall_time" /> in units of 100 ns,
+    /// which is half the time that it took to read both clocks.
+    /// </summary>
+    benchlab_timestamp uncertainty;
+} benchlab_clock_correlation;
+
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* defined(__cplusplus) */
+
+/// <summary>
+/// Reads the current time from the given <paramref name="clock" />.
+/// </summary>
+/// <remarks>
+/// This allows for timestamping events on the host with the same clock that
+/// is used for the samples.
+/// </remarks>
+/// <param name="out_timestamp">Receives the timestamp.</param>
+/// <param name="clock">The clock to read.</param>
+/// <returns><c>S_OK</c> in case of success,
+/// <c>E_POINTER</c> if <paramref name="out_timestamp" /> is <c>nullptr</c>,
+/// <c>E_INVALIDARG</c> if <paramref name="clock" /> is not a valid clock,
+/// <c>E_NOTIMPL</c> if the clock is not supported on this machine.
+/// </returns>
+HRESULT LIBBENCHLAB_API benchlab_read_clock(
+    _Out_ benchlab_timestamp *out_timestamp,
+    _In_ const benchlab_clock clock);
+
+/// <summary>
+/// Relates the current reading of <paramref name="clock" /> to the wall
+/// time.
+/// </summary>
+/// <remarks>
+/// The frequency of the time stamp counter is calibrated against the
+/// monotonic clock when it is first correlated, which takes about 20 ms.
+/// </remarks>
+/// <param name="out_correlation">Receives the correlation.</param>
+/// <param name="clock">The clock to be correlated.</param>
+/// <returns><c>S_OK</c> in case of success,
+/// <c>E_POINTER</c> if <paramref name="out_correlation" /> is
+/// <c>nullptr</c>,
+/// <c>E_INVALIDARG</c> if <paramref name="clock" /> is not a valid clock,
+/// <c>E_NOTIMPL</c> if the clock is not supported on this machine.
+/// </returns>
+HRESULT LIBBENCHLAB_API benchlab_correlate_clock(
+    _Out_ benchlab_clock_correlation *out_correlation,
+    _In_ const benchlab_clock clock);
+
+/// <summary>
+/// Converts a <paramref name="timestamp" /> of the clock described by
+/// <paramref name="correlation" /> into wall time.
+/// </summary>
+/// <param name="out_wall_time">Receives the wall time as a <c>FILETIME</c>
+/// in UTC.</param>
+/// <param name="timestamp">The timestamp to be converted.</param>
+/// <param name="correlation">The correlation obtained from
+/// <see cref="benchlab_correlate_clock" />.</param>
+/// <returns><c>S_OK</c> in case of success,
+/// <c>E_POINTER</c> if <paramref name="out_wall_time" /> or
+/// <paramref name="correlation" /> is <c>nullptr</c>,
+/// <c>E_INVALIDARG</c> if the frequency of the correlation is not positive.
+/// </returns>
+HRESULT LIBBENCHLAB_API benchlab_clock_to_wall_time(
+    _Out_ benchlab_timestamp *out_wall_time,
+    _In_ const benchlab_timestamp timestamp,
+    _In_ const benchlab_clock_correlation *correlation);
+
+#if defined(__cplusplus)
+}
+#endif /* defined(__cplusplus) */
+
+#endif /* !defined(_BENCHLAB_CLOCK_H) */
@@ -0,0 +1,182 @@
+﻿// <copyright file="columns.h" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#if !defined(_BENCHLAB_COLUMNS_H)
+#define _BENCHLAB_COLUMNS_H
+#pragma once
+
+#if defined(__cplusplus)
+#include <memory>
+#endif /* defined(__cplusplus) */
+
+#include "libbenchlab/api.h"
+#include "libbenchlab/types.h"
+
+
+/// <summary>
+/// Stores a batch of samples as structure of arrays, i.e. with one
+/// contiguous array per channel.
+/// </summary>
+/// <remarks>
+/// <para>The members correspond to the ones of
+/// <see cref="benchlab_sample" />. Each of the arrays can hold
+/// <see cref="capacity" /> values, of which the first <see cref="count" />
+/// are valid. The arrays are aligned to cache lines.</para>
+/// <para>Instances must be created using
+/// <see cref="benchlab_create_sample_columns" />, which allocates the
+/// arrays, and released using
+/// <see cref="benchlab_destroy_sample_columns" />. Callers must not change
+/// any of the pointers, but may reset <see cref="count" /> to zero in order
+/// to reuse the batch.</para>
+/// </remarks>
+typedef struct LIBBENCHLAB_API benchlab_sample_columns_t {
+    size_t capacity;
+    size_t count;
+    benchlab_timestamp *timestamp;
+    float *input_voltage[BENCHLAB_VIN_SENSORS];
+    float *supply_voltage;
+    float *reference_voltage;
+    float *chip_temperature;
+    float *temperatures[BENCHLAB_TEMPERATURE_SENSORS];
+    float *ambient_temperature;
+    float *humidity;
+    uint8_t *external_fan_duty;
+    float *voltages[BENCHLAB_POWER_SENSORS];
+    float *currents[BENCHLAB_POWER_SENSORS];
+    float *power[BENCHLAB_POWER_SENSORS];
+    uint16_t *fan_speeds[BENCHLAB_FANS];
+    uint8_t *fan_duties[BENCHLAB_FANS];
+} benchlab_sample_columns;
+
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* defined(__cplusplus) */
+
+/// <summary>
+/// Appends <paramref name="cnt" /> sensor readings to a columnar batch,
+/// converting them like <see cref="benchlab_readings_to_sample" />.
+/// </summary>
+/// <param name="columns">The batch to append the samples to.</param>
+/// <param name="readings">The <paramref name="cnt" /> readings to be
+/// appended.</param>
+/// <param name="cnt">The number of readings to be appended.</param>
+/// <param name="timestamps">An optional array of <paramref name="cnt" />
+/// timestamps of the readings. If this parameter is <c>nullptr</c>, all
+/// readings receive the same timestamp created from the current system
+/// time.</param>
+/// <returns><c>S_OK</c> in case of success, <c>E_POINTER</c> if
+/// <paramref name="columns" /> is <c>nullptr</c> or if
+/// <paramref name="readings" /> is <c>nullptr</c> while
+/// <paramref name="cnt" /> is positive,
+/// <c>HRESULT_FROM_WIN32(ERROR_INSUFFICIENT_BUFFER)</c> if the batch cannot
+/// hold all of the readings, in which case none of them is appended.
+/// </returns>
+HRESULT LIBBENCHLAB_API benchlab_append_readings(
+    _In_ benchlab_sample_columns *columns,
+    _In_reads_(cnt) const benchlab_sensor_readings *readings,
+    _In_ const size_t cnt,
+    _In_reads_opt_(cnt) const benchlab_timestamp *timestamps);
+
+/// <summary>
+/// Appends <paramref name="cnt" /> frames as sent by the device to a columnar
+/// batch, converting them like <see cref="benchlab_frames_to_samples" />.
+/// </summary>
+/// <param name="columns">The batch to append the samples to.</param>
+/// <param name="frames">The <paramref name="cnt" /> consecutive frames of
+/// <see cref="BENCHLAB_SENSOR_FRAME_SIZE" /> bytes each.</param>
+/// <param name="cnt">The number of frames to be appended.</param>
+/// <param name="timestamps">An optional array of <paramref name="cnt" />
+/// timestamps of the frames. If this parameter is <c>nullptr</c>, all
+/// frames receive the same timestamp created from the current system time.
+/// </param>
+/// <returns><c>S_OK</c> in case of success, <c>E_POINTER</c> if
+/// <paramref name="columns" /> is <c>nullptr</c> or if
+/// <paramref name="frames" /> is <c>nullptr</c> while
+/// <paramref name="cnt" /> is positive,
+/// <c>HRESULT_FROM_WIN32(ERROR_INSUFFICIENT_BUFFER)</c> if the batch cannot
+/// hold all of the frames, in which case none of them is appended.
+/// </returns>
+HRESULT LIBBENCHLAB_API benchlab_append_frames(
+    _In_ benchlab_sample_columns *columns,
+    _In_reads_bytes_(cnt * BENCHLAB_SENSOR_FRAME_SIZE) const void *frames,
+    _In_ const size_t cnt,
+    _In_reads_opt_(cnt) const benchlab_timestamp *timestamps);
+
+/// <summary>
+/// Appends <paramref name="cnt" /> samples to a columnar batch.
+/// </summary>
+/// <param name="columns">The batch to append the samples to.</param>
+/// <param name="samples">The <paramref name="cnt" /> samples to be
+/// appended.</param>
+/// <param name="cnt">The number of samples to be appended.</param>
+/// <returns><c>S_OK</c> in case of success, <c>E_POINTER</c> if
+/// <paramref name="columns" /> is <c>nullptr</c> or if
+/// <paramref name="samples" /> is <c>nullptr</c> while
+/// <paramref name="cnt" /> is positive,
+/// <c>HRESULT_FROM_WIN32(ERROR_INSUFFICIENT_BUFFER)</c> if the batch cannot
+/// hold all of the samples, in which case none of them is appended.
+/// </returns>
+HRESULT LIBBENCHLAB_API benchlab_append_samples(
+    _In_ benchlab_sample_columns *columns,
+    _In_reads_(cnt) const benchlab_sample *samples,
+    _In_ const size_t cnt);
+
+/// <summary>
+/// Allocates an empty columnar batch for up to <paramref name="capacity" />
+/// samples.
+/// </summary>
+/// <param name="out_columns">Receives the batch in case of success.</param>
+/// <param name="capacity">The number of samples the batch can hold, which
+/// must be positive.</param>
+/// <returns><c>S_OK</c> in case of success,
+/// <c>E_POINTER</c> if <paramref name="out_columns" /> is <c>nullptr</c>,
+/// <c>E_INVALIDARG</c> if <paramref name="capacity" /> is zero,
+/// <c>E_OUTOFMEMORY</c> if the arrays could not be allocated.</returns>
+HRESULT LIBBENCHLAB_API benchlab_create_sample_columns(
+    _Out_ benchlab_sample_columns **out_columns,
+    _In_ const size_t capacity);
+
+/// <summary>
+/// Releases a columnar batch created by
+/// <see cref="benchlab_create_sample_columns" />.
+/// </summary>
+/// <param name="columns">The batch to be released. It is safe to pass
+/// <c>nullptr</c>.</param>
+/// <returns><c>S_OK</c>, unconditionally.</returns>
+HRESULT LIBBENCHLAB_API benchlab_destroy_sample_columns(
+    _In_opt_ benchlab_sample_columns *columns);
+
+#if defined(__cplusplus)
+}
+#endif /* defined(__cplusplus) */
+
+
+#if defined(__cplusplus)
+namespace visus {
+namespace benchlab {
+
+    /// <summary>
+    /// A deleter functor for <see cref="benchlab_sample_columns" />, which
+    /// can be used for <see cref="std::unique_ptr" />.
+    /// </summary>
+    struct sample_columns_deleter final {
+        inline void operator ()(benchlab_sample_columns *columns) const {
+            ::benchlab_destroy_sample_columns(columns);
+        }
+    };
+
+    /// <summary>
+    /// A unique pointer for <see cref="benchlab_sample_columns" />.
+    /// </summary>
+    typedef std::unique_ptr<benchlab_sample_columns, sample_columns_deleter>
+        unique_sample_columns;
+
+} /* namespace benchlab */
+} /* namespace visus */
+#endif /* defined(__cplusplus) */
+
+#endif /* !defined(_BENCHLAB_COLUMNS_H) */
@@ -59,6 +59,18 @@ constexpr std::size_t BENCHLAB_POWER_SENSORS = 11;
 /// </summary>
 constexpr std::size_t BENCHLAB_RGB_PROFILES = 2;
 
+/// <summary>
+/// The number of bytes the device sends in response to a request for the
+/// sensor readings.
+/// </summary>
+constexpr std::size_t BENCHLAB_SENSOR_FRAME_SIZE = 216;
+
+/// <summary>
+/// The number of channels in a <see cref="benchlab_sample" />, i.e. the
+/// number of individual values that can be selected for streaming.
+/// </summary>
+constexpr std::size_t BENCHLAB_CHANNELS = 74;
+
 #else /* defined(__cplusplus) */
 #include <inttypes.h>
 #include <stddef.h>
@@ -72,6 +84,8 @@ constexpr std::size_t BENCHLAB_RGB_PROFILES = 2;
 #define BENCHLAB_VIN_SENSORS ((size_t) 13)
 #define BENCHLAB_POWER_SENSORS ((size_t) 11)
 #define BENCHLAB_RGB_PROFILES ((size_t) 2)
+#define BENCHLAB_SENSOR_FRAME_SIZE ((size_t) 216)
+#define BENCHLAB_CHANNELS ((size_t) 74)
 #endif /* defined(__cplusplus) */
 
 //public const int CAL_NUM = 2;
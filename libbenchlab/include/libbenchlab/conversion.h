@@ -0,0 +1,275 @@
+﻿// <copyright file="conversion.h" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#if !defined(_BENCHLAB_CONVERSION_H)
+#define _BENCHLAB_CONVERSION_H
+#pragma once
+
+#include "libbenchlab/channel_descriptors.h"
+#include "libbenchlab/timestamp.h"
+#include "libbenchlab/types.h"
+
+#if defined(__cplusplus)
+#include <chrono>
+#include <cinttypes>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+
+namespace visus {
+namespace benchlab {
+namespace detail {
+
+    /// <summary>
+    /// Maps a <see cref="benchlab_value_type" /> to the C++ type.
+    /// </summary>
+    template<benchlab_value_type Type> struct channel_type { };
+
+    template<> struct channel_type<benchlab_value_type::int16> {
+        typedef std::int16_t type;
+    };
+
+    template<> struct channel_type<benchlab_value_type::uint16> {
+        typedef std::uint16_t type;
+    };
+
+    template<> struct channel_type<benchlab_value_type::int32> {
+        typedef std::int32_t type;
+    };
+
+    template<> struct channel_type<benchlab_value_type::uint8> {
+        typedef std::uint8_t type;
+    };
+
+    template<> struct channel_type<benchlab_value_type::float32> {
+        typedef float type;
+    };
+
+    /// <summary>
+    /// Loads the raw reading of channel <typeparamref name="Channel" /> from
+    /// <paramref name="src" />.
+    /// </summary>
+    template<std::size_t Channel>
+    inline typename channel_type<channel_descriptors[Channel].raw_type>::type
+    load_channel(_In_ const benchlab_sensor_readings& src) noexcept {
+        constexpr auto& d = channel_descriptors[Channel];
+        typename channel_type<d.raw_type>::type retval;
+        std::memcpy(&retval, reinterpret_cast<const std::uint8_t *>(&src)
+            + d.raw_offset, sizeof(retval));
+        return retval;
+    }
+
+    /// <summary>
+    /// Scales the raw reading <paramref name="value" /> of channel
+    /// <typeparamref name="Channel" />, which has no invalid value.
+    /// </summary>
+    /// <remarks>
+    /// The conversion divides rather than multiplying by the reciprocal,
+    /// which is what the vectorised implementations of the library do as
+    /// well.
+    /// </remarks>
+    template<std::size_t Channel, class TValue>
+    constexpr float scale_channel(_In_ const TValue value,
+            std::false_type) noexcept {
+        return static_cast<float>(value) / channel_descriptors[Channel].divisor;
+    }
+
+    /// <summary>
+    /// Scales the raw reading <paramref name="value" /> of channel
+    /// <typeparamref name="Channel" />, which is the lowest float if the
+    /// value marks an unconnected sensor.
+    /// </summary>
+    template<std::size_t Channel, class TValue>
+    constexpr float scale_channel(_In_ const TValue value,
+            std::true_type) noexcept {
+        return (value == channel_descriptors[Channel].invalid_value)
+            ? std::numeric_limits<float>::lowest()
+            : scale_channel<Channel>(value, std::false_type());
+    }
+
+    /// <summary>
+    /// Scales the raw reading <paramref name="value" /> of channel
+    /// <typeparamref name="Channel" /> to its unit.
+    /// </summary>
+    template<std::size_t Channel, class TValue>
+    constexpr float scale_channel(_In_ const TValue value) noexcept {
+        return scale_channel<Channel>(value, std::integral_constant<bool,
+            channel_descriptors[Channel].has_invalid_value>());
+    }
+
+    /// <summary>
+    /// Converts the raw reading of channel <typeparamref name="Channel" />
+    /// from <paramref name="src" /> to a float.
+    /// </summary>
+    template<std::size_t Channel>
+    inline float channel_value(
+            _In_ const benchlab_sensor_readings& src) noexcept {
+        return scale_channel<Channel>(load_channel<Channel>(src));
+    }
+
+    /// <summary>
+    /// Converts the raw reading <paramref name="value" /> of channel
+    /// <typeparamref name="Channel" /> to the type of its member in a sample.
+    /// </summary>
+    template<std::size_t Channel, class TValue>
+    constexpr float to_member(_In_ const TValue value, float) noexcept {
+        return scale_channel<Channel>(value);
+    }
+
+    template<std::size_t Channel, class TValue, class TMember>
+    constexpr TMember to_member(_In_ const TValue value, TMember) noexcept {
+        return static_cast<TMember>(value);
+    }
+
+    /// <summary>
+    /// Converts channel <typeparamref name="Channel" /> of
+    /// <paramref name="src" /> into its member of <paramref name="dst" />.
+    /// </summary>
+    template<std::size_t Channel>
+    inline void convert_channel(_Inout_ benchlab_sample& dst,
+            _In_ const benchlab_sensor_readings& src) noexcept {
+        constexpr auto& d = channel_descriptors[Channel];
+        typedef typename channel_type<d.sample_type>::type value_type;
+        const auto value = to_member<Channel>(load_channel<Channel>(src),
+            value_type());
+        std::memcpy(reinterpret_cast<std::uint8_t *>(&dst) + d.sample_offset,
+            &value, sizeof(value));
+    }
+
+    /// <summary>
+    /// Converts the channels <typeparamref name="First" /> plus each of
+    /// <typeparamref name="Offsets" /> of <paramref name="src" /> into
+    /// <paramref name="dst" />.
+    /// </summary>
+    template<std::size_t First, std::size_t... Offsets>
+    inline void convert_channels_from(_Inout_ benchlab_sample& dst,
+            _In_ const benchlab_sensor_readings& src,
+            std::index_sequence<Offsets...>) noexcept {
+        const int expansion[] = {
+            0, (convert_channel<First + Offsets>(dst, src), 0)...
+        };
+        (void) expansion;
+    }
+
+    /// <summary>
+    /// Converts the channels in the range [<typeparamref name="First" />,
+    /// <typeparamref name="Last" />[ of <paramref name="src" /> into
+    /// <paramref name="dst" />.
+    /// </summary>
+    template<std::size_t First, std::size_t Last>
+    inline void convert_channels(_Inout_ benchlab_sample& dst,
+            _In_ const benchlab_sensor_readings& src) noexcept {
+        static_assert(First <= Last, "The range of channels is valid.");
+        static_assert(Last <= BENCHLAB_CHANNELS, "The range of channels is "
+            "valid.");
+        convert_channels_from<First>(dst, src,
+            std::make_index_sequence<Last - First>());
+    }
+
+} /* namespace detail */
+
+    /// <summary>
+    /// Creates a timestamp for the current system time like
+    /// <see cref="benchlab_make_timestamp" />, but without calling into the
+    /// library.
+    /// </summary>
+    inline benchlab_timestamp make_timestamp(void) noexcept {
+        using namespace std::chrono;
+        typedef duration<benchlab_timestamp, std::ratio<1, 10000000>>
+            filetime_duration;
+
+        // The offset of the FILETIME epoch to the UNIX epoch, which is the
+        // epoch of time_t.
+        const filetime_duration dz(116444736000000000LL);
+        const auto dt = duration_cast<filetime_duration>(system_clock::now()
+            - system_clock::from_time_t(0));
+        return (dt + dz).count();
+    }
+
+    /// <summary>
+    /// Converts the raw sensor readings into a sample like
+    /// <see cref="benchlab_readings_to_sample" />, but inline.
+    /// </summary>
+    /// <remarks>
+    /// The conversion is instantiated for every channel from the
+    /// <see cref="channel_descriptors" />, so the compiler of the caller can
+    /// inline and vectorise it. The results are the same as the ones of the
+    /// library.
+    /// </remarks>
+    /// <param name="dst">Receives the converted sample.</param>
+    /// <param name="src">The readings to be converted.</param>
+    /// <param name="timestamp">The timestamp of the sample.</param>
+    inline void to_sample(_Inout_ benchlab_sample& dst,
+            _In_ const benchlab_sensor_readings& src,
+            _In_ const benchlab_timestamp timestamp) noexcept {
+        detail::convert_channels<0, BENCHLAB_CHANNELS>(dst, src);
+        dst.timestamp = timestamp;
+    }
+
+    /// <summary>
+    /// Converts the raw sensor readings into a new sample.
+    /// </summary>
+    /// <param name="src">The readings to be converted.</param>
+    /// <param name="timestamp">The timestamp of the sample.</param>
+    /// <returns>The converted sample.</returns>
+    inline benchlab_sample to_sample(_In_ const benchlab_sensor_readings& src,
+            _In_ const benchlab_timestamp timestamp) noexcept {
+        benchlab_sample retval { };
+        to_sample(retval, src, timestamp);
+        return retval;
+    }
+
+    /// <summary>
+    /// Converts <paramref name="cnt" /> readings into samples with individual
+    /// timestamps like <see cref="benchlab_readings_to_sample_batch" />, but
+    /// inline.
+    /// </summary>
+    /// <remarks>
+    /// This function is meant for fusing the conversion with further
+    /// processing. For converting large batches at once,
+    /// <see cref="benchlab_readings_to_sample_batch" /> is usually faster,
+    /// because it uses SIMD instructions explicitly.
+    /// </remarks>
+    /// <param name="dst">Receives <paramref name="cnt" /> samples.</param>
+    /// <param name="src">The <paramref name="cnt" /> readings.</param>
+    /// <param name="cnt">The number of readings to convert.</param>
+    /// <param name="timestamps">The <paramref name="cnt" /> timestamps of the
+    /// samples.</param>
+    inline void to_samples(_Out_writes_(cnt) benchlab_sample *dst,
+            _In_reads_(cnt) const benchlab_sensor_readings *src,
+            _In_ const std::size_t cnt,
+            _In_reads_(cnt) const benchlab_timestamp *timestamps) noexcept {
+        for (std::size_t i = 0; i < cnt; ++i) {
+            to_sample(dst[i], src[i], timestamps[i]);
+        }
+    }
+
+    /// <summary>
+    /// Converts <paramref name="cnt" /> readings into samples that all receive
+    /// the same <paramref name="timestamp" />.
+    /// </summary>
+    /// <param name="dst">Receives <paramref name="cnt" /> samples.</param>
+    /// <param name="src">The <paramref name="cnt" /> readings.</param>
+    /// <param name="cnt">The number of readings to convert.</param>
+    /// <param name="timestamp">The timestamp of all samples.</param>
+    inline void to_samples(_Out_writes_(cnt) benchlab_sample *dst,
+            _In_reads_(cnt) const benchlab_sensor_readings *src,
+            _In_ const std::size_t cnt,
+            _In_ const benchlab_timestamp timestamp) noexcept {
+        for (std::size_t i = 0; i < cnt; ++i) {
+            to_sample(dst[i], src[i], timestamp);
+        }
+    }
+
+} /* namespace benchlab */
+} /* namespace visus */
+
+#endif /* defined(__cplusplus) */
+
+#endif /* !defined(_BENCHLAB_CONVERSION_H) */
@@ -0,0 +1,213 @@
+﻿// <copyright file="hotplug.h" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#if !defined(_BENCHLAB_HOTPLUG_H)
+#define _BENCHLAB_HOTPLUG_H
+#pragma once
+
+#if defined(__cplusplus)
+#include <memory>
+#endif /* defined(__cplusplus) */
+
+#include "libbenchlab/api.h"
+#include "libbenchlab/serial.h"
+#include "libbenchlab/types.h"
+
+
+/// <summary>
+/// The opaque type used to represent a monitor that watches for Benchlab
+/// devices being attached to or detached from the local machine.
+/// </summary>
+/// <remarks>
+/// This is a forward declaration of the internal type representing the
+/// monitor. Callers must not make any assumptions about the internal
+/// memory layout of this type.
+/// </remarks>
+struct benchlab_hotplug_monitor;
+
+
+/// <summary>
+/// The handle to a hotplug monitor.
+/// </summary>
+/// <remarks>
+/// <c>nullptr</c> is used to represent an invalid handle.
+/// </remarks>
+typedef struct benchlab_hotplug_monitor *benchlab_hotplug_handle;
+
+
+/// <summary>
+/// Identifies the kind of change a hotplug monitor reports.
+/// </summary>
+typedef enum LIBBENCHLAB_ENUM benchlab_hotplug_event_t {
+
+    /// <summary>
+    /// A Benchlab device has been attached to the machine.
+    /// </summary>
+    LIBBENCHLAB_ENUM_SCOPE(benchlab_hotplug_event, attached) = 0,
+
+    /// <summary>
+    /// A Benchlab device has been detached from the machine.
+    /// </summary>
+    LIBBENCHLAB_ENUM_SCOPE(benchlab_hotplug_event, detached) = 1
+} benchlab_hotplug_event;
+
+
+/// <summary>
+/// The callback to be invoked when a Benchlab device has been attached or
+/// detached.
+/// </summary>
+/// <remarks>
+/// <para>The callback is invoked on the thread of the monitor, which does not
+/// observe any further changes while the callback is running.</para>
+/// <para><paramref name="port" /> is only valid during the call.
+/// <paramref name="handle" /> is the handle of the device if the monitor
+/// was configured to open attached devices and succeeded in doing so, or
+/// <c>nullptr</c> otherwise. The callback takes ownership of the handle and
+/// must close it eventually using <see cref="benchlab_close" />.</para>
+/// </remarks>
+typedef void (*benchlab_hotplug_callback)(
+    _In_ const benchlab_hotplug_event event,
+    _In_z_ const benchlab_char *port,
+    _In_opt_ benchlab_handle handle,
+    _In_opt_ void *context);
+
+
+/// <summary>
+/// Configures a hotplug monitor.
+/// </summary>
+typedef struct LIBBENCHLAB_API benchlab_hotplug_configuration_t {
+
+    /// <summary>
+    /// The version of the structure.
+    /// </summary>
+    /// <remarks>
+    /// <para>This member allows the library to discern between future versions
+    /// of the structure. It must be initialised to 1 in the first version of
+    /// the library.</para>
+    /// <para>This must be the first member of the struct and any future version
+    /// of it.</para>
+    /// </remarks>
+    uint32_t version;
+
+    /// <summary>
+    /// The callback to receive the changes.
+    /// </summary>
+    benchlab_hotplug_callback callback;
+
+    /// <summary>
+    /// A user-defined pointer to be passed to the <see cref="callback" />.
+    /// </summary>
+    void *context;
+
+    /// <summary>
+    /// Instructs the monitor to open attached devices and to pass their
+    /// handles to the <see cref="callback" />.
+    /// </summary>
+    bool open_devices;
+
+    /// <summary>
+    /// Instructs the monitor to report the devices that are already attached
+    /// when it starts as if they had just been attached.
+    /// </summary>
+    bool report_existing;
+
+    /// <summary>
+    /// An optional serial configuration for opening the devices. If this is
+    /// <c>nullptr</c>, the default configuration will be used. The
+    /// configuration is copied when the monitor starts, except for the
+    /// capture path, which is not supported.
+    /// </summary>
+    const benchlab_serial_configuration *serial_configuration;
+} benchlab_hotplug_configuration;
+
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* defined(__cplusplus) */
+
+/// <summary>
+/// Applies the default hotplug configuration to the structure passed to the
+/// method.
+/// </summary>
+/// <remarks>
+/// The default configuration reports existing devices, but does not open any
+/// device. The callback and its context are set to <c>nullptr</c> and must
+/// be provided by the caller.
+/// </remarks>
+/// <param name="config">A pointer to the structure to be filled. The version
+/// of the structure must have been initialised before the call.</param>
+/// <returns><c>S_OK</c> in case of success,
+/// <c>E_POINTER</c> if <paramref name="config" /> is <c>nullptr</c>,
+/// <c>E_INVALIDARG</c> if the version of the configuration has not been
+/// initialised or is unsupported by the function.</returns>
+HRESULT LIBBENCHLAB_API benchlab_initialise_hotplug_configuration(
+    _In_ benchlab_hotplug_configuration *config);
+
+/// <summary>
+/// Starts watching for Benchlab devices being attached or detached.
+/// </summary>
+/// <remarks>
+/// On Linux, the monitor listens for kernel uevents of the tty subsystem. If
+/// the netlink socket for these events is not available, e.g. in a container,
+/// it falls back to watching <c>/dev</c> using inotify. Devices are matched
+/// by their USB vendor and product ID like in <see cref="benchlab_probe" />.
+/// </remarks>
+/// <param name="out_monitor">Receives the handle of the monitor in case of
+/// success, which must be passed to <see cref="benchlab_stop_hotplug_monitor" />
+/// eventually.</param>
+/// <param name="config">The configuration of the monitor.</param>
+/// <returns><c>S_OK</c> in case of success,
+/// <c>E_POINTER</c> if <paramref name="out_monitor" /> is <c>nullptr</c>,
+/// <c>E_INVALIDARG</c> if the configuration is invalid or has no callback,
+/// <c>E_NOTIMPL</c> on Windows, or another error code if the monitor could
+/// not be started.</returns>
+HRESULT LIBBENCHLAB_API benchlab_start_hotplug_monitor(
+    _Out_ benchlab_hotplug_handle *out_monitor,
+    _In_ const benchlab_hotplug_configuration *config);
+
+/// <summary>
+/// Stops the given hotplug monitor and releases all of its resources.
+/// </summary>
+/// <remarks>
+/// The callback will not be invoked anymore once the function returns. The
+/// function must not be called from within the callback.
+/// </remarks>
+/// <param name="monitor">The monitor to be stopped. It is safe to pass
+/// <c>nullptr</c>.</param>
+/// <returns><c>S_OK</c>, unconditionally.</returns>
+HRESULT LIBBENCHLAB_API benchlab_stop_hotplug_monitor(
+    _In_opt_ benchlab_hotplug_handle monitor);
+
+#if defined(__cplusplus)
+}
+#endif /* defined(__cplusplus) */
+
+
+#if defined(__cplusplus)
+namespace visus {
+namespace benchlab {
+
+    /// <summary>
+    /// A deleter functor for <see cref="benchlab_hotplug_handle" />, which
+    /// can be used for <see cref="std::unique_ptr" />.
+    /// </summary>
+    struct hotplug_monitor_deleter final {
+        inline void operator ()(benchlab_hotplug_handle monitor) const {
+            ::benchlab_stop_hotplug_monitor(monitor);
+        }
+    };
+
+    /// <summary>
+    /// A unique pointer to replace <see cref="benchlab_hotplug_handle" />.
+    /// </summary>
+    typedef std::unique_ptr<benchlab_hotplug_monitor, hotplug_monitor_deleter>
+        unique_hotplug_monitor;
+
+} /* namespace benchlab */
+} /* namespace visus */
+#endif /* defined(__cplusplus) */
+
+#endif /* !defined(_BENCHLAB_HOTPLUG_H) */
@@ -105,7 +105,7 @@ typedef enum HRESULT_t {
     //-ECOMM	70	/* Communication error on send		*/
     //-EPROTO	71	/* Protocol error			*/
     //-EMULTIHOP 74	/* multihop attempted			*/
-    //-EBADMSG 77	/* trying to read unreadable message	*/
+    ERROR_INVALID_DATA = -EBADMSG,
     //-ENAMETOOLONG 78	/* path name is too long		*/
     //-EOVERFLOW 79	/* value too large to be stored in data type */
     //-ENOTUNIQ 80	/* given log. name not unique		*/
@@ -145,7 +145,7 @@ typedef enum HRESULT_t {
     //-ENOTCONN	134	/* Socket is not connected */
     //-ESHUTDOWN	143	/* Can't send after socket shutdown */
     //-ETOOMANYREFS	144	/* Too many references: can't splice */
-    //-ETIMEDOUT	145	/* Connection timed out */
+    ERROR_TIMEOUT = -ETIMEDOUT,
     //-ECONNREFUSED	146	/* Connection refused */
     //-EHOSTDOWN	147	/* Host is down */
     //-EHOSTUNREACH	148	/* No route to host */
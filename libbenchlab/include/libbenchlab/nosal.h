@@ -101,6 +101,14 @@
 #define _Out_writes_opt_z_(cnt)
 #endif /* !defined(_Out_writes_opt_z_) */
 
+#if !defined(_Out_writes_to_)
+#define _Out_writes_to_(size, cnt)
+#endif /* !defined(_Out_writes_to_) */
+
+#if !defined(_Out_writes_to_opt_)
+#define _Out_writes_to_opt_(size, cnt)
+#endif /* !defined(_Out_writes_to_opt_) */
+
 #if !defined(_Ret_)
 #define _Ret_
 #endif /* !defined(_Ret_) */
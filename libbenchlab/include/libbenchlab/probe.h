@@ -0,0 +1,127 @@
+﻿// <copyright file="probe.h" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#if !defined(_BENCHLAB_PROBE_H)
+#define _BENCHLAB_PROBE_H
+#pragma once
+
+#include "libbenchlab/api.h"
+#include "libbenchlab/serial.h"
+#include "libbenchlab/types.h"
+
+
+/// <summary>
+/// Describes the outcome of probing a single port.
+/// </summary>
+typedef struct LIBBENCHLAB_API benchlab_probe_result_t {
+
+    /// <summary>
+    /// The path of the port that has been probed.
+    /// </summary>
+    const benchlab_char *port;
+
+    /// <summary>
+    /// The result of opening the device on the port, which is <c>S_OK</c> if
+    /// a working device has been found.
+    /// </summary>
+    HRESULT result;
+
+    /// <summary>
+    /// The time in microseconds it took to open the port and to complete or
+    /// abort the handshake with the device.
+    /// </summary>
+    uint64_t elapsed;
+} benchlab_probe_result;
+
+
+/// <summary>
+/// The callback to be invoked for each port that has been probed.
+/// </summary>
+/// <remarks>
+/// The result and the strings it references are only valid during the call.
+/// </remarks>
+typedef void (*benchlab_probe_callback)(
+    _In_ const benchlab_probe_result *result,
+    _In_opt_ void *context);
+
+
+/// <summary>
+/// Configures how Benchlab devices are probed.
+/// </summary>
+typedef struct LIBBENCHLAB_API benchlab_probe_configuration_t {
+
+    /// <summary>
+    /// The version of the structure.
+    /// </summary>
+    /// <remarks>
+    /// <para>This member allows the library to discern between future versions
+    /// of the structure. It must be initialised to 1 in the first version of
+    /// the library.</para>
+    /// <para>This must be the first member of the struct and any future version
+    /// of it.</para>
+    /// </remarks>
+    uint32_t version;
+
+    /// <summary>
+    /// The time in milliseconds that the handshake on each port should take
+    /// at most. As all ports are probed concurrently, this is also roughly
+    /// the time the whole probe takes.
+    /// </summary>
+    /// <remarks>
+    /// <para>The timeout is split evenly among the round trips of the
+    /// handshake, i.e. it replaces the command sleep and the read and write
+    /// timeouts of the serial configuration if these are longer.</para>
+    /// <para>The timeout is approximate rather than a hard deadline: it bounds
+    /// the waits of the handshake, but not the time it takes to open and
+    /// configure the ports, so a port that blocks in the operating system can
+    /// delay the probe beyond the timeout.</para>
+    /// </remarks>
+    uint32_t timeout;
+
+    /// <summary>
+    /// An optional callback that receives the result for each port.
+    /// </summary>
+    benchlab_probe_callback callback;
+
+    /// <summary>
+    /// A user-defined pointer to be passed to the <see cref="callback" />.
+    /// </summary>
+    void *context;
+
+    /// <summary>
+    /// An optional serial configuration for opening the devices. If this is
+    /// <c>nullptr</c>, the default configuration will be used.
+    /// </summary>
+    const benchlab_serial_configuration *serial_configuration;
+} benchlab_probe_configuration;
+
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* defined(__cplusplus) */
+
+/// <summary>
+/// Applies the default probe configuration to the structure passed to the
+/// method.
+/// </summary>
+/// <remarks>
+/// The default configuration allows for 1000 ms per handshake, does not
+/// report any results and uses the default serial configuration.
+/// </remarks>
+/// <param name="config">A pointer to the structure to be filled. The version
+/// of the structure must have been initialised before the call.</param>
+/// <returns><c>S_OK</c> in case of success,
+/// <c>E_POINTER</c> if <paramref name="config" /> is <c>nullptr</c>,
+/// <c>E_INVALIDARG</c> if the version of the configuration has not been
+/// initialised or is unsupported by the function.</returns>
+HRESULT LIBBENCHLAB_API benchlab_initialise_probe_configuration(
+    _In_ benchlab_probe_configuration *config);
+
+#if defined(__cplusplus)
+}
+#endif /* defined(__cplusplus) */
+
+#endif /* !defined(_BENCHLAB_PROBE_H) */
@@ -0,0 +1,152 @@
+﻿// <copyright file="reactor.h" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#if !defined(_BENCHLAB_REACTOR_H)
+#define _BENCHLAB_REACTOR_H
+#pragma once
+
+#if defined(__cplusplus)
+#include <memory>
+#endif /* defined(__cplusplus) */
+
+#include "libbenchlab/api.h"
+#include "libbenchlab/types.h"
+
+
+/// <summary>
+/// The opaque type used to represent a reactor, which drives the acquisition
+/// of multiple streaming devices from a fixed number of threads.
+/// </summary>
+/// <remarks>
+/// This is a forward declaration of the internal type representing the
+/// reactor. Callers must not make any assumptions about the internal
+/// memory layout of this type.
+/// </remarks>
+struct benchlab_reactor;
+
+
+/// <summary>
+/// The handle to a reactor.
+/// </summary>
+/// <remarks>
+/// <c>nullptr</c> is used to represent an invalid handle.
+/// </remarks>
+typedef struct benchlab_reactor *benchlab_reactor_handle;
+
+
+/// <summary>
+/// Configures a reactor.
+/// </summary>
+typedef struct LIBBENCHLAB_API benchlab_reactor_configuration_t {
+
+    /// <summary>
+    /// The version of the structure.
+    /// </summary>
+    /// <remarks>
+    /// <para>This member allows the library to discern between future versions
+    /// of the structure. It must be initialised to 1 in the first version of
+    /// the library.</para>
+    /// <para>This must be the first member of the struct and any future version
+    /// of it.</para>
+    /// </remarks>
+    uint32_t version;
+
+    /// <summary>
+    /// The number of threads the reactor uses. Devices are distributed evenly
+    /// among the threads when they start streaming.
+    /// </summary>
+    uint32_t threads;
+} benchlab_reactor_configuration;
+
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* defined(__cplusplus) */
+
+/// <summary>
+/// Applies the default reactor configuration to the structure passed to the
+/// method.
+/// </summary>
+/// <remarks>
+/// The default configuration uses a single thread.
+/// </remarks>
+/// <param name="config">A pointer to the structure to be filled. The version
+/// of the structure must have been initialised before the call.</param>
+/// <returns><c>S_OK</c> in case of success,
+/// <c>E_POINTER</c> if <paramref name="config" /> is <c>nullptr</c>,
+/// <c>E_INVALIDARG</c> if the version of the configuration has not been
+/// initialised or is unsupported by the function.</returns>
+HRESULT LIBBENCHLAB_API benchlab_initialise_reactor_configuration(
+    _In_ benchlab_reactor_configuration *config);
+
+/// <summary>
+/// Creates a reactor and starts its threads.
+/// </summary>
+/// <remarks>
+/// <para>A reactor is used by setting
+/// <see cref="benchlab_streaming_configuration::reactor" /> before starting
+/// to stream. Instead of a dedicated thread per device, the threads of the
+/// reactor wait for the responses of all of its devices at once and use a
+/// timer wheel to schedule the requests according to the period of each
+/// device.</para>
+/// <para>Reactors are only supported on Linux and only for transports that
+/// provide a file descriptor, i.e. serial ports and pseudo-terminals.</para>
+/// </remarks>
+/// <param name="out_reactor">Receives the reactor in case of success.
+/// </param>
+/// <param name="config">The configuration of the reactor. It is safe to pass
+/// <c>nullptr</c>, in which case the default configuration is used.</param>
+/// <returns><c>S_OK</c> in case of success,
+/// <c>E_POINTER</c> if <paramref name="out_reactor" /> is <c>nullptr</c>,
+/// <c>E_INVALIDARG</c> if the configuration is invalid,
+/// <c>E_NOTIMPL</c> on Windows, or another error code if the reactor could
+/// not be created.</returns>
+HRESULT LIBBENCHLAB_API benchlab_create_reactor(
+    _Out_ benchlab_reactor_handle *out_reactor,
+    _In_opt_ const benchlab_reactor_configuration *config);
+
+/// <summary>
+/// Stops the threads of the reactor and releases all of its resources.
+/// </summary>
+/// <remarks>
+/// Any device still streaming via the reactor stops streaming. The function
+/// must not be called from within a sample callback.
+/// </remarks>
+/// <param name="reactor">The reactor to be destroyed. It is safe to pass
+/// <c>nullptr</c>.</param>
+/// <returns><c>S_OK</c>, unconditionally.</returns>
+HRESULT LIBBENCHLAB_API benchlab_destroy_reactor(
+    _In_opt_ benchlab_reactor_handle reactor);
+
+#if defined(__cplusplus)
+}
+#endif /* defined(__cplusplus) */
+
+
+#if defined(__cplusplus)
+namespace visus {
+namespace benchlab {
+
+    /// <summary>
+    /// A deleter functor for <see cref="benchlab_reactor_handle" />, which
+    /// can be used for <see cref="std::unique_ptr" />.
+    /// </summary>
+    struct reactor_deleter final {
+        inline void operator ()(benchlab_reactor_handle reactor) const {
+            ::benchlab_destroy_reactor(reactor);
+        }
+    };
+
+    /// <summary>
+    /// A unique pointer to replace <see cref="benchlab_reactor_handle" />.
+    /// </summary>
+    typedef std::unique_ptr<benchlab_reactor, reactor_deleter> unique_reactor;
+
+} /* namespace benchlab */
+} /* namespace visus */
+#endif /* defined(__cplusplus) */
+
+#endif /* !defined(_BENCHLAB_REACTOR_H) */
@@ -71,7 +71,8 @@ typedef struct LIBBENCHLAB_API benchlab_serial_configuration_t {
     /// <remarks>
     /// <para>This member allows the library to discern between future versions
     /// of the structure. It must be initialised to 1 in the first version of
-    /// the library.</para>
+    /// the library. Version 2 adds the members controlling the calibration of
+    /// <see cref="command_sleep" />.</para>
     /// <para>This must be the first member of the struct and any future version
     /// of it.</para>
     /// </remarks>
@@ -128,6 +129,40 @@ typedef struct LIBBENCHLAB_API benchlab_serial_configuration_t {
     /// The write timeout in milliseconds.
     /// </summary>
     uint32_t write_timeout;
+
+    /// <summary>
+    /// Instructs the library to measure the response latency of the device
+    /// when opening it and to replace <see cref="command_sleep" /> with the
+    /// smallest delay that is safe for the device.
+    /// </summary>
+    /// <remarks>
+    /// If the platform blocks reads until data arrive, the command sleep is
+    /// not required at all and will be set to zero. This member is only
+    /// available from version 2 on.
+    /// </remarks>
+    bool calibrate_command_sleep;
+
+    /// <summary>
+    /// The number of round trips used to measure the response latency if
+    /// <see cref="calibrate_command_sleep" /> is set.
+    /// </summary>
+    /// <remarks>
+    /// This member is only available from version 2 on.
+    /// </remarks>
+    uint32_t calibration_rounds;
+
+    /// <summary>
+    /// The path of a file that receives a capture of all bytes exchanged with
+    /// the device, or <c>nullptr</c> for not capturing anything.
+    /// </summary>
+    /// <remarks>
+    /// The capture records each chunk of data with the time it was sent or
+    /// received and can be replayed using
+    /// <see cref="benchlab_create_replay_transport" />. An existing file will
+    /// be overwritten. The string must only be valid while the device is
+    /// being opened. This member is only available from version 3 on.
+    /// </remarks>
+    const benchlab_char *capture_path;
 } benchlab_serial_configuration;
 
 
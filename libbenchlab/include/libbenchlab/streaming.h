@@ -0,0 +1,325 @@
+﻿// <copyright file="streaming.h" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#if !defined(_BENCHLAB_STREAMING_H)
+#define _BENCHLAB_STREAMING_H
+#pragma once
+
+#include "libbenchlab/api.h"
+#include "libbenchlab/channel.h"
+#include "libbenchlab/clock.h"
+#include "libbenchlab/reactor.h"
+#include "libbenchlab/types.h"
+
+
+/// <summary>
+/// Specifies how the streaming thread requests samples from the device.
+/// </summary>
+typedef enum LIBBENCHLAB_ENUM benchlab_acquisition_mode_t {
+
+    /// <summary>
+    /// The next sample is requested only after the previous one has been
+    /// received, converted and delivered to the callback.
+    /// </summary>
+    LIBBENCHLAB_ENUM_SCOPE(benchlab_acquisition_mode, stop_and_wait) = 0,
+
+    /// <summary>
+    /// The next sample is requested as soon as the previous one has been
+    /// received if it is already due, such that the transfer overlaps with
+    /// the conversion and the callback.
+    /// </summary>
+    LIBBENCHLAB_ENUM_SCOPE(benchlab_acquisition_mode, pipelined) = 1
+} benchlab_acquisition_mode;
+
+
+/// <summary>
+/// Specifies how streaming continues if a sample could not be requested
+/// within a period after it was due.
+/// </summary>
+typedef enum LIBBENCHLAB_ENUM benchlab_overrun_policy_t {
+
+    /// <summary>
+    /// The missed samples are skipped and the next sample is requested at
+    /// the next deadline, such that all samples stay in phase.
+    /// </summary>
+    LIBBENCHLAB_ENUM_SCOPE(benchlab_overrun_policy, skip) = 0,
+
+    /// <summary>
+    /// The missed samples are requested back to back until streaming has
+    /// caught up with the deadlines.
+    /// </summary>
+    LIBBENCHLAB_ENUM_SCOPE(benchlab_overrun_policy, catch_up) = 1,
+
+    /// <summary>
+    /// The deadlines are shifted such that the next sample is due one period
+    /// after the late one.
+    /// </summary>
+    LIBBENCHLAB_ENUM_SCOPE(benchlab_overrun_policy, rephase) = 2
+} benchlab_overrun_policy;
+
+
+/// <summary>
+/// Configures how samples are streamed from a Benchlab device.
+/// </summary>
+typedef struct LIBBENCHLAB_API benchlab_streaming_configuration_t {
+
+    /// <summary>
+    /// The version of the structure.
+    /// </summary>
+    /// <remarks>
+    /// <para>This member allows the library to discern between future versions
+    /// of the structure. It must be initialised to 1 in the first version of
+    /// the library.</para>
+    /// <para>This must be the first member of the struct and any future version
+    /// of it.</para>
+    /// </remarks>
+    uint32_t version;
+
+    /// <summary>
+    /// Determines how the streaming thread requests new samples.
+    /// </summary>
+    benchlab_acquisition_mode acquisition_mode;
+
+    /// <summary>
+    /// The callback to receive the samples.
+    /// </summary>
+    /// <remarks>
+    /// The callback is optional if <see cref="batch_callback" />,
+    /// <see cref="readings_callback" /> or <see cref="compact_callback" /> is
+    /// set or if <see cref="buffer_size" /> is non-zero.
+    /// </remarks>
+    benchlab_sample_callback callback;
+
+    /// <summary>
+    /// A user-defined pointer to be passed to all callbacks.
+    /// </summary>
+    void *context;
+
+    /// <summary>
+    /// The period between two samples in milliseconds, which must be
+    /// positive. If the period is shorter than the time it takes to obtain a
+    /// sample, the device will stream as fast as possible.
+    /// </summary>
+    /// <remarks>
+    /// The samples are due at absolute deadlines that are one period apart,
+    /// so the time spent on the callbacks does not cause the sample rate to
+    /// drift as long as it is shorter than the period. See
+    /// <see cref="overrun_policy" /> for what happens otherwise.
+    /// </remarks>
+    uint32_t period;
+
+    /// <summary>
+    /// The number of consecutive samples that may be lost due to timeouts or
+    /// corrupted responses before streaming stops. Zero allows the streaming
+    /// thread to retry indefinitely.
+    /// </summary>
+    /// <remarks>
+    /// After a failed sample, the streaming thread discards any input until
+    /// the line is quiet and retries. Errors indicating that the device is
+    /// gone, e.g. because it was unplugged, always stop streaming.
+    /// </remarks>
+    uint32_t max_failures;
+
+    /// <summary>
+    /// The reactor that drives the acquisition, or <c>nullptr</c> for
+    /// streaming on a dedicated thread for the device.
+    /// </summary>
+    /// <remarks>
+    /// The reactor must not be destroyed while the device is streaming via
+    /// it. The callback is invoked on the thread of the reactor, which serves
+    /// other devices as well, so it should return quickly.
+    /// </remarks>
+    benchlab_reactor_handle reactor;
+
+    /// <summary>
+    /// The number of samples that the device buffers for retrieval via
+    /// <see cref="benchlab_poll_samples" /> and
+    /// <see cref="benchlab_wait_samples" />, which is rounded up to the next
+    /// power of two. Zero disables the buffer.
+    /// </summary>
+    /// <remarks>
+    /// The buffer is allocated when streaming starts. Adding samples to it
+    /// neither locks nor allocates memory. If the buffer is full, new samples
+    /// are not added, but still passed to the <see cref="callback" /> if
+    /// there is one.
+    /// </remarks>
+    uint32_t buffer_size;
+
+    /// <summary>
+    /// An optional callback receiving the samples in batches of up to
+    /// <see cref="batch_size" /> samples.
+    /// </summary>
+    /// <remarks>
+    /// The batch callback can be used alongside the per-sample
+    /// <see cref="callback" />. It is invoked on the same thread, and any
+    /// incomplete batch is delivered before streaming stops.
+    /// </remarks>
+    benchlab_batch_callback batch_callback;
+
+    /// <summary>
+    /// The maximum number of samples passed to the
+    /// <see cref="batch_callback" /> at once, which must be positive if the
+    /// batch callback is set.
+    /// </summary>
+    uint32_t batch_size;
+
+    /// <summary>
+    /// The maximum time in milliseconds that the first sample of a batch may
+    /// be held back before the batch is delivered even though it is
+    /// incomplete. Zero delivers batches only once they are complete.
+    /// </summary>
+    /// <remarks>
+    /// The latency is honoured while the device waits for the next sample to
+    /// become due. It cannot be honoured while waiting for a response, so a
+    /// device that stops responding can delay the batch up to its read
+    /// timeout.
+    /// </remarks>
+    uint32_t batch_latency;
+
+    /// <summary>
+    /// An optional callback receiving the raw sensor readings along with the
+    /// time when they were acquired.
+    /// </summary>
+    /// <remarks>
+    /// If this is the only callback and there is no buffer, the readings are
+    /// not converted into samples at all, which is the cheapest way of
+    /// recording the data of a device.
+    /// </remarks>
+    benchlab_readings_callback readings_callback;
+
+    /// <summary>
+    /// The channels that are converted and delivered, which must not be
+    /// empty.
+    /// </summary>
+    /// <remarks>
+    /// Only the selected channels are converted for the
+    /// <see cref="callback" />, the <see cref="batch_callback" /> and the
+    /// buffer, and all other channels of these samples are zero. The
+    /// <see cref="compact_callback" /> receives only the selected channels.
+    /// The <see cref="readings_callback" /> always receives all readings.
+    /// </remarks>
+    benchlab_channel_mask channels;
+
+    /// <summary>
+    /// An optional callback receiving compact samples that comprise only the
+    /// selected <see cref="channels" />.
+    /// </summary>
+    benchlab_compact_callback compact_callback;
+
+    /// <summary>
+    /// The clock used for timestamping the samples.
+    /// </summary>
+    /// <remarks>
+    /// The timestamps of all callbacks and of the buffer are readings of this
+    /// clock, which are not <c>FILETIME</c>s for all clocks. The clock must be
+    /// supported on the machine, otherwise streaming cannot be started.
+    /// </remarks>
+    benchlab_clock clock;
+
+    /// <summary>
+    /// Determines whether a sample is timestamped when it has been requested,
+    /// when it has been received or in between.
+    /// </summary>
+    benchlab_timestamp_point timestamp_point;
+
+    /// <summary>
+    /// Determines how streaming continues if a sample is requested a whole
+    /// <see cref="period" /> or more after it was due.
+    /// </summary>
+    benchlab_overrun_policy overrun_policy;
+} benchlab_streaming_configuration;
+
+
+/// <summary>
+/// Provides statistics about the samples that have been streamed from a
+/// device.
+/// </summary>
+typedef struct LIBBENCHLAB_API benchlab_streaming_statistics_t {
+
+    /// <summary>
+    /// The number of samples that have been delivered since streaming was
+    /// started.
+    /// </summary>
+    uint64_t samples;
+
+    /// <summary>
+    /// The time in microseconds between the first and the last sample that
+    /// has been delivered.
+    /// </summary>
+    uint64_t elapsed;
+
+    /// <summary>
+    /// The sample rate in Hertz that the device sustained between the first
+    /// and the last sample.
+    /// </summary>
+    float sample_rate;
+
+    /// <summary>
+    /// The number of samples that have been lost because the response timed
+    /// out or was corrupted.
+    /// </summary>
+    uint64_t failures;
+
+    /// <summary>
+    /// The number of bytes that have been discarded while resynchronising
+    /// with the device after a failure.
+    /// </summary>
+    uint64_t discarded;
+
+    /// <summary>
+    /// The total time in microseconds between the first failure of a series
+    /// and the next sample that has been delivered successfully.
+    /// </summary>
+    uint64_t recovery_time;
+
+    /// <summary>
+    /// The number of samples that could not be buffered for
+    /// <see cref="benchlab_poll_samples" /> because the buffer was full.
+    /// </summary>
+    uint64_t overflows;
+
+    /// <summary>
+    /// The number of times that a sample was requested a whole period or more
+    /// after it was due. If the
+    /// <see cref="benchlab_overrun_policy::skip" /> policy is used, this is
+    /// the number of samples that have been skipped.
+    /// </summary>
+    uint64_t overruns;
+} benchlab_streaming_statistics;
+
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* defined(__cplusplus) */
+
+/// <summary>
+/// Applies the default streaming configuration to the structure passed to
+/// the method.
+/// </summary>
+/// <remarks>
+/// The default configuration uses the
+/// <see cref="benchlab_acquisition_mode::stop_and_wait" /> mode and a period
+/// of 10 ms, and it tolerates up to 10 consecutive failures. Samples are
+/// acquired on a dedicated thread rather than a reactor and are not buffered.
+/// Batches hold up to 32 samples for at most 100 ms, and all channels are
+/// selected. Samples are timestamped with the system time on completion, and
+/// samples that are overdue are skipped. The callbacks and their context are
+/// set to <c>nullptr</c> and must be provided by the caller.
+/// </remarks>
+/// <param name="config">A pointer to the structure to be filled. The version
+/// of the structure must have been initialised before the call.</param>
+/// <returns><c>S_OK</c> in case of success,
+/// <c>E_POINTER</c> if <paramref name="config" /> is <c>nullptr</c>,
+/// <c>E_INVALIDARG</c> if the version of the configuration has not been
+/// initialised or is unsupported by the function.</returns>
+HRESULT LIBBENCHLAB_API benchlab_initialise_streaming_configuration(
+    _In_ benchlab_streaming_configuration *config);
+
+#if defined(__cplusplus)
+}
+#endif /* defined(__cplusplus) */
+
+#endif /* !defined(_BENCHLAB_STREAMING_H) */
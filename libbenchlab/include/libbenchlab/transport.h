@@ -0,0 +1,225 @@
+﻿// <copyright file="transport.h" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#if !defined(_BENCHLAB_TRANSPORT_H)
+#define _BENCHLAB_TRANSPORT_H
+#pragma once
+
+#if defined(__cplusplus)
+#include <memory>
+#endif /* defined(__cplusplus) */
+
+#include "libbenchlab/api.h"
+#include "libbenchlab/serial.h"
+#include "libbenchlab/types.h"
+
+
+/// <summary>
+/// The opaque type used to represent the byte stream between the library and
+/// a device.
+/// </summary>
+/// <remarks>
+/// This is a forward declaration of the internal type representing the
+/// transport. Callers must not make any assumptions about the internal
+/// memory layout of this type.
+/// </remarks>
+struct benchlab_transport;
+
+
+/// <summary>
+/// The handle to a transport.
+/// </summary>
+/// <remarks>
+/// <c>nullptr</c> is used to represent an invalid handle.
+/// </remarks>
+typedef struct benchlab_transport *benchlab_transport_handle;
+
+
+/// <summary>
+/// Determines how fast a replay transport delivers a capture.
+/// </summary>
+typedef enum LIBBENCHLAB_ENUM benchlab_replay_mode_t {
+
+    /// <summary>
+    /// All responses in the recording are available at once.
+    /// </summary>
+    LIBBENCHLAB_ENUM_SCOPE(benchlab_replay_mode, as_fast_as_possible) = 0,
+
+    /// <summary>
+    /// The responses following a command in a capture become available with
+    /// the delay they were recorded with after the command has been written
+    /// to the transport. Recordings without timing information are replayed
+    /// as fast as possible.
+    /// </summary>
+    LIBBENCHLAB_ENUM_SCOPE(benchlab_replay_mode, recorded_speed) = 1
+} benchlab_replay_mode;
+
+
+/// <summary>
+/// The callback to be invoked when the library writes a command to a loopback
+/// transport.
+/// </summary>
+/// <remarks>
+/// The callback is invoked synchronously on the thread writing the command.
+/// It can answer the command by passing the response to
+/// <see cref="benchlab_loopback_respond" />.
+/// </remarks>
+typedef void (*benchlab_loopback_handler)(
+    _In_ benchlab_transport_handle transport,
+    _In_reads_bytes_(cnt) const void *data,
+    _In_ const size_t cnt,
+    _In_opt_ void *context);
+
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* defined(__cplusplus) */
+
+/// <summary>
+/// Creates an in-memory transport that passes anything written to it to the
+/// given <paramref name="handler" />.
+/// </summary>
+/// <param name="out_transport">Receives the transport in case of success.
+/// </param>
+/// <param name="handler">The callback emulating the device. If this is
+/// <c>nullptr</c>, everything written is echoed back to the reader.</param>
+/// <param name="context">A user-defined pointer passed to the
+/// <paramref name="handler" />.</param>
+/// <returns><c>S_OK</c> in case of success,
+/// <c>E_POINTER</c> if <paramref name="out_transport" /> is <c>nullptr</c>,
+/// <c>E_OUTOFMEMORY</c> if the transport could not be allocated.</returns>
+HRESULT LIBBENCHLAB_API benchlab_create_loopback_transport(
+    _Out_ benchlab_transport_handle *out_transport,
+    _In_opt_ benchlab_loopback_handler handler,
+    _In_opt_ void *context);
+
+/// <summary>
+/// Opens the pseudo-terminal at the given <paramref name="path" />, which is
+/// typically connected to an emulated device.
+/// </summary>
+/// <remarks>
+/// <see cref="benchlab_open" /> selects this transport automatically for
+/// paths in &quot;/dev/pts&quot;.
+/// </remarks>
+/// <param name="out_transport">Receives the transport in case of success.
+/// </param>
+/// <param name="path">The path of the subordinate side of the
+/// pseudo-terminal.</param>
+/// <returns><c>S_OK</c> in case of success,
+/// <c>E_POINTER</c> if <paramref name="out_transport" /> is <c>nullptr</c>,
+/// <c>E_INVALIDARG</c> if <paramref name="path" /> is <c>nullptr</c>,
+/// <c>E_NOTIMPL</c> on Windows, or a platform-specific error code if the
+/// terminal could not be opened.</returns>
+HRESULT LIBBENCHLAB_API benchlab_create_pty_transport(
+    _Out_ benchlab_transport_handle *out_transport,
+    _In_z_ const benchlab_char *path);
+
+/// <summary>
+/// Creates a transport that replays the raw bytes received from a device,
+/// which have been recorded in the file at <paramref name="path" />.
+/// </summary>
+/// <remarks>
+/// <para>The recording can either be a capture created via
+/// <see cref="benchlab_serial_configuration::capture_path" /> or a plain dump
+/// of the bytes received from the device.</para>
+/// <para>Anything written to the transport is discarded. The recording must
+/// therefore contain the complete responses to all commands the library
+/// will issue, starting with the welcome message and the vendor data that
+/// are requested when opening the device.</para>
+/// </remarks>
+/// <param name="out_transport">Receives the transport in case of success.
+/// </param>
+/// <param name="path">The path of the recording.</param>
+/// <param name="mode">Determines whether the responses are delivered with
+/// their recorded timing.</param>
+/// <returns><c>S_OK</c> in case of success,
+/// <c>E_POINTER</c> if <paramref name="out_transport" /> is <c>nullptr</c>,
+/// <c>E_INVALIDARG</c> if <paramref name="path" /> is <c>nullptr</c>,
+/// or an error code if the file could not be read.</returns>
+HRESULT LIBBENCHLAB_API benchlab_create_replay_transport(
+    _Out_ benchlab_transport_handle *out_transport,
+    _In_z_ const benchlab_char *path,
+    _In_ const benchlab_replay_mode mode);
+
+/// <summary>
+/// Opens the serial port at <paramref name="path" /> without connecting to a
+/// device yet.
+/// </summary>
+/// <param name="out_transport">Receives the transport in case of success.
+/// </param>
+/// <param name="path">The path to the COM port.</param>
+/// <param name="config">The configuration used for the serial port. It is
+/// safe to pass <c>nullptr</c>, in which case the default configuration is
+/// used.</param>
+/// <returns><c>S_OK</c> in case of success,
+/// <c>E_POINTER</c> if <paramref name="out_transport" /> is <c>nullptr</c>,
+/// <c>E_INVALIDARG</c> if <paramref name="path" /> is <c>nullptr</c>,
+/// or a platform-specific error code if the port could not be opened.
+/// </returns>
+HRESULT LIBBENCHLAB_API benchlab_create_serial_transport(
+    _Out_ benchlab_transport_handle *out_transport,
+    _In_z_ const benchlab_char *path,
+    _In_opt_ const benchlab_serial_configuration *config);
+
+/// <summary>
+/// Destroys a transport that has not been passed to
+/// <see cref="benchlab_open_transport" />.
+/// </summary>
+/// <param name="transport">The transport to destroy.</param>
+/// <returns><c>S_OK</c> in case of success,
+/// <c>E_HANDLE</c> if <paramref name="transport" /> is invalid.</returns>
+HRESULT LIBBENCHLAB_API benchlab_destroy_transport(
+    _In_ benchlab_transport_handle transport);
+
+/// <summary>
+/// Makes the given <paramref name="data" /> available to the reader of a
+/// loopback transport.
+/// </summary>
+/// <param name="transport">A transport created by
+/// <see cref="benchlab_create_loopback_transport" />.</param>
+/// <param name="data">A pointer to at least <paramref name="cnt" /> bytes of
+/// the response.</param>
+/// <param name="cnt">The number of bytes to append to the input.</param>
+/// <returns><c>S_OK</c> in case of success,
+/// <c>E_HANDLE</c> if <paramref name="transport" /> is invalid,
+/// <c>E_INVALIDARG</c> if <paramref name="transport" /> is not a loopback
+/// transport or <paramref name="data" /> is <c>nullptr</c>, or an error
+/// code if the transport has been closed.</returns>
+HRESULT LIBBENCHLAB_API benchlab_loopback_respond(
+    _In_ benchlab_transport_handle transport,
+    _In_reads_bytes_(cnt) const void *data,
+    _In_ const size_t cnt);
+
+#if defined(__cplusplus)
+}
+#endif /* defined(__cplusplus) */
+
+
+#if defined(__cplusplus)
+namespace visus {
+namespace benchlab {
+
+    /// <summary>
+    /// A deleter functor for <see cref="benchlab_transport_handle" />, which
+    /// can be used for <see cref="std::unique_ptr" />.
+    /// </summary>
+    struct transport_deleter final {
+        inline void operator ()(benchlab_transport_handle transport) const {
+            ::benchlab_destroy_transport(transport);
+        }
+    };
+
+    /// <summary>
+    /// A unique pointer to replace <see cref="benchlab_transport_handle" />.
+    /// </summary>
+    typedef std::unique_ptr<benchlab_transport, transport_deleter>
+        unique_transport;
+
+} /* namespace benchlab */
+} /* namespace visus */
+#endif /* defined(__cplusplus) */
+
+#endif /* !defined(_BENCHLAB_TRANSPORT_H) */
@@ -359,3 +359,29 @@ typedef void (*benchlab_sample_callback)(
     _In_ benchlab_handle source,
     _In_ const benchlab_sample *sample,
     _In_opt_ void *context);
+
+/// <summary>
+/// The callback to be invoked when new raw sensor readings arrive.
+/// </summary>
+/// <remarks>
+/// The readings can be converted into a <see cref="benchlab_sample" /> at
+/// any later point using <see cref="benchlab_readings_to_sample" /> and the
+/// <paramref name="timestamp" />.
+/// </remarks>
+typedef void (*benchlab_readings_callback)(
+    _In_ benchlab_handle source,
+    _In_ const benchlab_sensor_readings *readings,
+    _In_ benchlab_timestamp timestamp,
+    _In_opt_ void *context);
+
+/// <summary>
+/// The callback to be invoked when a batch of samples is ready.
+/// </summary>
+/// <remarks>
+/// The samples are only valid until the callback returns.
+/// </remarks>
+typedef void (*benchlab_batch_callback)(
+    _In_ benchlab_handle source,
+    _In_reads_(cnt) const benchlab_sample *samples,
+    _In_ size_t cnt,
+    _In_opt_ void *context);
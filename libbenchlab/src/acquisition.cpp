@@ -0,0 +1,346 @@
+﻿// <copyright file="acquisition.cpp" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#include "acquisition.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+
+#include "libbenchlab/benchlab.h"
+
+#include "debug.h"
+#include "device.h"
+
+
+/*
+ * acquisition::acquisition
+ */
+acquisition::acquisition(_In_ benchlab_device& device,
+        _In_ const benchlab_streaming_configuration& config,
+        _In_ const clock_type::time_point now) noexcept
+    : _completed(0),
+        _config(config),
+        _device(device),
+        _failures(0),
+        _limit(now),
+        _phase(phase::idle),
+        _received(0),
+        _requested(0),
+        _schedule(config, now),
+        _stopping(false) {
+    assert(benchlab_device::has_sink(config));
+}
+
+
+/*
+ * acquisition::abort
+ */
+void acquisition::abort(void) noexcept {
+    this->finish();
+}
+
+
+#if !defined(_WIN32)
+/*
+ * acquisition::descriptor
+ */
+int acquisition::descriptor(void) const noexcept {
+    return this->_device._transport->descriptor();
+}
+#endif /* !defined(_WIN32) */
+
+
+/*
+ * acquisition::next_wakeup
+ */
+acquisition::clock_type::time_point acquisition::next_wakeup(
+        void) const noexcept {
+    // An incomplete batch might fall due before the acquisition itself.
+    const auto batch = this->_device._batch.deadline();
+
+    switch (this->_phase) {
+        case phase::idle:
+            return this->_stopping
+                ? (clock_type::time_point::min)()
+                : (std::min)(this->_schedule.deadline(), batch);
+
+        case phase::awaiting:
+            return (std::min)(this->_limit, batch);
+
+        case phase::draining:
+            return this->_stopping
+                ? (clock_type::time_point::min)()
+                : (std::min)(this->_limit, batch);
+
+        default:
+            return (clock_type::time_point::max)();
+    }
+}
+
+
+/*
+ * acquisition::process
+ */
+HRESULT acquisition::process(_In_ const clock_type::time_point now) noexcept {
+    if (now >= this->_device._batch.deadline()) {
+        this->_device._batch.flush(&this->_device, this->_config);
+    }
+
+    // Each iteration makes progress or returns, so the loop only repeats if
+    // one phase hands over to another one that can proceed immediately.
+    while (true) {
+        switch (this->_phase) {
+            case phase::idle: {
+                // Anything arriving without a request is garbage, which we
+                // must remove lest the descriptor remains readable. A
+                // preloaded transport already holds all of the responses,
+                // which must be kept for the requests to come.
+                auto hr = S_OK;
+                if (!this->_device._transport->is_preloaded()) {
+                    std::size_t discarded = 0;
+                    hr = this->discard(discarded);
+                    if (FAILED(hr)) {
+                        return this->fail(hr, now);
+                    }
+                    this->_device._statistics.discarded(discarded);
+                }
+
+                if (this->_stopping) {
+                    this->finish();
+                    return S_OK;
+                }
+
+                if (now < this->_schedule.deadline()) {
+                    return S_OK;
+                }
+
+                hr = this->request(now);
+                if (FAILED(hr)) {
+                    return this->fail(hr, now);
+                }
+                } break;
+
+            case phase::awaiting: {
+                auto complete = false;
+                auto hr = this->receive(complete);
+                if (FAILED(hr)) {
+                    return this->fail(hr, now);
+                }
+
+                if (!complete) {
+                    return (now < this->_limit)
+                        ? S_OK
+                        : this->fail(benchlab_transport::timeout_error(),
+                            now);
+                }
+
+                hr = this->deliver(now);
+                if (FAILED(hr)) {
+                    return hr;
+                }
+                } break;
+
+            case phase::draining: {
+                std::size_t discarded = 0;
+                auto hr = this->discard(discarded);
+                if (FAILED(hr)) {
+                    return this->fail(hr, now);
+                }
+                this->_device._statistics.discarded(discarded);
+
+                if (this->_stopping) {
+                    this->finish();
+                    return S_OK;
+                }
+
+                if (discarded > 0) {
+                    // The line is not quiet yet.
+                    this->_limit = now + this->_device.quiet_time();
+                    return S_OK;
+                }
+
+                if (now < this->_limit) {
+                    return S_OK;
+                }
+
+                this->_schedule.restart(now + this->_schedule.period());
+                this->_phase = phase::idle;
+                } break;
+
+            default:
+                return S_OK;
+        }
+    }
+}
+
+
+/*
+ * acquisition::stop
+ */
+void acquisition::stop(void) noexcept {
+    this->_stopping = true;
+}
+
+
+/*
+ * acquisition::deliver
+ */
+HRESULT acquisition::deliver(_In_ const clock_type::time_point now) noexcept {
+    // If we have been waiting for the last response only to keep the protocol
+    // in sync, it is not delivered anymore.
+    if (this->_stopping) {
+        this->finish();
+        return S_OK;
+    }
+
+    // The frames have no header, so the only way of detecting that we are out
+    // of sync with the device is surplus input.
+    if (!this->_device._transport->is_preloaded()) {
+        std::size_t surplus = 0;
+        auto hr = this->_device._transport->available(surplus);
+        if (FAILED(hr)) {
+            return this->fail(hr, now);
+        }
+        if (surplus > 0) {
+            return this->fail(benchlab_transport::invalid_data_error(), now);
+        }
+    }
+
+    const auto timestamp = this->_device._clock.select(this->_requested,
+        this->_completed);
+    benchlab_sensor_readings readings;
+    this->_device._model->decode(readings, this->_frame.data());
+
+    if (this->_failures > 0) {
+        this->_device._statistics.recovered(now - this->_failed_since);
+        this->_failures = 0;
+    }
+
+    // In pipelined mode, the next request goes out before the callback if it
+    // is due, like in the streaming thread. If that fails, the sample we
+    // already have is still delivered.
+    auto retval = S_OK;
+    this->_phase = phase::idle;
+    if ((this->_config.acquisition_mode == benchlab_acquisition_mode::pipelined)
+            && (now >= this->_schedule.deadline())) {
+        auto hr = this->request(now);
+        if (FAILED(hr)) {
+            retval = this->fail(hr, now);
+        }
+    }
+
+    this->_device.deliver(readings, timestamp, this->_config);
+    this->_device._statistics.record();
+
+    return retval;
+}
+
+
+/*
+ * acquisition::discard
+ */
+HRESULT acquisition::discard(_Out_ std::size_t& discarded) noexcept {
+    std::array<std::uint8_t, 256> buffer;
+    discarded = 0;
+
+    while (true) {
+        auto cnt = buffer.size();
+        auto hr = this->_device.read(buffer.data(), cnt);
+        if (FAILED(hr)) {
+            return hr;
+        }
+        if (cnt == 0) {
+            return S_OK;
+        }
+
+        discarded += cnt;
+    }
+}
+
+
+/*
+ * acquisition::fail
+ */
+HRESULT acquisition::fail(_In_ const HRESULT hr,
+        _In_ const clock_type::time_point now) noexcept {
+    // A failure while we wait for the last response to arrive has the same
+    // effect as receiving it: we can stop now.
+    if (this->_stopping || !benchlab_device::is_recoverable(hr)) {
+        _benchlab_debug("Acquisition stopped due to an I/O error.\r\n");
+        this->finish();
+        return this->_stopping ? S_OK : hr;
+    }
+
+    this->_device._statistics.failed();
+    if (this->_failures++ == 0) {
+        this->_failed_since = now;
+    }
+
+    const auto max_failures = this->_config.max_failures;
+    if ((max_failures > 0) && (this->_failures > max_failures)) {
+        _benchlab_debug("Acquisition stopped after too many consecutive "
+            "failures.\r\n");
+        this->finish();
+        return hr;
+    }
+
+    this->_limit = now + this->_device.quiet_time();
+    this->_phase = phase::draining;
+    return S_OK;
+}
+
+
+/*
+ * acquisition::finish
+ */
+void acquisition::finish(void) noexcept {
+    // Samples that are still held back are delivered before the device is
+    // marked as stopped.
+    this->_phase = phase::finished;
+    this->_device._batch.flush(&this->_device, this->_config);
+}
+
+
+/*
+ * acquisition::receive
+ */
+HRESULT acquisition::receive(_Out_ bool& complete) noexcept {
+    const auto size = this->_device._model->frame_size;
+    auto dst = this->_frame.data();
+    auto cnt = size - this->_received;
+    assert(cnt > 0);
+
+    auto hr = this->_device.read(dst + this->_received, cnt);
+    if (SUCCEEDED(hr)) {
+        this->_received += cnt;
+    }
+
+    complete = (this->_received == size);
+    if (complete) {
+        this->_completed = this->_device._clock.now();
+    }
+
+    return hr;
+}
+
+
+/*
+ * acquisition::request
+ */
+HRESULT acquisition::request(_In_ const clock_type::time_point now) noexcept {
+    this->_requested = this->_device._clock.now();
+    auto retval = this->_device.request();
+
+    if (SUCCEEDED(retval)) {
+        this->_device._statistics.overran(this->_schedule.advance(now));
+        this->_limit = now + this->_device._timeout;
+        this->_phase = phase::awaiting;
+        this->_received = 0;
+    }
+
+    return retval;
+}
@@ -0,0 +1,194 @@
+﻿// <copyright file="acquisition.h" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#if !defined(_BENCHLAB_ACQUISITION_H)
+#define _BENCHLAB_ACQUISITION_H
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cinttypes>
+#include <cstddef>
+
+#include "libbenchlab/streaming.h"
+#include "libbenchlab/types.h"
+
+#include "device_model_registry.h"
+#include "sample_schedule.h"
+
+
+/* Forward declarations. */
+struct benchlab_device;
+
+
+/// <summary>
+/// Implements the acquisition of samples from a streaming device as a
+/// non-blocking state machine.
+/// </summary>
+/// <remarks>
+/// <para>This is the counterpart of <see cref="benchlab_device::stream" />
+/// for event loops driving many devices from a single thread. Instead of
+/// blocking, the owner of the state machine calls <see cref="process" />
+/// whenever the <see cref="descriptor" /> of the device becomes readable or
+/// <see cref="next_wakeup" /> has passed.</para>
+/// <para>The state machine implements the same protocol as the streaming
+/// thread, including the recovery from failed samples.</para>
+/// </remarks>
+class LIBBENCHLAB_TEST_API acquisition final {
+
+public:
+
+    typedef std::chrono::steady_clock clock_type;
+
+    /// <summary>
+    /// Initialises a new instance.
+    /// </summary>
+    /// <param name="device">The device to acquire samples from, which must
+    /// outlive the state machine.</param>
+    /// <param name="config">The streaming configuration.</param>
+    /// <param name="now">The current time, which is when the first sample
+    /// will be requested.</param>
+    acquisition(_In_ benchlab_device& device,
+        _In_ const benchlab_streaming_configuration& config,
+        _In_ const clock_type::time_point now) noexcept;
+
+    acquisition(const acquisition&) = delete;
+
+    /// <summary>
+    /// Stops the state machine immediately without consuming any outstanding
+    /// response, which is used if the device is gone.
+    /// </summary>
+    void abort(void) noexcept;
+
+#if !defined(_WIN32)
+    /// <summary>
+    /// Answer the descriptor that becomes readable when the device sends
+    /// data, or -1 if the transport of the device has none.
+    /// </summary>
+    int descriptor(void) const noexcept;
+#endif /* !defined(_WIN32) */
+
+    /// <summary>
+    /// Answer the device the samples are acquired from.
+    /// </summary>
+    inline benchlab_device& device(void) const noexcept {
+        return this->_device;
+    }
+
+    /// <summary>
+    /// Answer whether the state machine has stopped and can be discarded.
+    /// </summary>
+    inline bool finished(void) const noexcept {
+        return (this->_phase == phase::finished);
+    }
+
+    /// <summary>
+    /// Answer when <see cref="process" /> must be called at the latest, even
+    /// if the device has not sent any data.
+    /// </summary>
+    /// <remarks>
+    /// If the state machine can stop right away, this is a point in the
+    /// past.
+    /// </remarks>
+    clock_type::time_point next_wakeup(void) const noexcept;
+
+    /// <summary>
+    /// Advances the state machine as far as possible without blocking.
+    /// </summary>
+    /// <param name="now">The current time.</param>
+    /// <returns><c>S_OK</c> if the state machine can continue, or the error
+    /// that stopped the acquisition. In the latter case, the state machine
+    /// has <see cref="finished" />.</returns>
+    HRESULT process(_In_ const clock_type::time_point now) noexcept;
+
+    /// <summary>
+    /// Requests the state machine to stop.
+    /// </summary>
+    /// <remarks>
+    /// If a response is outstanding, the state machine will still consume
+    /// it such that it is not mistaken for the answer to the next command.
+    /// The state machine has <see cref="finished" /> once
+    /// <see cref="process" /> found it safe to stop.
+    /// </remarks>
+    void stop(void) noexcept;
+
+    acquisition& operator =(const acquisition&) = delete;
+
+private:
+
+    /// <summary>
+    /// The states of the acquisition.
+    /// </summary>
+    enum class phase {
+        /// <summary>
+        /// Waiting for the next sample to become due.
+        /// </summary>
+        idle,
+
+        /// <summary>
+        /// Waiting for the response to a request.
+        /// </summary>
+        awaiting,
+
+        /// <summary>
+        /// Discarding input until the line has been quiet after a failure.
+        /// </summary>
+        draining,
+
+        /// <summary>
+        /// The acquisition has ended.
+        /// </summary>
+        finished
+    };
+
+    /// <summary>
+    /// Delivers the frame in <see cref="_frame" /> to the callback.
+    /// </summary>
+    HRESULT deliver(_In_ const clock_type::time_point now) noexcept;
+
+    /// <summary>
+    /// Discards all input that is available right now.
+    /// </summary>
+    HRESULT discard(_Out_ std::size_t& discarded) noexcept;
+
+    /// <summary>
+    /// Handles a failed sample, either by starting to resynchronise or by
+    /// stopping the acquisition.
+    /// </summary>
+    HRESULT fail(_In_ const HRESULT hr,
+        _In_ const clock_type::time_point now) noexcept;
+
+    /// <summary>
+    /// Ends the acquisition after delivering any incomplete batch.
+    /// </summary>
+    void finish(void) noexcept;
+
+    /// <summary>
+    /// Reads as much of the outstanding response as is available.
+    /// </summary>
+    /// <param name="complete">Is set if the response is complete.</param>
+    HRESULT receive(_Out_ bool& complete) noexcept;
+
+    /// <summary>
+    /// Requests the next sample.
+    /// </summary>
+    HRESULT request(_In_ const clock_type::time_point now) noexcept;
+
+    benchlab_timestamp _completed;
+    benchlab_streaming_configuration _config;
+    benchlab_device& _device;
+    clock_type::time_point _failed_since;
+    std::array<std::uint8_t, supported_device_models::max_frame_size> _frame;
+    std::uint32_t _failures;
+    clock_type::time_point _limit;
+    phase _phase;
+    std::size_t _received;
+    benchlab_timestamp _requested;
+    sample_schedule _schedule;
+    bool _stopping;
+};
+
+#endif /* !defined(_BENCHLAB_ACQUISITION_H) */
@@ -5,12 +5,113 @@
 // <author>Christoph Müller</author>
 
 #include "libbenchlab/benchlab.h"
+#include "libbenchlab/channel_descriptors.h"
 
+#include <algorithm>
+#include <chrono>
 #include <cstring>
 #include <iterator>
+#include <system_error>
+#include <thread>
 
+#include "channel_selection.h"
 #include "debug.h"
 #include "device.h"
+#include "sample_clock.h"
+#include "sample_conversion.h"
+#include "sensor_frame.h"
+#include "serial_configuration.h"
+
+
+/// <summary>
+/// Checks whether <paramref name="config" /> is a valid streaming
+/// configuration for any of the streaming modes.
+/// </summary>
+/// <param name="config">The configuration to be checked.</param>
+/// <returns><c>S_OK</c> if the configuration is valid,
+/// <c>E_INVALIDARG</c> if any of its members is invalid, or the error of
+/// <see cref="sample_clock::check" /> if the clock is not supported.
+/// </returns>
+static HRESULT check_streaming_configuration(
+        _In_ const benchlab_streaming_configuration& config) noexcept {
+    if (config.version != 1) {
+        _benchlab_debug("The version of the streaming configuration is not "
+            "supported.\r\n");
+        return E_INVALIDARG;
+    }
+    if (config.acquisition_mode > benchlab_acquisition_mode::pipelined) {
+        _benchlab_debug("The acquisition mode is invalid.\r\n");
+        return E_INVALIDARG;
+    }
+    if (config.period == 0) {
+        _benchlab_debug("The streaming period must be positive.\r\n");
+        return E_INVALIDARG;
+    }
+    if (!benchlab_device::has_sink(config)) {
+        _benchlab_debug("The sample callbacks are invalid pointers and "
+            "there is no sample buffer.\r\n");
+        return E_INVALIDARG;
+    }
+    if ((config.batch_callback != nullptr) && (config.batch_size == 0)) {
+        _benchlab_debug("The batch size must be positive.\r\n");
+        return E_INVALIDARG;
+    }
+    if (channel_selection(config.channels).size() == 0) {
+        _benchlab_debug("No channels have been selected.\r\n");
+        return E_INVALIDARG;
+    }
+    if (config.timestamp_point > benchlab_timestamp_point::midpoint) {
+        _benchlab_debug("The timestamp point is invalid.\r\n");
+        return E_INVALIDARG;
+    }
+    if (config.overrun_policy > benchlab_overrun_policy::rephase) {
+        _benchlab_debug("The overrun policy is invalid.\r\n");
+        return E_INVALIDARG;
+    }
+
+    return sample_clock::check(config.clock);
+}
+
+
+/// <summary>
+/// Derives the serial configuration for the handshakes of a probe from the
+/// given probe configuration.
+/// </summary>
+/// <remarks>
+/// The timeout of the probe is split among the round trips of the handshake,
+/// which are the welcome check and the (calibrated) retrieval of the vendor
+/// data. The command sleep of each round trip is taken from its share of the
+/// timeout, and the read timeout covers the rest. Captures are disabled,
+/// because all ports would write to the same file.
+/// </remarks>
+static HRESULT make_probe_configuration(
+        _Out_ benchlab_serial_configuration& dst,
+        _In_ const benchlab_probe_configuration& config) noexcept {
+    {
+        auto hr = ::copy_serial_configuration(dst,
+            config.serial_configuration);
+        if (FAILED(hr)) {
+            _benchlab_debug("Invalid serial configuration provided.\r\n");
+            return hr;
+        }
+    }
+
+    const std::uint32_t round_trips = dst.calibrate_command_sleep
+        ? 1 + (std::max)(dst.calibration_rounds, std::uint32_t(1))
+        : 2;
+    const auto timeout = (std::max)(config.timeout / round_trips,
+        std::uint32_t(1));
+
+    // The command sleep is in microseconds and may use at most half of the
+    // share of each round trip such that the read has a chance to succeed.
+    const auto sleep = (std::min)(dst.command_sleep, timeout * 1000 / 2);
+    dst.command_sleep = sleep;
+    dst.read_timeout = (std::min)(dst.read_timeout,
+        (std::max)(timeout - sleep / 1000, std::uint32_t(1)));
+    dst.write_timeout = (std::min)(dst.write_timeout, timeout);
+
+    return S_OK;
+}
 
 
 /*
@@ -42,6 +143,34 @@ HRESULT LIBBENCHLAB_API benchlab_close(_In_ const benchlab_handle handle) {
 }
 
 
+/*
+ * ::benchlab_get_command_sleep
+ */
+HRESULT LIBBENCHLAB_API benchlab_get_command_sleep(
+        _Out_ uint32_t *out_command_sleep,
+        _Out_opt_ uint32_t *out_latency,
+        _In_ benchlab_handle handle) {
+    if (out_command_sleep == nullptr) {
+        _benchlab_debug("The output buffer is an invalid pointer.\r\n");
+        return E_POINTER;
+    }
+    if (handle == nullptr) {
+        _benchlab_debug("The device handle is invalid.\r\n");
+        return E_HANDLE;
+    }
+
+    std::chrono::microseconds sleep, latency;
+    handle->command_timing(sleep, latency);
+
+    *out_command_sleep = static_cast<std::uint32_t>(sleep.count());
+    if (out_latency != nullptr) {
+        *out_latency = static_cast<std::uint32_t>(latency.count());
+    }
+
+    return S_OK;
+}
+
+
 /*
  * benchlab_get_device_name
  */
@@ -123,6 +252,74 @@ HRESULT LIBBENCHLAB_API benchlab_get_firmware(
 }
 
 
+/*
+ * ::benchlab_get_next_wakeup
+ */
+HRESULT LIBBENCHLAB_API benchlab_get_next_wakeup(
+        _Out_ uint64_t *out_timeout,
+        _In_ benchlab_handle handle) {
+    if (out_timeout == nullptr) {
+        _benchlab_debug("The output buffer is an invalid pointer.\r\n");
+        return E_POINTER;
+    }
+    if (handle == nullptr) {
+        _benchlab_debug("The device handle is invalid.\r\n");
+        return E_HANDLE;
+    }
+
+    std::chrono::microseconds timeout;
+    auto retval = handle->next_wakeup(timeout);
+    *out_timeout = static_cast<std::uint64_t>(timeout.count());
+    return retval;
+}
+
+
+/*
+ * ::benchlab_get_poll_descriptor
+ */
+HRESULT LIBBENCHLAB_API benchlab_get_poll_descriptor(
+        _Out_ int *out_descriptor,
+        _In_ benchlab_handle handle) {
+    if (out_descriptor == nullptr) {
+        _benchlab_debug("The output buffer is an invalid pointer.\r\n");
+        return E_POINTER;
+    }
+
+    *out_descriptor = -1;
+
+    if (handle == nullptr) {
+        _benchlab_debug("The device handle is invalid.\r\n");
+        return E_HANDLE;
+    }
+
+#if defined(_WIN32)
+    return E_NOTIMPL;
+#else /* defined(_WIN32) */
+    return handle->descriptor(*out_descriptor);
+#endif /* defined(_WIN32) */
+}
+
+
+/*
+ * ::benchlab_get_streaming_statistics
+ */
+HRESULT LIBBENCHLAB_API benchlab_get_streaming_statistics(
+        _Out_ benchlab_streaming_statistics *out_statistics,
+        _In_ benchlab_handle handle) {
+    if (out_statistics == nullptr) {
+        _benchlab_debug("The output buffer is an invalid pointer.\r\n");
+        return E_POINTER;
+    }
+    if (handle == nullptr) {
+        _benchlab_debug("The device handle is invalid.\r\n");
+        return E_HANDLE;
+    }
+
+    handle->statistics(*out_statistics);
+    return S_OK;
+}
+
+
 /*
  * benchlab_get_power_sensors
  */
@@ -130,21 +327,11 @@ HRESULT LIBBENCHLAB_API benchlab_get_power_sensors(
         _Out_writes_opt_(*cnt) benchlab_char *out_sensors,
         _Inout_ size_t *cnt) {
     typedef std::char_traits<benchlab_char> traits_type;
-    static constexpr const benchlab_char *const names[] = {
-        BENCHLAB_STR("EPS1"),
-        BENCHLAB_STR("EPS2"),
-        BENCHLAB_STR("ATX3V"),
-        BENCHLAB_STR("ATX5V"),
-        BENCHLAB_STR("ATX5VSB"),
-        BENCHLAB_STR("ATX12V"),
-        BENCHLAB_STR("PCIE1"),
-        BENCHLAB_STR("PCIE2"),
-        BENCHLAB_STR("PCIE3"),
-        BENCHLAB_STR("HPWR1"),
-        BENCHLAB_STR("HPWR2")
-    };
-    static_assert(std::size(names) == BENCHLAB_POWER_SENSORS, "Names are "
-        "provided for all power sensors.");
+
+    // The names of the power sensors are the names of their voltage channels.
+    const auto first = visus::benchlab::channel_descriptors
+        + static_cast<std::size_t>(benchlab_channel::voltage);
+    const auto last = first + BENCHLAB_POWER_SENSORS;
 
     if (cnt == nullptr) {
         _benchlab_debug("The size parameter is an invalid pointer.\r\n");
@@ -159,8 +346,8 @@ HRESULT LIBBENCHLAB_API benchlab_get_power_sensors(
     // Determine how many characters we need for all the names as multi-sz
     // string.
     std::size_t required = 1;
-    for (auto n : names) {
-        required += traits_type::length(n) + 1;
+    for (auto d = first; d != last; ++d) {
+        required += traits_type::length(d->name) + 1;
     }
 
     // If the user buffer is not big enough, report the required size and bail
@@ -175,7 +362,8 @@ HRESULT LIBBENCHLAB_API benchlab_get_power_sensors(
     // strings.
     *cnt = required;
     auto dst = out_sensors;
-    for (auto n : names) {
+    for (auto d = first; d != last; ++d) {
+        auto n = d->name;
         while ((*dst++ = *n++));
     }
     *dst = static_cast<benchlab_char>(0);
@@ -232,6 +420,61 @@ HRESULT LIBBENCHLAB_API benchlab_open(_Out_ benchlab_handle *out_handle,
 }
 
 
+/*
+ * ::benchlab_open_transport
+ */
+HRESULT LIBBENCHLAB_API benchlab_open_transport(
+        _Out_ benchlab_handle *out_handle,
+        _In_ benchlab_transport_handle transport,
+        _In_opt_ const benchlab_serial_configuration *config) {
+    // Take ownership first such that we do not leak the transport if the
+    // input is invalid.
+    std::unique_ptr<benchlab_transport> t(transport);
+
+    if (out_handle == nullptr) {
+        _benchlab_debug("Invalid storage location for handle provided.\r\n");
+        return E_POINTER;
+    }
+
+    *out_handle = nullptr;
+
+    if (t == nullptr) {
+        _benchlab_debug("Invalid transport provided.\r\n");
+        return E_HANDLE;
+    }
+
+    benchlab_serial_configuration dft_conf;
+    if (config == nullptr) {
+        dft_conf.version = 1;
+        auto hr = ::benchlab_initialise_serial_configuration(&dft_conf);
+        if (FAILED(hr)) {
+            _benchlab_debug("Failed to initialise default serial "
+                "configuration.\r\n");
+            return hr;
+        }
+    }
+
+    std::unique_ptr<benchlab_device> device(
+        new (std::nothrow) benchlab_device());
+    if (device == nullptr) {
+        _benchlab_debug("Insufficient memory for benchlab_device.\r\n");
+        return E_OUTOFMEMORY;
+    }
+
+    auto conf = (config != nullptr) ? config : &dft_conf;
+    auto hr = device->open(std::move(t), conf);
+    if (hr != S_OK) {
+        _benchlab_debug("Failed to open Benchlab device.\r\n");
+
+    } else {
+        *out_handle = device.release();
+        _benchlab_debug("Benchlab device ready.\r\n");
+    }
+
+    return hr;
+}
+
+
 /*
  * ::benchlab_readings_to_sample
  */
@@ -248,46 +491,62 @@ HRESULT LIBBENCHLAB_API benchlab_readings_to_sample(
         return E_POINTER;
     }
 
-    const auto is_invalid = [](const std::int16_t v) { return (v == 0x7FFF); };
+    convert_readings(out_sample, readings, 1, timestamp,
+        (timestamp != nullptr) ? *timestamp : benchlab_make_timestamp());
 
-    out_sample->timestamp = (timestamp != nullptr)
-        ? *timestamp
-        : benchlab_make_timestamp();
+    return S_OK;
+}
 
-    for (std::size_t i = 0; i < std::size(readings->vin); ++i) {
-        out_sample->input_voltage[i] = is_invalid(readings->vin[i])
-            ? std::numeric_limits<float>::lowest()
-            : readings->vin[i] / 1000.0f;
+
+/*
+ * ::benchlab_readings_to_sample_batch
+ */
+HRESULT LIBBENCHLAB_API benchlab_readings_to_sample_batch(
+        _Out_writes_(cnt) benchlab_sample *out_samples,
+        _In_reads_(cnt) const benchlab_sensor_readings *readings,
+        _In_ const size_t cnt,
+        _In_reads_opt_(cnt) const benchlab_timestamp *timestamps) {
+    if ((out_samples == nullptr) && (cnt > 0)) {
+        _benchlab_debug("The output buffer is an invalid pointer.\r\n");
+        return E_POINTER;
+    }
+    if ((readings == nullptr) && (cnt > 0)) {
+        _benchlab_debug("The input data are an invalid pointer.\r\n");
+        return E_POINTER;
     }
 
-    out_sample->supply_voltage = readings->vdd / 1000.0f;
-    out_sample->reference_voltage = readings->vref / 1000.0f;
-    out_sample->chip_temperature = static_cast<float>(readings->tchip);   //?????
+    const auto now = (timestamps == nullptr)
+        ? benchlab_make_timestamp()
+        : 0;
+    convert_readings(out_samples, readings, cnt, timestamps, now);
 
-    for (std::size_t i = 0; i < std::size(readings->ts); ++i) {
-        out_sample->temperatures[i] = is_invalid(readings->ts[i])
-            ? std::numeric_limits<float>::lowest()
-            : readings->ts[i] / 10.0f;
-    }
+    return S_OK;
+}
 
-    out_sample->ambient_temperature = readings->tamb / 10.0f;
-    out_sample->humidity = readings->hum / 10.0f;
-    out_sample->external_fan_duty = readings->external_fan_duty;
 
-    for (std::size_t i = 0; i < std::size(readings->power_readings); ++i) {
-        out_sample->voltages[i]
-            = readings->power_readings[i].voltage / 1000.0f;
-        out_sample->currents[i]
-            = readings->power_readings[i].current / 1000.0f;
-        out_sample->power[i]
-            = readings->power_readings[i].power / 1000.0f;
+/*
+ * ::benchlab_frames_to_samples
+ */
+HRESULT LIBBENCHLAB_API benchlab_frames_to_samples(
+        _Out_writes_(cnt) benchlab_sample *out_samples,
+        _In_reads_bytes_(cnt * BENCHLAB_SENSOR_FRAME_SIZE) const void *frames,
+        _In_ const size_t cnt,
+        _In_reads_opt_(cnt) const benchlab_timestamp *timestamps) {
+    if ((out_samples == nullptr) && (cnt > 0)) {
+        _benchlab_debug("The output buffer is an invalid pointer.\r\n");
+        return E_POINTER;
     }
-
-    for (std::size_t i = 0; i < std::size(readings->fans); ++i) {
-        out_sample->fan_speeds[i] = readings->fans[i].tach;
-        out_sample->fan_duties[i] = readings->fans[i].duty;
+    if ((frames == nullptr) && (cnt > 0)) {
+        _benchlab_debug("The input data are an invalid pointer.\r\n");
+        return E_POINTER;
     }
 
+    const auto now = (timestamps == nullptr)
+        ? benchlab_make_timestamp()
+        : 0;
+    sensor_frame::decode(out_samples,
+        static_cast<const std::uint8_t *>(frames), cnt, timestamps, now);
+
     return S_OK;
 }
 
@@ -298,6 +557,19 @@ HRESULT LIBBENCHLAB_API benchlab_readings_to_sample(
 HRESULT LIBBENCHLAB_API benchlab_probe(
         _Out_writes_opt_(*cnt) benchlab_handle *out_handles,
         _Inout_ size_t *cnt) {
+    return ::benchlab_probe_ex(out_handles, cnt, nullptr);
+}
+
+
+/*
+ * ::benchlab_probe_ex
+ */
+HRESULT LIBBENCHLAB_API benchlab_probe_ex(
+        _Out_writes_opt_(*cnt) benchlab_handle *out_handles,
+        _Inout_ size_t *cnt,
+        _In_opt_ const benchlab_probe_configuration *config) {
+    typedef std::chrono::steady_clock clock_type;
+
     if (cnt == nullptr) {
         _benchlab_debug("The size parameter is an invalid pointer.\r\n");
         return E_POINTER;
@@ -309,6 +581,24 @@ HRESULT LIBBENCHLAB_API benchlab_probe(
         *cnt = 0;
     }
 
+    benchlab_probe_configuration dft_conf;
+    if (config == nullptr) {
+        dft_conf.version = 1;
+        auto hr = ::benchlab_initialise_probe_configuration(&dft_conf);
+        if (FAILED(hr)) {
+            _benchlab_debug("Failed to initialise default probe "
+                "configuration.\r\n");
+            return hr;
+        }
+    }
+
+    auto conf = (config != nullptr) ? config : &dft_conf;
+    if (conf->version != 1) {
+        _benchlab_debug("The version of the probe configuration is not "
+            "supported.\r\n");
+        return E_INVALIDARG;
+    }
+
     // Get all serial ports as candidates where a device could be attached to.
     std::vector<std::basic_string<benchlab_char>> ports;
     {
@@ -326,14 +616,70 @@ HRESULT LIBBENCHLAB_API benchlab_probe(
         return HRESULT_FROM_WIN32(ERROR_INSUFFICIENT_BUFFER);
     }
 
-    // Open the devices and count how many of it are actually working.
+    // Bound the handshake on each port by the timeout of the probe.
+    benchlab_serial_configuration serial;
+    {
+        auto hr = make_probe_configuration(serial, *conf);
+        if (FAILED(hr)) {
+            return hr;
+        }
+    }
+
+    // Open all ports concurrently such that the probe takes as long as the
+    // slowest handshake rather than the sum of all of them. If we cannot get
+    // a thread for a port, we probe it on the calling thread.
+    struct probe_state {
+        clock_type::duration elapsed;
+        benchlab_handle handle;
+        HRESULT result;
+    };
+
+    std::vector<probe_state> states(ports.size(),
+        { clock_type::duration::zero(), nullptr, E_FAIL });
+    auto probe = [&ports, &serial, &states](const std::size_t i) {
+        const auto begin = clock_type::now();
+        states[i].result = ::benchlab_open(&states[i].handle,
+            ports[i].c_str(),
+            &serial);
+        states[i].elapsed = clock_type::now() - begin;
+    };
+
+    {
+        std::vector<std::thread> threads;
+        threads.reserve(ports.size());
+
+        for (std::size_t i = 0; i < ports.size(); ++i) {
+            try {
+                threads.emplace_back(probe, i);
+            } catch (std::system_error&) {
+                _benchlab_debug("Probing on the calling thread.\r\n");
+                probe(i);
+            }
+        }
+
+        for (auto& t : threads) {
+            t.join();
+        }
+    }
+
+    // Collect the devices that are actually working and report the results
+    // in the order of the ports.
     *cnt = 0;
     for (std::size_t i = 0; i < ports.size(); ++i) {
-        _Analysis_assume_(out_handles != nullptr);
-        if (SUCCEEDED(::benchlab_open(out_handles + *cnt,
-                ports[i].c_str(),
-                nullptr))) {
-            ++cnt;
+        auto& s = states[i];
+
+        if (SUCCEEDED(s.result)) {
+            _Analysis_assume_(out_handles != nullptr);
+            out_handles[(*cnt)++] = s.handle;
+        }
+
+        if (conf->callback != nullptr) {
+            benchlab_probe_result result;
+            result.elapsed = std::chrono::duration_cast<
+                std::chrono::microseconds>(s.elapsed).count();
+            result.port = ports[i].c_str();
+            result.result = s.result;
+            conf->callback(&result, conf->context);
         }
     }
 
@@ -341,6 +687,30 @@ HRESULT LIBBENCHLAB_API benchlab_probe(
 }
 
 
+/*
+ * ::benchlab_process
+ */
+HRESULT LIBBENCHLAB_API benchlab_process(_In_ benchlab_handle handle) {
+    if (handle == nullptr) {
+        _benchlab_debug("The device handle is invalid.\r\n");
+        return E_HANDLE;
+    }
+
+    return handle->process();
+}
+
+
+/*
+ * ::benchlab_poll_samples
+ */
+HRESULT LIBBENCHLAB_API benchlab_poll_samples(
+        _Out_writes_to_(*cnt, *cnt) benchlab_sample *out_samples,
+        _Inout_ size_t *cnt,
+        _In_ benchlab_handle handle) {
+    return ::benchlab_wait_samples(out_samples, cnt, 0, handle);
+}
+
+
 /*
  * ::benchlab_read_rgb
  */
@@ -400,6 +770,58 @@ HRESULT LIBBENCHLAB_API benchlab_start_streaming(_In_ const benchlab_handle hand
 }
 
 
+/*
+ * benchlab_start_streaming_ex
+ */
+HRESULT LIBBENCHLAB_API benchlab_start_streaming_ex(
+        _In_ const benchlab_handle handle,
+        _In_ const benchlab_streaming_configuration *config) {
+    if (handle == nullptr) {
+        _benchlab_debug("The device handle is invalid.\r\n");
+        return E_HANDLE;
+    }
+    if (config == nullptr) {
+        _benchlab_debug("The streaming configuration is an invalid "
+            "pointer.\r\n");
+        return E_POINTER;
+    }
+    {
+        auto hr = check_streaming_configuration(*config);
+        if (FAILED(hr)) {
+            return hr;
+        }
+    }
+
+    return handle->start(*config);
+}
+
+
+/*
+ * benchlab_start_streaming_external
+ */
+HRESULT LIBBENCHLAB_API benchlab_start_streaming_external(
+        _In_ const benchlab_handle handle,
+        _In_ const benchlab_streaming_configuration *config) {
+    if (handle == nullptr) {
+        _benchlab_debug("The device handle is invalid.\r\n");
+        return E_HANDLE;
+    }
+    if (config == nullptr) {
+        _benchlab_debug("The streaming configuration is an invalid "
+            "pointer.\r\n");
+        return E_POINTER;
+    }
+    {
+        auto hr = check_streaming_configuration(*config);
+        if (FAILED(hr)) {
+            return hr;
+        }
+    }
+
+    return handle->start_external(*config);
+}
+
+
 /*
  * benchlab_stop_streaming
  */
@@ -414,6 +836,33 @@ HRESULT LIBBENCHLAB_API benchlab_stop_streaming(
 }
 
 
+/*
+ * ::benchlab_wait_samples
+ */
+HRESULT LIBBENCHLAB_API benchlab_wait_samples(
+        _Out_writes_to_(*cnt, *cnt) benchlab_sample *out_samples,
+        _Inout_ size_t *cnt,
+        _In_ const uint32_t timeout,
+        _In_ benchlab_handle handle) {
+    if (cnt == nullptr) {
+        _benchlab_debug("The sample count is an invalid pointer.\r\n");
+        return E_POINTER;
+    }
+    if ((out_samples == nullptr) || (*cnt == 0)) {
+        _benchlab_debug("The output buffer is an invalid pointer.\r\n");
+        *cnt = 0;
+        return E_POINTER;
+    }
+    if (handle == nullptr) {
+        _benchlab_debug("The device handle is invalid.\r\n");
+        *cnt = 0;
+        return E_HANDLE;
+    }
+
+    return handle->poll(out_samples, *cnt, std::chrono::milliseconds(timeout));
+}
+
+
 /*
  * ::benchlab_write_rgb
  */
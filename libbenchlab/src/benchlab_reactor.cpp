@@ -0,0 +1,90 @@
+﻿// <copyright file="benchlab_reactor.cpp" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#include "benchlab_reactor.h"
+
+#include <cassert>
+#include <new>
+
+#include "debug.h"
+
+
+/*
+ * benchlab_reactor::~benchlab_reactor
+ */
+benchlab_reactor::~benchlab_reactor(void) noexcept {
+    this->stop();
+}
+
+
+/*
+ * benchlab_reactor::select
+ */
+reactor_loop *benchlab_reactor::select(void) noexcept {
+    reactor_loop *retval = nullptr;
+
+    for (auto& l : this->_loops) {
+        if ((retval == nullptr) || (l->load() < retval->load())) {
+            retval = l.get();
+        }
+    }
+
+    return retval;
+}
+
+
+/*
+ * benchlab_reactor::start
+ */
+HRESULT benchlab_reactor::start(
+        _In_ const benchlab_reactor_configuration& config) noexcept {
+#if defined(_WIN32)
+    return E_NOTIMPL;
+
+#else /* defined(_WIN32) */
+    assert(config.threads > 0);
+
+    if (!this->_loops.empty()) {
+        _benchlab_debug("The reactor is already running.\r\n");
+        return E_NOT_VALID_STATE;
+    }
+
+    auto retval = S_OK;
+
+    for (std::uint32_t i = 0; (i < config.threads) && SUCCEEDED(retval);
+            ++i) {
+        std::unique_ptr<reactor_loop> loop(new (std::nothrow) reactor_loop());
+        if (loop == nullptr) {
+            _benchlab_debug("Insufficient memory for reactor loop.\r\n");
+            retval = E_OUTOFMEMORY;
+            break;
+        }
+
+        retval = loop->start();
+        if (SUCCEEDED(retval)) {
+            this->_loops.push_back(std::move(loop));
+        }
+    }
+
+    if (FAILED(retval)) {
+        this->stop();
+    }
+
+    return retval;
+#endif /* defined(_WIN32) */
+}
+
+
+/*
+ * benchlab_reactor::stop
+ */
+void benchlab_reactor::stop(void) noexcept {
+    for (auto& l : this->_loops) {
+        l->stop();
+    }
+
+    this->_loops.clear();
+}
@@ -0,0 +1,68 @@
+﻿// <copyright file="benchlab_reactor.h" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#if !defined(_BENCHLAB_BENCHLAB_REACTOR_H)
+#define _BENCHLAB_BENCHLAB_REACTOR_H
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "libbenchlab/reactor.h"
+
+#include "reactor_loop.h"
+
+
+/// <summary>
+/// A pool of <see cref="reactor_loop" />s, each of which runs on its own
+/// thread.
+/// </summary>
+struct LIBBENCHLAB_TEST_API benchlab_reactor final {
+
+public:
+
+    /// <summary>
+    /// Initialises a new instance.
+    /// </summary>
+    benchlab_reactor(void) noexcept = default;
+
+    benchlab_reactor(const benchlab_reactor&) = delete;
+
+    /// <summary>
+    /// Finalises the instance, which stops all loops.
+    /// </summary>
+    ~benchlab_reactor(void) noexcept;
+
+    /// <summary>
+    /// Answer the loop serving the fewest devices, which is where the next
+    /// device should be attached.
+    /// </summary>
+    /// <returns>The least loaded loop, or <c>nullptr</c> if the reactor is
+    /// not running.</returns>
+    reactor_loop *select(void) noexcept;
+
+    /// <summary>
+    /// Starts the loops.
+    /// </summary>
+    /// <param name="config">The configuration of the reactor.</param>
+    /// <returns><c>S_OK</c> in case of success, <c>E_NOT_VALID_STATE</c> if
+    /// the reactor is already running, <c>E_NOTIMPL</c> on Windows, or
+    /// another error code if a loop could not be started.</returns>
+    HRESULT start(_In_ const benchlab_reactor_configuration& config) noexcept;
+
+    /// <summary>
+    /// Stops all loops and waits for their threads to exit.
+    /// </summary>
+    void stop(void) noexcept;
+
+    benchlab_reactor& operator =(const benchlab_reactor&) = delete;
+
+private:
+
+    std::vector<std::unique_ptr<reactor_loop>> _loops;
+};
+
+#endif /* !defined(_BENCHLAB_BENCHLAB_REACTOR_H) */
@@ -0,0 +1,176 @@
+﻿// <copyright file="benchlab_transport.h" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#if !defined(_BENCHLAB_BENCHLAB_TRANSPORT_H)
+#define _BENCHLAB_BENCHLAB_TRANSPORT_H
+#pragma once
+
+#include <cerrno>
+#include <chrono>
+#include <cinttypes>
+#include <cstddef>
+#include <memory>
+
+#include "libbenchlab/serial.h"
+#include "libbenchlab/transport.h"
+#include "libbenchlab/types.h"
+
+
+/// <summary>
+/// The interface of the byte stream that connects a
+/// <see cref="benchlab_device" /> with the hardware, an emulator or a
+/// recording.
+/// </summary>
+/// <remarks>
+/// <para>Implementations must allow for one thread reading and another one
+/// closing the transport concurrently. Closing must make any pending or
+/// future <see cref="read" />, <see cref="wait" /> and <see cref="write" />
+/// fail eventually.</para>
+/// </remarks>
+struct LIBBENCHLAB_TEST_API benchlab_transport {
+
+public:
+
+    /// <summary>
+    /// The clock used to express deadlines.
+    /// </summary>
+    typedef std::chrono::steady_clock clock_type;
+
+    /// <summary>
+    /// Answer the error code for operations on a closed transport.
+    /// </summary>
+    static inline HRESULT closed_error(void) noexcept {
+        return HRESULT_FROM_WIN32(ERROR_INVALID_HANDLE);
+    }
+
+    /// <summary>
+    /// Creates the transport that is suitable for the given
+    /// <paramref name="path" />.
+    /// </summary>
+    /// <remarks>
+    /// This is the method that selects the transport for
+    /// <see cref="benchlab_open" />. Pseudo-terminals are opened using the
+    /// <see cref="pty_transport" />, everything else is considered a serial
+    /// port.
+    /// </remarks>
+    /// <param name="transport">Receives the transport in case of success.
+    /// </param>
+    /// <param name="path">The path to the serial port.</param>
+    /// <param name="config">The configuration of the serial port.</param>
+    /// <returns><c>S_OK</c> in case of success, an error code otherwise.
+    /// </returns>
+    static HRESULT create(_Out_ std::unique_ptr<benchlab_transport>& transport,
+        _In_z_ const benchlab_char *path,
+        _In_ const benchlab_serial_configuration *config) noexcept;
+
+    /// <summary>
+    /// Answer the error code for input that does not match the protocol.
+    /// </summary>
+    static inline HRESULT invalid_data_error(void) noexcept {
+        return HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+    }
+
+    /// <summary>
+    /// Answer the error code for a timeout.
+    /// </summary>
+    static inline HRESULT timeout_error(void) noexcept {
+        return HRESULT_FROM_WIN32(ERROR_TIMEOUT);
+    }
+
+    virtual ~benchlab_transport(void) noexcept = default;
+
+    /// <summary>
+    /// Determines the number of bytes that can be read without blocking.
+    /// </summary>
+    /// <param name="cnt">Receives the number of bytes in the input queue.
+    /// </param>
+    /// <returns><c>S_OK</c> in case of success, an error code otherwise.
+    /// </returns>
+    virtual HRESULT available(_Out_ std::size_t& cnt) noexcept = 0;
+
+    /// <summary>
+    /// Closes the transport.
+    /// </summary>
+    virtual HRESULT close(void) noexcept = 0;
+
+#if !defined(_WIN32)
+    /// <summary>
+    /// Answer a file descriptor that becomes readable when input arrives,
+    /// which allows for waiting on multiple transports at once.
+    /// </summary>
+    /// <returns>The descriptor, or -1 if the transport has none.</returns>
+    virtual int descriptor(void) const noexcept {
+        return -1;
+    }
+#endif /* !defined(_WIN32) */
+
+    /// <summary>
+    /// Answer whether <see cref="read" /> might return data eventually,
+    /// i.e. whether the transport has not yet been closed.
+    /// </summary>
+    virtual bool is_open(void) const noexcept = 0;
+
+    /// <summary>
+    /// Answer whether <see cref="wait" /> blocks until input arrives, which
+    /// makes any delay between a command and the read of its response
+    /// unnecessary.
+    /// </summary>
+    virtual bool is_event_driven(void) const noexcept {
+        return true;
+    }
+
+    /// <summary>
+    /// Answer whether the input may already contain the responses to
+    /// commands that have not yet been written, e.g. because the transport
+    /// replays a recording as fast as possible.
+    /// </summary>
+    /// <remarks>
+    /// Surplus input after a response cannot be used to detect corrupted
+    /// responses on such transports.
+    /// </remarks>
+    virtual bool is_preloaded(void) const noexcept {
+        return false;
+    }
+
+    /// <summary>
+    /// Reads at most <paramref name="cnt" /> bytes that are immediately
+    /// available.
+    /// </summary>
+    /// <param name="dst">A buffer that is able to receive at least
+    /// <paramref name="cnt" /> bytes.</param>
+    /// <param name="cnt">The size of <paramref name="dst" /> on entry, the
+    /// number of bytes written on successful exit, which might be zero.
+    /// </param>
+    /// <returns><c>S_OK</c> in case of success, an error code otherwise.
+    /// </returns>
+    virtual HRESULT read(_Out_writes_bytes_(cnt) void *dst,
+        _Inout_ std::size_t& cnt) noexcept = 0;
+
+    /// <summary>
+    /// Blocks the calling thread until input is available or the given
+    /// <paramref name="deadline" /> has passed.
+    /// </summary>
+    /// <param name="deadline">The point in time after which the wait will
+    /// fail.</param>
+    /// <returns><c>S_OK</c> if data might be available, a timeout error if
+    /// the deadline has passed, or any other error code if the transport
+    /// failed, e.g. because the device was unplugged.</returns>
+    virtual HRESULT wait(
+        _In_ const clock_type::time_point deadline) noexcept = 0;
+
+    /// <summary>
+    /// Synchronously writes all of the given data or fails.
+    /// </summary>
+    /// <param name="data">A pointer to at least <paramref name="cnt" />
+    /// bytes of valid data.</param>
+    /// <param name="cnt">The number of bytes to write.</param>
+    /// <returns><c>S_OK</c> in case of success, an error code otherwise.
+    /// </returns>
+    virtual HRESULT write(_In_reads_bytes_(cnt) const void *data,
+        _In_ const std::size_t cnt) noexcept = 0;
+};
+
+#endif /* !defined(_BENCHLAB_BENCHLAB_TRANSPORT_H) */
@@ -0,0 +1,99 @@
+﻿// <copyright file="capture_format.h" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#if !defined(_BENCHLAB_CAPTURE_FORMAT_H)
+#define _BENCHLAB_CAPTURE_FORMAT_H
+#pragma once
+
+#include <array>
+#include <cinttypes>
+#include <cstddef>
+
+#include "libbenchlab/types.h"
+
+
+/// <summary>
+/// The magic number and format version at the begin of a capture file.
+/// </summary>
+/// <remarks>
+/// A capture file consists of this header followed by any number of records,
+/// each of which comprises a <see cref="capture_record" /> in its serialised
+/// form and <see cref="capture_record::size" /> bytes of payload.
+/// </remarks>
+constexpr std::array<std::uint8_t, 8> capture_magic {
+    'B', 'L', 'C', 'A', 'P', '\0', 1, 0
+};
+
+
+/// <summary>
+/// Identifies in which direction the data of a record were transferred.
+/// </summary>
+enum class capture_direction : std::uint8_t {
+    received = 0,
+    sent = 1
+};
+
+
+/// <summary>
+/// The header of a chunk of data in a capture file.
+/// </summary>
+struct capture_record final {
+
+    /// <summary>
+    /// The size of the serialised header in bytes.
+    /// </summary>
+    static constexpr std::size_t serialised_size = 7;
+
+    /// <summary>
+    /// The time in microseconds since the previous record or since the
+    /// capture started if this is the first record.
+    /// </summary>
+    std::uint32_t delta;
+
+    /// <summary>
+    /// The number of bytes of payload following the header.
+    /// </summary>
+    std::uint16_t size;
+
+    /// <summary>
+    /// The direction of the transfer.
+    /// </summary>
+    capture_direction direction;
+
+    /// <summary>
+    /// Restores a record from its little-endian representation.
+    /// </summary>
+    static inline capture_record deserialise(
+            _In_reads_(serialised_size) const std::uint8_t *src) noexcept {
+        capture_record retval;
+        retval.delta = static_cast<std::uint32_t>(src[0])
+            | (static_cast<std::uint32_t>(src[1]) << 8)
+            | (static_cast<std::uint32_t>(src[2]) << 16)
+            | (static_cast<std::uint32_t>(src[3]) << 24);
+        retval.size = static_cast<std::uint16_t>(src[4]
+            | (static_cast<std::uint16_t>(src[5]) << 8));
+        retval.direction = static_cast<capture_direction>(src[6]);
+        return retval;
+    }
+
+    /// <summary>
+    /// Converts the record into its little-endian representation.
+    /// </summary>
+    inline std::array<std::uint8_t, serialised_size> serialise(
+            void) const noexcept {
+        return std::array<std::uint8_t, serialised_size> {
+            static_cast<std::uint8_t>(this->delta),
+            static_cast<std::uint8_t>(this->delta >> 8),
+            static_cast<std::uint8_t>(this->delta >> 16),
+            static_cast<std::uint8_t>(this->delta >> 24),
+            static_cast<std::uint8_t>(this->size),
+            static_cast<std::uint8_t>(this->size >> 8),
+            static_cast<std::uint8_t>(this->direction)
+        };
+    }
+};
+
+#endif /* !defined(_BENCHLAB_CAPTURE_FORMAT_H) */
@@ -0,0 +1,206 @@
+﻿// <copyright file="capture_transport.cpp" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#include "capture_transport.h"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+#include "debug.h"
+
+
+/*
+ * capture_transport::capture_transport
+ */
+capture_transport::capture_transport(
+        _Inout_ std::unique_ptr<benchlab_transport>&& transport) noexcept
+    : _last(clock_type::now()), _transport(std::move(transport)) {
+    assert(this->_transport != nullptr);
+}
+
+
+/*
+ * capture_transport::available
+ */
+HRESULT capture_transport::available(_Out_ std::size_t& cnt) noexcept {
+    return this->_transport->available(cnt);
+}
+
+
+/*
+ * capture_transport::close
+ */
+HRESULT capture_transport::close(void) noexcept {
+    auto retval = this->_transport->close();
+
+    std::lock_guard<decltype(this->_lock)> l(this->_lock);
+    if (this->_file.is_open()) {
+        this->_file.close();
+    }
+
+    return retval;
+}
+
+
+#if !defined(_WIN32)
+/*
+ * capture_transport::descriptor
+ */
+int capture_transport::descriptor(void) const noexcept {
+    return this->_transport->descriptor();
+}
+#endif /* !defined(_WIN32) */
+
+
+/*
+ * capture_transport::is_event_driven
+ */
+bool capture_transport::is_event_driven(void) const noexcept {
+    return this->_transport->is_event_driven();
+}
+
+
+/*
+ * capture_transport::is_open
+ */
+bool capture_transport::is_open(void) const noexcept {
+    return this->_transport->is_open();
+}
+
+
+/*
+ * capture_transport::is_preloaded
+ */
+bool capture_transport::is_preloaded(void) const noexcept {
+    return this->_transport->is_preloaded();
+}
+
+
+/*
+ * capture_transport::open
+ */
+HRESULT capture_transport::open(_In_z_ const benchlab_char *path) noexcept {
+    assert(path != nullptr);
+    std::lock_guard<decltype(this->_lock)> l(this->_lock);
+
+    this->_file.open(path, std::ios::binary | std::ios::trunc);
+    if (!this->_file.is_open()) {
+        _benchlab_debug("Creating the capture file failed.\r\n");
+        return E_ACCESSDENIED;
+    }
+
+    this->_file.write(reinterpret_cast<const char *>(capture_magic.data()),
+        capture_magic.size());
+    this->_last = clock_type::now();
+
+    return this->_file.good() ? S_OK : E_FAIL;
+}
+
+
+/*
+ * capture_transport::read
+ */
+HRESULT capture_transport::read(_Out_writes_bytes_(cnt) void *dst,
+        _Inout_ std::size_t& cnt) noexcept {
+    auto retval = this->_transport->read(dst, cnt);
+
+    if (SUCCEEDED(retval) && (cnt > 0)) {
+        this->record(capture_direction::received, dst, cnt);
+    }
+
+    return retval;
+}
+
+
+/*
+ * capture_transport::wait
+ */
+HRESULT capture_transport::wait(
+        _In_ const clock_type::time_point deadline) noexcept {
+    return this->_transport->wait(deadline);
+}
+
+
+/*
+ * capture_transport::write
+ */
+HRESULT capture_transport::write(_In_reads_bytes_(cnt) const void *data,
+        _In_ const std::size_t cnt) noexcept {
+    // Record the command before writing it, because the response might
+    // otherwise be read by another thread and be recorded first.
+    this->record(capture_direction::sent, data, cnt);
+    return this->_transport->write(data, cnt);
+}
+
+
+/*
+ * capture_transport::record
+ */
+void capture_transport::record(_In_ const capture_direction direction,
+        _In_reads_bytes_(cnt) const void *data,
+        _In_ std::size_t cnt) noexcept {
+    using namespace std::chrono;
+    constexpr auto max_delta = (std::numeric_limits<std::uint32_t>::max)();
+    constexpr auto max_size = (std::numeric_limits<std::uint16_t>::max)();
+    auto cur = static_cast<const char *>(data);
+
+    std::lock_guard<decltype(this->_lock)> l(this->_lock);
+    if (!this->_file.is_open()) {
+        return;
+    }
+
+    const auto now = clock_type::now();
+    auto delta = duration_cast<microseconds>(now - this->_last).count();
+    this->_last = now;
+
+    // Gaps that exceed the range of the delta are split off into empty
+    // responses, which only carry the delay. These must not be recorded as
+    // commands, because the replay starts a new segment for each command.
+    while (static_cast<std::uint64_t>(delta) > max_delta) {
+        this->write_record(capture_direction::received, max_delta, nullptr, 0);
+        delta -= max_delta;
+    }
+
+    // The payload of a command is only recorded for reference, so it is
+    // truncated to a single record such that each command yields exactly
+    // one record. Responses exceeding the range of the size are split into
+    // multiple records.
+    if (direction == capture_direction::sent) {
+        cnt = (std::min)(cnt, static_cast<std::size_t>(max_size));
+    }
+
+    do {
+        const auto size = static_cast<std::uint16_t>((std::min)(cnt,
+            static_cast<std::size_t>(max_size)));
+        this->write_record(direction, static_cast<std::uint32_t>(delta), cur,
+            size);
+        delta = 0;
+        cur += size;
+        cnt -= size;
+    } while (cnt > 0);
+}
+
+
+/*
+ * capture_transport::write_record
+ */
+void capture_transport::write_record(_In_ const capture_direction direction,
+        _In_ const std::uint32_t delta,
+        _In_reads_bytes_opt_(size) const char *data,
+        _In_ const std::uint16_t size) noexcept {
+    capture_record record;
+    record.delta = delta;
+    record.direction = direction;
+    record.size = size;
+
+    const auto header = record.serialise();
+    this->_file.write(reinterpret_cast<const char *>(header.data()),
+        header.size());
+    if (size > 0) {
+        this->_file.write(data, size);
+    }
+}
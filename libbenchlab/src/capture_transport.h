@@ -0,0 +1,106 @@
+﻿// <copyright file="capture_transport.h" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#if !defined(_BENCHLAB_CAPTURE_TRANSPORT_H)
+#define _BENCHLAB_CAPTURE_TRANSPORT_H
+#pragma once
+
+#include <fstream>
+#include <mutex>
+
+#include "benchlab_transport.h"
+#include "capture_format.h"
+
+
+/// <summary>
+/// A decorator for another <see cref="benchlab_transport" />, which records
+/// all data moved by the transport in a capture file.
+/// </summary>
+/// <remarks>
+/// The capture can be replayed by the <see cref="replay_transport" />.
+/// </remarks>
+class LIBBENCHLAB_TEST_API capture_transport final
+        : public benchlab_transport {
+
+public:
+
+    /// <summary>
+    /// Initialises a new instance.
+    /// </summary>
+    /// <param name="transport">The transport to be decorated.</param>
+    capture_transport(
+        _Inout_ std::unique_ptr<benchlab_transport>&& transport) noexcept;
+
+    /// <summary>
+    /// Finalises the instance.
+    /// </summary>
+    virtual ~capture_transport(void) noexcept = default;
+
+    /// <inheritdoc />
+    HRESULT available(_Out_ std::size_t& cnt) noexcept override;
+
+    /// <inheritdoc />
+    HRESULT close(void) noexcept override;
+
+#if !defined(_WIN32)
+    /// <inheritdoc />
+    int descriptor(void) const noexcept override;
+#endif /* !defined(_WIN32) */
+
+    /// <inheritdoc />
+    bool is_event_driven(void) const noexcept override;
+
+    /// <inheritdoc />
+    bool is_open(void) const noexcept override;
+
+    /// <inheritdoc />
+    bool is_preloaded(void) const noexcept override;
+
+    /// <summary>
+    /// Creates the capture file at <paramref name="path" />.
+    /// </summary>
+    /// <param name="path">The path of the capture file, which will be
+    /// overwritten if it exists.</param>
+    /// <returns><c>S_OK</c> in case of success, an error code otherwise.
+    /// </returns>
+    HRESULT open(_In_z_ const benchlab_char *path) noexcept;
+
+    /// <inheritdoc />
+    HRESULT read(_Out_writes_bytes_(cnt) void *dst,
+        _Inout_ std::size_t& cnt) noexcept override;
+
+    /// <inheritdoc />
+    HRESULT wait(_In_ const clock_type::time_point deadline) noexcept override;
+
+    /// <inheritdoc />
+    HRESULT write(_In_reads_bytes_(cnt) const void *data,
+        _In_ const std::size_t cnt) noexcept override;
+
+private:
+
+    /// <summary>
+    /// Appends the given data to the capture file.
+    /// </summary>
+    void record(_In_ const capture_direction direction,
+        _In_reads_bytes_(cnt) const void *data,
+        _In_ std::size_t cnt) noexcept;
+
+    /// <summary>
+    /// Writes a single record with the given header fields and payload to
+    /// the capture file, which must be locked by the caller.
+    /// </summary>
+    void write_record(_In_ const capture_direction direction,
+        _In_ const std::uint32_t delta,
+        _In_reads_bytes_opt_(size) const char *data,
+        _In_ const std::uint16_t size) noexcept;
+
+    std::ofstream _file;
+    clock_type::time_point _last;
+    std::mutex _lock;
+    std::unique_ptr<benchlab_transport> _transport;
+};
+
+#endif /* !defined(_BENCHLAB_CAPTURE_TRANSPORT_H) */
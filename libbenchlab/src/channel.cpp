@@ -0,0 +1,140 @@
+﻿// <copyright file="channel.cpp" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#include "libbenchlab/channel.h"
+
+#include "libbenchlab/channel_descriptors.h"
+
+#include "channel_selection.h"
+#include "debug.h"
+
+
+/*
+ * ::benchlab_count_channels
+ */
+HRESULT LIBBENCHLAB_API benchlab_count_channels(
+        _Out_ size_t *out_cnt,
+        _In_ const benchlab_channel_mask *mask) {
+    if (out_cnt == nullptr) {
+        _benchlab_debug("The output parameter is an invalid pointer.\r\n");
+        return E_POINTER;
+    }
+    if (mask == nullptr) {
+        _benchlab_debug("The channel mask is an invalid pointer.\r\n");
+        return E_POINTER;
+    }
+
+    *out_cnt = 0;
+    for (std::size_t i = 0; i < BENCHLAB_CHANNELS; ++i) {
+        if (channel_selection::is_selected(*mask, i)) {
+            ++*out_cnt;
+        }
+    }
+
+    return S_OK;
+}
+
+
+/*
+ * ::benchlab_get_channel_descriptor
+ */
+HRESULT LIBBENCHLAB_API benchlab_get_channel_descriptor(
+        _Out_ benchlab_channel_descriptor *out_descriptor,
+        _In_ const size_t index) {
+    if (out_descriptor == nullptr) {
+        _benchlab_debug("The output parameter is an invalid pointer.\r\n");
+        return E_POINTER;
+    }
+    if (index >= BENCHLAB_CHANNELS) {
+        _benchlab_debug("The channel index is out of range.\r\n");
+        return E_INVALIDARG;
+    }
+
+    *out_descriptor = visus::benchlab::channel_descriptors[index];
+    return S_OK;
+}
+
+
+/*
+ * ::benchlab_readings_to_compact
+ */
+HRESULT LIBBENCHLAB_API benchlab_readings_to_compact(
+        _Out_writes_to_opt_(*cnt, *cnt) float *out_values,
+        _Inout_ size_t *cnt,
+        _In_ const benchlab_sensor_readings *readings,
+        _In_ const benchlab_channel_mask *mask) {
+    if (cnt == nullptr) {
+        _benchlab_debug("The size parameter is an invalid pointer.\r\n");
+        return E_POINTER;
+    }
+    if ((*cnt > 0) && (out_values == nullptr)) {
+        _benchlab_debug("The output buffer is an invalid pointer.\r\n");
+        return E_POINTER;
+    }
+    if (readings == nullptr) {
+        _benchlab_debug("The input data are an invalid pointer.\r\n");
+        return E_POINTER;
+    }
+    if (mask == nullptr) {
+        _benchlab_debug("The channel mask is an invalid pointer.\r\n");
+        return E_POINTER;
+    }
+
+    const channel_selection selection(*mask);
+
+    if (*cnt < selection.size()) {
+        *cnt = selection.size();
+        return HRESULT_FROM_WIN32(ERROR_INSUFFICIENT_BUFFER);
+    }
+
+    *cnt = selection.extract(out_values, *readings);
+    return S_OK;
+}
+
+
+/*
+ * ::benchlab_select_all_channels
+ */
+HRESULT LIBBENCHLAB_API benchlab_select_all_channels(
+        _Out_ benchlab_channel_mask *mask) {
+    if (mask == nullptr) {
+        _benchlab_debug("The channel mask is an invalid pointer.\r\n");
+        return E_POINTER;
+    }
+
+    for (auto& b : mask->bits) {
+        b = 0;
+    }
+
+    for (std::size_t i = 0; i < BENCHLAB_CHANNELS; ++i) {
+        mask->bits[i / 64] |= static_cast<std::uint64_t>(1) << (i % 64);
+    }
+
+    return S_OK;
+}
+
+
+/*
+ * ::benchlab_select_channel
+ */
+HRESULT LIBBENCHLAB_API benchlab_select_channel(
+        _Inout_ benchlab_channel_mask *mask,
+        _In_ const benchlab_channel channel,
+        _In_ const size_t sensor) {
+    if (mask == nullptr) {
+        _benchlab_debug("The channel mask is an invalid pointer.\r\n");
+        return E_POINTER;
+    }
+
+    std::size_t i = 0;
+    if (!channel_selection::index(i, channel, sensor)) {
+        _benchlab_debug("The requested sensor does not exist.\r\n");
+        return E_INVALIDARG;
+    }
+
+    mask->bits[i / 64] |= static_cast<std::uint64_t>(1) << (i % 64);
+    return S_OK;
+}
@@ -0,0 +1,91 @@
+﻿// <copyright file="channel_kernels.h" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#if !defined(_BENCHLAB_CHANNEL_KERNELS_H)
+#define _BENCHLAB_CHANNEL_KERNELS_H
+#pragma once
+
+#include <array>
+#include <cinttypes>
+#include <cstddef>
+#include <utility>
+
+#include "libbenchlab/channel_descriptors.h"
+#include "libbenchlab/conversion.h"
+#include "libbenchlab/types.h"
+
+
+// The kernels converting individual channels are part of the public
+// header-only API, which guarantees that inline conversions by the callers
+// yield the same results as the library.
+using visus::benchlab::detail::channel_value;
+using visus::benchlab::detail::convert_channel;
+using visus::benchlab::detail::convert_channels;
+
+
+/// <summary>
+/// The type of a function extracting a single channel as float.
+/// </summary>
+typedef float (*channel_extractor)(const benchlab_sensor_readings&);
+
+/// <summary>
+/// The type of a function converting a single channel into a sample.
+/// </summary>
+typedef void (*channel_converter)(benchlab_sample&,
+    const benchlab_sensor_readings&);
+
+
+/// <summary>
+/// Creates a table of <see cref="channel_value" /> for all channels.
+/// </summary>
+template<std::size_t... Channels>
+constexpr std::array<channel_extractor, sizeof...(Channels)>
+make_channel_extractors(std::index_sequence<Channels...>) noexcept {
+    return { { &channel_value<Channels>... } };
+}
+
+
+/// <summary>
+/// Creates a table of <see cref="convert_channel" /> for all channels.
+/// </summary>
+template<std::size_t... Channels>
+constexpr std::array<channel_converter, sizeof...(Channels)>
+make_channel_converters(std::index_sequence<Channels...>) noexcept {
+    return { { &convert_channel<Channels>... } };
+}
+
+
+/// <summary>
+/// Answer whether the channels in the range [<paramref name="first" />,
+/// <paramref name="last" />[ are converted alike, which is a prerequisite
+/// for vectorising their conversion.
+/// </summary>
+constexpr bool is_uniform_channel_range(_In_ const std::size_t first,
+        _In_ const std::size_t last) noexcept {
+    auto& f = visus::benchlab::channel_descriptors[first];
+    for (std::size_t i = first; i < last; ++i) {
+        auto& d = visus::benchlab::channel_descriptors[i];
+        if ((d.raw_type != f.raw_type)
+                || (d.divisor != f.divisor)
+                || (d.has_invalid_value != f.has_invalid_value)
+                || (d.invalid_value != f.invalid_value)
+                || (d.sample_type != f.sample_type)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+/// <summary>
+/// Answer the number of the first channel of <paramref name="channel" />.
+/// </summary>
+constexpr std::size_t channel_index(
+        _In_ const benchlab_channel channel) noexcept {
+    return static_cast<std::size_t>(channel);
+}
+
+#endif /* !defined(_BENCHLAB_CHANNEL_KERNELS_H) */
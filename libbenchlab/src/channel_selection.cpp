@@ -0,0 +1,102 @@
+﻿// <copyright file="channel_selection.cpp" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#include "channel_selection.h"
+
+#include <cassert>
+#include <cstring>
+
+#include "channel_kernels.h"
+#include "sample_conversion.h"
+
+
+/// <summary>
+/// The routines extracting the individual channels as float.
+/// </summary>
+static constexpr auto channel_extractors = make_channel_extractors(
+    std::make_index_sequence<BENCHLAB_CHANNELS>());
+
+/// <summary>
+/// The routines converting the individual channels into a sample.
+/// </summary>
+static constexpr auto channel_converters = make_channel_converters(
+    std::make_index_sequence<BENCHLAB_CHANNELS>());
+
+
+/*
+ * channel_selection::index
+ */
+bool channel_selection::index(_Out_ std::size_t& dst,
+        _In_ const benchlab_channel channel,
+        _In_ const std::size_t sensor) noexcept {
+    using visus::benchlab::channel_descriptors;
+    dst = static_cast<std::size_t>(channel) + sensor;
+
+    // The channel must designate the first sensor of a group, and the
+    // sensor must be within that group.
+    return (sensor < BENCHLAB_CHANNELS)
+        && (dst < BENCHLAB_CHANNELS)
+        && (channel_descriptors[static_cast<std::size_t>(channel)].sensor == 0)
+        && (channel_descriptors[dst].channel == channel);
+}
+
+
+/*
+ * channel_selection::channel_selection
+ */
+channel_selection::channel_selection(void) noexcept
+        : _count(BENCHLAB_CHANNELS) {
+    for (std::size_t i = 0; i < this->_count; ++i) {
+        this->_channels[i] = static_cast<std::uint8_t>(i);
+    }
+}
+
+
+/*
+ * channel_selection::channel_selection
+ */
+channel_selection::channel_selection(
+        _In_ const benchlab_channel_mask& mask) noexcept : _count(0) {
+    for (std::size_t i = 0; i < BENCHLAB_CHANNELS; ++i) {
+        if (is_selected(mask, i)) {
+            this->_channels[this->_count++] = static_cast<std::uint8_t>(i);
+        }
+    }
+}
+
+
+/*
+ * channel_selection::convert
+ */
+void channel_selection::convert(_Out_ benchlab_sample& dst,
+        _In_ const benchlab_sensor_readings& src,
+        _In_ const benchlab_timestamp timestamp) const noexcept {
+    if (this->all()) {
+        convert_readings(&dst, &src, 1, nullptr, timestamp);
+        return;
+    }
+
+    std::memset(&dst, 0, sizeof(dst));
+    dst.timestamp = timestamp;
+
+    for (std::size_t i = 0; i < this->_count; ++i) {
+        channel_converters[this->_channels[i]](dst, src);
+    }
+}
+
+
+/*
+ * channel_selection::extract
+ */
+std::size_t channel_selection::extract(_Out_ float *dst,
+        _In_ const benchlab_sensor_readings& src) const noexcept {
+    assert(dst != nullptr);
+    for (std::size_t i = 0; i < this->_count; ++i) {
+        dst[i] = channel_extractors[this->_channels[i]](src);
+    }
+
+    return this->_count;
+}
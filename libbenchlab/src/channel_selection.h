@@ -0,0 +1,112 @@
+﻿// <copyright file="channel_selection.h" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#if !defined(_BENCHLAB_CHANNEL_SELECTION_H)
+#define _BENCHLAB_CHANNEL_SELECTION_H
+#pragma once
+
+#include <array>
+#include <cinttypes>
+#include <cstddef>
+
+#include "libbenchlab/api.h"
+#include "libbenchlab/channel.h"
+#include "libbenchlab/types.h"
+
+
+/// <summary>
+/// Converts only the channels selected in a
+/// <see cref="benchlab_channel_mask" />.
+/// </summary>
+/// <remarks>
+/// The selection translates the mask into a list of channels when it is
+/// created, such that the conversion of a sample only costs as much as the
+/// number of channels selected. Each channel is converted by a routine that
+/// has been generated from its descriptor at compile time.
+/// </remarks>
+class LIBBENCHLAB_TEST_API channel_selection final {
+
+public:
+
+    /// <summary>
+    /// Determines the index of the given <paramref name="sensor" /> of
+    /// <paramref name="channel" />.
+    /// </summary>
+    /// <param name="dst">Receives the index of the channel in a
+    /// <see cref="benchlab_channel_mask" />.</param>
+    /// <param name="channel">The channel to look up.</param>
+    /// <param name="sensor">The zero-based index of the sensor within the
+    /// <paramref name="channel" />.</param>
+    /// <returns><c>true</c> if the sensor exists, <c>false</c> otherwise.
+    /// </returns>
+    static bool index(_Out_ std::size_t& dst,
+        _In_ const benchlab_channel channel,
+        _In_ const std::size_t sensor) noexcept;
+
+    /// <summary>
+    /// Answer whether the channel with the given <paramref name="index" /> is
+    /// selected in <paramref name="mask" />.
+    /// </summary>
+    static inline bool is_selected(_In_ const benchlab_channel_mask& mask,
+            _In_ const std::size_t index) noexcept {
+        return ((mask.bits[index / 64] >> (index % 64)) & 1) != 0;
+    }
+
+    /// <summary>
+    /// Initialises a new instance selecting all channels.
+    /// </summary>
+    channel_selection(void) noexcept;
+
+    /// <summary>
+    /// Initialises a new instance selecting the channels in
+    /// <paramref name="mask" />.
+    /// </summary>
+    explicit channel_selection(
+        _In_ const benchlab_channel_mask& mask) noexcept;
+
+    /// <summary>
+    /// Answer whether all channels are selected.
+    /// </summary>
+    inline bool all(void) const noexcept {
+        return (this->_count == BENCHLAB_CHANNELS);
+    }
+
+    /// <summary>
+    /// Converts the selected channels of <paramref name="src" /> into
+    /// <paramref name="dst" /> and sets all other channels to zero.
+    /// </summary>
+    /// <remarks>
+    /// If all channels are selected, the vectorised conversion is used.
+    /// </remarks>
+    void convert(_Out_ benchlab_sample& dst,
+        _In_ const benchlab_sensor_readings& src,
+        _In_ const benchlab_timestamp timestamp) const noexcept;
+
+    /// <summary>
+    /// Writes the selected channels of <paramref name="src" /> as compact
+    /// sample to <paramref name="dst" />.
+    /// </summary>
+    /// <param name="dst">A buffer for at least <see cref="size" /> values.
+    /// </param>
+    /// <param name="src">The readings to be converted.</param>
+    /// <returns>The number of values written.</returns>
+    std::size_t extract(_Out_ float *dst,
+        _In_ const benchlab_sensor_readings& src) const noexcept;
+
+    /// <summary>
+    /// Answer the number of channels selected.
+    /// </summary>
+    inline std::size_t size(void) const noexcept {
+        return this->_count;
+    }
+
+private:
+
+    std::size_t _count;
+    std::array<std::uint8_t, BENCHLAB_CHANNELS> _channels;
+};
+
+#endif /* !defined(_BENCHLAB_CHANNEL_SELECTION_H) */
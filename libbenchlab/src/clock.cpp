@@ -0,0 +1,81 @@
+﻿// <copyright file="clock.cpp" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#include "libbenchlab/clock.h"
+
+#include <cmath>
+
+#include "debug.h"
+#include "sample_clock.h"
+
+
+/*
+ * ::benchlab_clock_to_wall_time
+ */
+HRESULT LIBBENCHLAB_API benchlab_clock_to_wall_time(
+        _Out_ benchlab_timestamp *out_wall_time,
+        _In_ const benchlab_timestamp timestamp,
+        _In_ const benchlab_clock_correlation *correlation) {
+    if (out_wall_time == nullptr) {
+        _benchlab_debug("The output parameter is an invalid pointer.\r\n");
+        return E_POINTER;
+    }
+    if (correlation == nullptr) {
+        _benchlab_debug("The clock correlation is an invalid pointer.\r\n");
+        return E_POINTER;
+    }
+    if (!(correlation->frequency > 0.0)) {
+        _benchlab_debug("The frequency of the clock must be positive.\r\n");
+        return E_INVALIDARG;
+    }
+
+    // Only the difference is scaled, which is small enough to be exact in a
+    // double for any reasonable distance from the reference.
+    const auto dt = static_cast<double>(timestamp - correlation->reference)
+        * 10000000.0 / correlation->frequency;
+    *out_wall_time = correlation->wall_time
+        + static_cast<benchlab_timestamp>(std::llround(dt));
+
+    return S_OK;
+}
+
+
+/*
+ * ::benchlab_correlate_clock
+ */
+HRESULT LIBBENCHLAB_API benchlab_correlate_clock(
+        _Out_ benchlab_clock_correlation *out_correlation,
+        _In_ const benchlab_clock clock) {
+    if (out_correlation == nullptr) {
+        _benchlab_debug("The output parameter is an invalid pointer.\r\n");
+        return E_POINTER;
+    }
+
+    return sample_clock::correlate(*out_correlation, clock);
+}
+
+
+/*
+ * ::benchlab_read_clock
+ */
+HRESULT LIBBENCHLAB_API benchlab_read_clock(
+        _Out_ benchlab_timestamp *out_timestamp,
+        _In_ const benchlab_clock clock) {
+    if (out_timestamp == nullptr) {
+        _benchlab_debug("The output parameter is an invalid pointer.\r\n");
+        return E_POINTER;
+    }
+
+    {
+        auto hr = sample_clock::check(clock);
+        if (FAILED(hr)) {
+            return hr;
+        }
+    }
+
+    *out_timestamp = sample_clock::read(clock);
+    return S_OK;
+}
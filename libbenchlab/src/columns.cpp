@@ -0,0 +1,162 @@
+﻿// <copyright file="columns.cpp" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#include "libbenchlab/columns.h"
+
+#include <algorithm>
+#include <array>
+
+#include "libbenchlab/benchlab.h"
+
+#include "debug.h"
+#include "sample_columns.h"
+#include "sample_conversion.h"
+#include "sensor_frame.h"
+
+
+/*
+ * ::benchlab_append_frames
+ */
+HRESULT LIBBENCHLAB_API benchlab_append_frames(
+        _In_ benchlab_sample_columns *columns,
+        _In_reads_bytes_(cnt * BENCHLAB_SENSOR_FRAME_SIZE) const void *frames,
+        _In_ const size_t cnt,
+        _In_reads_opt_(cnt) const benchlab_timestamp *timestamps) {
+    if (columns == nullptr) {
+        _benchlab_debug("The columnar batch is an invalid pointer.\r\n");
+        return E_POINTER;
+    }
+    if ((frames == nullptr) && (cnt > 0)) {
+        _benchlab_debug("The input data are an invalid pointer.\r\n");
+        return E_POINTER;
+    }
+    if (columns->capacity - columns->count < cnt) {
+        _benchlab_debug("The columnar batch is too small.\r\n");
+        return HRESULT_FROM_WIN32(ERROR_INSUFFICIENT_BUFFER);
+    }
+
+    const auto now = (timestamps == nullptr)
+        ? ::benchlab_make_timestamp()
+        : 0;
+
+    auto dst = static_cast<sample_columns *>(columns);
+    auto src = static_cast<const std::uint8_t *>(frames);
+    std::array<benchlab_sample, 32> samples;
+    for (std::size_t i = 0; i < cnt; i += samples.size()) {
+        const auto n = (std::min)(samples.size(), cnt - i);
+        sensor_frame::decode(samples.data(), src + i * sensor_frame::size, n,
+            (timestamps != nullptr) ? timestamps + i : nullptr, now);
+        dst->append(samples.data(), n);
+    }
+
+    return S_OK;
+}
+
+
+/*
+ * ::benchlab_append_readings
+ */
+HRESULT LIBBENCHLAB_API benchlab_append_readings(
+        _In_ benchlab_sample_columns *columns,
+        _In_reads_(cnt) const benchlab_sensor_readings *readings,
+        _In_ const size_t cnt,
+        _In_reads_opt_(cnt) const benchlab_timestamp *timestamps) {
+    if (columns == nullptr) {
+        _benchlab_debug("The columnar batch is an invalid pointer.\r\n");
+        return E_POINTER;
+    }
+    if ((readings == nullptr) && (cnt > 0)) {
+        _benchlab_debug("The input data are an invalid pointer.\r\n");
+        return E_POINTER;
+    }
+    if (columns->capacity - columns->count < cnt) {
+        _benchlab_debug("The columnar batch is too small.\r\n");
+        return HRESULT_FROM_WIN32(ERROR_INSUFFICIENT_BUFFER);
+    }
+
+    const auto now = (timestamps == nullptr)
+        ? ::benchlab_make_timestamp()
+        : 0;
+
+    // The readings are converted in chunks that stay in the cache before
+    // they are distributed to the columns.
+    auto dst = static_cast<sample_columns *>(columns);
+    std::array<benchlab_sample, 32> samples;
+    for (std::size_t i = 0; i < cnt; i += samples.size()) {
+        const auto n = (std::min)(samples.size(), cnt - i);
+        convert_readings(samples.data(), readings + i, n,
+            (timestamps != nullptr) ? timestamps + i : nullptr, now);
+        dst->append(samples.data(), n);
+    }
+
+    return S_OK;
+}
+
+
+/*
+ * ::benchlab_append_samples
+ */
+HRESULT LIBBENCHLAB_API benchlab_append_samples(
+        _In_ benchlab_sample_columns *columns,
+        _In_reads_(cnt) const benchlab_sample *samples,
+        _In_ const size_t cnt) {
+    if (columns == nullptr) {
+        _benchlab_debug("The columnar batch is an invalid pointer.\r\n");
+        return E_POINTER;
+    }
+    if ((samples == nullptr) && (cnt > 0)) {
+        _benchlab_debug("The input data are an invalid pointer.\r\n");
+        return E_POINTER;
+    }
+    if (columns->capacity - columns->count < cnt) {
+        _benchlab_debug("The columnar batch is too small.\r\n");
+        return HRESULT_FROM_WIN32(ERROR_INSUFFICIENT_BUFFER);
+    }
+
+    static_cast<sample_columns *>(columns)->append(samples, cnt);
+    return S_OK;
+}
+
+
+/*
+ * ::benchlab_create_sample_columns
+ */
+HRESULT LIBBENCHLAB_API benchlab_create_sample_columns(
+        _Out_ benchlab_sample_columns **out_columns,
+        _In_ const size_t capacity) {
+    if (out_columns == nullptr) {
+        _benchlab_debug("Invalid storage location for columnar batch "
+            "provided.\r\n");
+        return E_POINTER;
+    }
+
+    *out_columns = nullptr;
+
+    if (capacity == 0) {
+        _benchlab_debug("The capacity of a columnar batch must be "
+            "positive.\r\n");
+        return E_INVALIDARG;
+    }
+
+    auto columns = sample_columns::create(capacity);
+    if (columns == nullptr) {
+        _benchlab_debug("Insufficient memory for columnar batch.\r\n");
+        return E_OUTOFMEMORY;
+    }
+
+    *out_columns = columns.release();
+    return S_OK;
+}
+
+
+/*
+ * ::benchlab_destroy_sample_columns
+ */
+HRESULT LIBBENCHLAB_API benchlab_destroy_sample_columns(
+        _In_opt_ benchlab_sample_columns *columns) {
+    delete static_cast<sample_columns *>(columns);
+    return S_OK;
+}
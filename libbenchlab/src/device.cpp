@@ -8,15 +8,15 @@
 
 #include <algorithm>
 #include <cerrno>
+#include <cstdlib>
 #include <cstring>
+#include <fstream>
 #include <limits>
 
-#if !defined(_WIN32)
-#include <unistd.h>
-#endif /* defined(_WIN32) */
-
 #include "libbenchlab/benchlab.h"
 
+#include "benchlab_reactor.h"
+#include "capture_transport.h"
 #include "debug.h"
 
 
@@ -25,7 +25,10 @@
  */
 benchlab_device::benchlab_device(void) noexcept
         : _command_sleep(10),
-        _handle(invalid_handle),
+        _loop(nullptr),
+        _model(&supported_device_models::latest()),
+        _processing(false),
+        _response_latency(0),
         _state(stream_state::stopped),
         _timeout(0),
         _version(0) { }
@@ -35,14 +38,29 @@ benchlab_device::benchlab_device(void) noexcept
  * benchlab_device::~benchlab_device
  */
 benchlab_device::~benchlab_device(void) noexcept {
-    this->close();
-    // Note: closing the handle will cause the thread to exit with an I/O error,
-    // so we do not need to set the state here (it cannot be used anyway,
-    // because we are about to destroy the variable).
+    // Neither the streaming thread nor a reactor notices the transport being
+    // closed while they are waiting for input, and they must not use the
+    // transport anymore once we started destroying it, so we need to stop
+    // them first. The same applies to an external event loop, which might
+    // have a response outstanding. A thread that is still starting cannot be
+    // stopped yet, so we need to wait until it signalled that it is running.
+    auto state = this->_state.load(std::memory_order::memory_order_acquire);
+    while (state == stream_state::starting) {
+        std::this_thread::yield();
+        state = this->_state.load(std::memory_order::memory_order_acquire);
+    }
+
+    if (state == stream_state::running) {
+        this->stop();
+    }
 
+    // The thread might have exited on its own, e.g. due to an I/O error, in
+    // which case it has not been joined yet.
     if (this->_thread.joinable()) {
         this->_thread.join();
     }
+
+    this->close();
 }
 
 
@@ -50,19 +68,29 @@ benchlab_device::~benchlab_device(void) noexcept {
  * benchlab_device::close
  */
 HRESULT benchlab_device::close(void) noexcept {
-#if defined(_WIN32)
-    auto retval = ::CloseHandle(this->_handle)
-        ? S_OK
-        : HRESULT_FROM_WIN32(::GetLastError());
-#else /* defined(_WIN32) */
-    auto retval = (::close(this->_handle) == 0)
-        ? S_OK
-        : static_cast<HRESULT>(-errno);
-#endif /* defined(_WIN32) */
+    return (this->_transport != nullptr)
+        ? this->_transport->close()
+        : S_OK;
+}
 
-    this->_handle = invalid_handle;
-    return retval;
+
+#if !defined(_WIN32)
+/*
+ * benchlab_device::descriptor
+ */
+HRESULT benchlab_device::descriptor(_Out_ int& descriptor) const noexcept {
+    descriptor = -1;
+
+    if (this->_external == nullptr) {
+        _benchlab_debug("The device is not streaming via an external event "
+            "loop.\r\n");
+        return E_NOT_VALID_STATE;
+    }
+
+    descriptor = this->_external->descriptor();
+    return (descriptor != -1) ? S_OK : E_NOTIMPL;
 }
+#endif /* !defined(_WIN32) */
 
 
 /*
@@ -125,6 +153,67 @@ HRESULT benchlab_device::name(_In_ const std::string& name) noexcept {
 }
 
 
+#if !defined(_WIN32)
+/*
+ * benchlab_device::is_benchlab_tty
+ */
+bool benchlab_device::is_benchlab_tty(_In_ const std::string& path) {
+    std::unique_ptr<char, decltype(&::free)> device(
+        ::realpath(combine_path(path, "device").c_str(), nullptr),
+        &::free);
+    if (device == nullptr) {
+        // Virtual terminals and the like have no device at all.
+        return false;
+    }
+
+    // The device of a CDC ACM port is the USB interface, whereas USB-to-serial
+    // converters have an additional node for the port. The IDs are stored in
+    // the USB device above.
+    std::string cur(device.get());
+    for (int i = 0; (i < 3) && !cur.empty(); ++i) {
+        std::ifstream vendor(combine_path(cur, "idVendor"));
+        if (vendor.is_open()) {
+            std::ifstream product(combine_path(cur, "idProduct"));
+            unsigned int vid = 0, pid = 0;
+            vendor >> std::hex >> vid;
+            product >> std::hex >> pid;
+            return (vid == benchlab_vendor_id) && (pid == benchlab_product_id);
+        }
+
+        cur.erase(cur.find_last_of('/'));
+    }
+
+    return false;
+}
+#endif /* !defined(_WIN32) */
+
+
+/*
+ * benchlab_device::next_wakeup
+ */
+HRESULT benchlab_device::next_wakeup(
+        _Out_ std::chrono::microseconds& timeout) const noexcept {
+    using namespace std::chrono;
+
+    if (this->_external == nullptr) {
+        _benchlab_debug("The device is not streaming via an external event "
+            "loop.\r\n");
+        timeout = microseconds::zero();
+        return E_NOT_VALID_STATE;
+    }
+
+    // Round up such that the caller does not wake up before the deadline,
+    // which would only make it wait once more.
+    const auto wakeup = this->_external->next_wakeup();
+    const auto now = acquisition::clock_type::now();
+    timeout = (wakeup > now)
+        ? ceil<microseconds>(wakeup - now)
+        : microseconds::zero();
+
+    return S_OK;
+}
+
+
 /*
  * benchlab_device::open
  */
@@ -133,101 +222,71 @@ HRESULT benchlab_device::open(_In_z_ const benchlab_char *com_port,
     assert(com_port != nullptr);
     assert(config != nullptr);
 
-    if (this->_handle != invalid_handle) {
+    if (SUCCEEDED(this->check_handle())) {
         _benchlab_debug("Tried opening a benchlab_device that is already "
             "connected...\r\n");
         return E_NOT_VALID_STATE;
     }
 
-    this->_command_sleep = std::chrono::microseconds(config->command_sleep);
-    this->_timeout = std::chrono::milliseconds(config->read_timeout);
-
-#if defined(_WIN32)
-    this->_handle = ::CreateFileW(com_port, GENERIC_READ | GENERIC_WRITE, 0,
-        nullptr, OPEN_EXISTING, 0, NULL);
-    if (this->_handle == invalid_handle) {
-        auto retval = HRESULT_FROM_WIN32(::GetLastError());
-        _benchlab_debug("CreateFile on COM port failed.\r\n");
-        return retval;
-    }
-
+    std::unique_ptr<benchlab_transport> transport;
     {
-        DCB dcb { 0 };
-        dcb.DCBlength = sizeof(dcb);
-
-        if (!::GetCommState(this->_handle, &dcb)) {
-            auto retval = HRESULT_FROM_WIN32(::GetLastError());
-            _benchlab_debug("Retrieving state of COM port failed.\r\n");
-            return retval;
+        auto hr = benchlab_transport::create(transport, com_port, config);
+        if (FAILED(hr)) {
+            return hr;
         }
+    }
 
-        dcb.BaudRate = static_cast<DWORD>(config->baud_rate);
-        dcb.ByteSize = static_cast<BYTE>(config->data_bits);
-        dcb.Parity = static_cast<BYTE>(config->parity);
-        dcb.StopBits = static_cast<BYTE>(config->stop_bits);
-
-        // Like in the .NET framework, mak the handshake stuff to DCB. Cf.
-        // https://github.com/dotnet/runtime/blob/9d5a6a9aa463d6d10b0b0ba6d5982cc82f363dc3/src/libraries/System.IO.Ports/src/System/IO/Ports/SerialStream.Windows.cs#L191-L235
-        const auto rts = (config->handshake
-            == benchlab_handshake::request_to_send);
-        const auto rts_xon_xoff = (config->handshake
-            == benchlab_handshake::request_to_send_xon_xoff);
-        const auto xon_xoff = (config->handshake
-            == benchlab_handshake::xon_xoff);
+    return this->open(std::move(transport), config);
+}
 
-        dcb.fInX = dcb.fOutX = (xon_xoff || rts_xon_xoff) ? 1 : 0;
-        dcb.fOutxCtsFlow = (rts || rts_xon_xoff) ? 1 : 0;
 
-        if (rts || rts_xon_xoff) {
-            dcb.fRtsControl = RTS_CONTROL_HANDSHAKE;
-        //} else if (_rtsEnable) {
-        //    SetDcbFlag(Interop.Kernel32.DCBFlags.FRTSCONTROL, Interop.Kernel32.DCBRTSFlowControl.RTS_CONTROL_ENABLE);
-        } else {
-            dcb.fRtsControl = RTS_CONTROL_DISABLE;
-        }
+/*
+ * benchlab_device::open
+ */
+HRESULT benchlab_device::open(
+        _Inout_ std::unique_ptr<benchlab_transport>&& transport,
+        _In_ const benchlab_serial_configuration *config) noexcept {
+    assert(transport != nullptr);
+    assert(config != nullptr);
 
-        if (!::SetCommState(this->_handle, &dcb)) {
-            auto retval = HRESULT_FROM_WIN32(::GetLastError());
-            _benchlab_debug("Updating state of COM port failed.\r\n");
-            return retval;
-        }
+    if (SUCCEEDED(this->check_handle())) {
+        _benchlab_debug("Tried opening a benchlab_device that is already "
+            "connected...\r\n");
+        return E_NOT_VALID_STATE;
     }
 
-    {
-        COMMTIMEOUTS cto { 0 };
-        constexpr auto infinite = (std::numeric_limits<std::uint32_t>::max)();
-        // Cf. https://github.com/dotnet/runtime/blob/9d5a6a9aa463d6d10b0b0ba6d5982cc82f363dc3/src/libraries/System.IO.Ports/src/System/IO/Ports/SerialStream.Windows.cs#L363-L364
-        constexpr auto infinite_magic = -2;
-
-        if (config->read_timeout == 0) {
-            cto.ReadTotalTimeoutConstant = 0;
-            cto.ReadTotalTimeoutMultiplier = 0;
-            cto.ReadIntervalTimeout = MAXDWORD;
+    // Note: the calibration-related members are only present from version 2
+    // of the configuration on.
+    const auto calibrate = (config->version >= 2)
+        && config->calibrate_command_sleep;
 
-        } else if (config->read_timeout == infinite) {
-            cto.ReadTotalTimeoutConstant = infinite_magic;
-            cto.ReadTotalTimeoutMultiplier = 0;
-            cto.ReadIntervalTimeout = MAXDWORD;
+    // If we calibrate the sleep, we measure without any sleep. Reading works
+    // without it, but we might need to retry if the first byte is missing.
+    this->_command_sleep = calibrate
+        ? std::chrono::microseconds::zero()
+        : std::chrono::microseconds(config->command_sleep);
+    this->_timeout = std::chrono::milliseconds(config->read_timeout);
 
-        } else {
-            cto.ReadTotalTimeoutConstant = config->read_timeout;
-            cto.ReadTotalTimeoutMultiplier = MAXDWORD;
-            cto.ReadIntervalTimeout = MAXDWORD;
+    // Note: the capture is only available from version 3 of the configuration
+    // on. It must be started before the welcome check to be replayable.
+    if ((config->version >= 3) && (config->capture_path != nullptr)) {
+        std::unique_ptr<capture_transport> capture(
+            new (std::nothrow) capture_transport(std::move(transport)));
+        if (capture == nullptr) {
+            _benchlab_debug("Insufficient memory for capture.\r\n");
+            return E_OUTOFMEMORY;
         }
 
-        cto.WriteTotalTimeoutConstant = config->write_timeout;
-        if (cto.WriteTotalTimeoutConstant == infinite) {
-            cto.WriteTotalTimeoutConstant = 0;
+        auto hr = capture->open(config->capture_path);
+        if (FAILED(hr)) {
+            capture->close();
+            return hr;
         }
 
-        if (!::SetCommTimeouts(this->_handle, &cto)) {
-            _benchlab_debug("Setting COM timeouts failed.\r\n");
-            return HRESULT_FROM_WIN32(::GetLastError());
-        }
+        transport = std::move(capture);
     }
-#else /* defined(_WIN32) */
-#error "TODO";
-#endif /* defined(_WIN32) */
+
+    this->_transport = std::move(transport);
 
     {
         auto hr = this->check_welcome();
@@ -238,8 +297,12 @@ HRESULT benchlab_device::open(_In_z_ const benchlab_char *com_port,
         }
     }
 
+    // Retrieve the vendor data. We time this in any case to obtain an estimate
+    // of the response latency. If requested, we measure over multiple round
+    // trips to derive the command sleep from it.
     {
-        auto hr = this->check_vendor_data();
+        const auto rounds = calibrate ? config->calibration_rounds : 1;
+        auto hr = this->calibrate(rounds, calibrate);
         if (FAILED(hr)) {
             _benchlab_debug("Retrieval of basic hardware information "
                 "failed.\r\n");
@@ -252,6 +315,75 @@ HRESULT benchlab_device::open(_In_z_ const benchlab_char *com_port,
 }
 
 
+/*
+ * benchlab_device::process
+ */
+HRESULT benchlab_device::process(void) noexcept {
+    if (this->_external == nullptr) {
+        _benchlab_debug("The device is not streaming via an external event "
+            "loop.\r\n");
+        return E_NOT_VALID_STATE;
+    }
+
+    this->_processing = true;
+    auto retval = this->_external->process(acquisition::clock_type::now());
+    this->_processing = false;
+
+    // If streaming stopped on its own, the device becomes usable for
+    // synchronous requests again.
+    if (this->_external->finished()) {
+        this->_external.reset();
+        this->stopped();
+    }
+
+    return retval;
+}
+
+
+/*
+ * benchlab_device::poll
+ */
+HRESULT benchlab_device::poll(_Out_writes_to_(cnt, cnt) benchlab_sample *dst,
+        _Inout_ std::size_t& cnt,
+        _In_ const std::chrono::milliseconds timeout) noexcept {
+    assert(dst != nullptr);
+    const auto deadline = sample_ring::clock_type::now() + timeout;
+    const auto size = cnt;
+    cnt = 0;
+
+    if (this->_samples == nullptr) {
+        _benchlab_debug("The device is not streaming into a buffer.\r\n");
+        return E_NOT_VALID_STATE;
+    }
+
+    while (true) {
+        // The sequence must be obtained before anything is checked, because
+        // this is what makes sure that we do not miss a wakeup.
+        const auto sequence = this->_samples->sequence();
+
+        cnt = this->_samples->pop(dst, size);
+        if (cnt > 0) {
+            return S_OK;
+        }
+
+        // The last samples might have been added right before the buffer
+        // was closed, so we need to check again.
+        if (this->_samples->closed()) {
+            cnt = this->_samples->pop(dst, size);
+            return (cnt > 0) ? S_OK : E_NOT_VALID_STATE;
+        }
+
+        if (timeout.count() <= 0) {
+            return S_OK;
+        }
+
+        if (!this->_samples->wait(sequence, deadline)) {
+            return benchlab_transport::timeout_error();
+        }
+    }
+}
+
+
 /*
  * benchlab_device::press
  */
@@ -370,36 +502,93 @@ HRESULT benchlab_device::read(
 HRESULT benchlab_device::start(_In_ const benchlab_sample_callback callback,
         _In_opt_ void *context,
         _In_ const std::chrono::milliseconds period) noexcept {
+    benchlab_streaming_configuration config;
+    config.version = 1;
+    ::benchlab_initialise_streaming_configuration(&config);
+    config.callback = callback;
+    config.context = context;
+    config.period = static_cast<std::uint32_t>(period.count());
+    return this->start(config);
+}
+
+
+/*
+ * benchlab_device::start
+ */
+HRESULT benchlab_device::start(
+        _In_ const benchlab_streaming_configuration& config) noexcept {
+    assert(has_sink(config));
+
     {
-        // Do not start a sampler if the handle is invalid in the first place.
-        auto hr = this->check_handle();
+        auto hr = this->begin_start(config);
         if (FAILED(hr)) {
             return hr;
         }
     }
 
-    {
-        auto expected = stream_state::stopped;
-        auto succeeded = this->_state.compare_exchange_strong(expected,
-            stream_state::starting, std::memory_order::memory_order_acq_rel);
-        assert(!this->_thread.joinable() || !succeeded);
-        if (!succeeded) {
-            _benchlab_debug("The Benchlab device is already streaming data or "
-                "it is ain a transitional state.\r\n");
+    if (config.reactor != nullptr) {
+        // The reactor has no startup phase that could fail asynchronously, so
+        // we are running as soon as the device has been attached. The loop
+        // must be known before anyone can observe the running state, because
+        // stop() needs it to detach the device.
+        this->_loop = config.reactor->select();
+        if (this->_loop == nullptr) {
+            _benchlab_debug("The reactor is not running.\r\n");
+            this->stopped();
             return E_NOT_VALID_STATE;
         }
+
+        this->_state.store(stream_state::running,
+            std::memory_order::memory_order_release);
+
+        auto hr = this->_loop->attach(*this, config);
+        if (FAILED(hr)) {
+            this->_loop = nullptr;
+            this->stopped();
+        }
+
+        return hr;
     }
 
-    assert(!this->_thread.joinable());
-    this->_thread = std::thread(&benchlab_device::stream, this,
-        callback,
-        context,
-        period);
+    this->_loop = nullptr;
+    this->_thread = std::thread(&benchlab_device::stream, this, config);
 
     return S_OK;
 }
 
 
+/*
+ * benchlab_device::start_external
+ */
+HRESULT benchlab_device::start_external(
+        _In_ const benchlab_streaming_configuration& config) noexcept {
+    assert(has_sink(config));
+
+    {
+        auto hr = this->begin_start(config);
+        if (FAILED(hr)) {
+            return hr;
+        }
+    }
+
+    this->_loop = nullptr;
+    this->_external.reset(new (std::nothrow) acquisition(*this, config,
+        acquisition::clock_type::now()));
+    if (this->_external == nullptr) {
+        _benchlab_debug("Insufficient memory for the acquisition state "
+            "machine.\r\n");
+        this->stopped();
+        return E_OUTOFMEMORY;
+    }
+
+    // There is no thread that could fail during startup, so we are running
+    // right away.
+    this->_state.store(stream_state::running,
+        std::memory_order::memory_order_release);
+    return S_OK;
+}
+
+
 /*
  * benchlab_device::stop
  */
@@ -421,7 +610,37 @@ HRESULT benchlab_device::stop(void) noexcept {
     }
 
     // Our contract states that the sampler thread must not run anymore once the
-    // methods exits, so we wait for the thread to exit.
+    // methods exits, so we wait for the thread or the reactor to finish. If
+    // the caller drives the acquisition, we finish it ourselves, which might
+    // require waiting for an outstanding response.
+    if ((this->_external != nullptr) && this->_processing) {
+        // We have been called from the callback, which is invoked by
+        // process(), so we cannot finish the acquisition here, but the next
+        // call to process() will.
+        this->_external->stop();
+
+    } else if (this->_external != nullptr) {
+        this->_external->stop();
+
+        auto now = acquisition::clock_type::now();
+        while (true) {
+            this->_external->process(now);
+            if (this->_external->finished()) {
+                break;
+            }
+
+            this->wait(this->_external->next_wakeup());
+            now = acquisition::clock_type::now();
+        }
+
+        this->_external.reset();
+        this->stopped();
+    }
+
+    if (this->_loop != nullptr) {
+        this->_loop->detach(*this);
+    }
+
     if (this->_thread.joinable()) {
         this->_thread.join();
     }
@@ -496,11 +715,163 @@ HRESULT benchlab_device::write(
 }
 
 
+/*
+ * benchlab_device::calibrate
+ */
+HRESULT benchlab_device::calibrate(_In_ std::size_t rounds,
+        _In_ const bool adjust) noexcept {
+    using namespace std::chrono;
+    std::array<microseconds, max_calibration_rounds> latencies;
+    rounds = (std::max)(std::size_t(1), (std::min)(rounds, latencies.size()));
+
+    for (std::size_t i = 0; i < rounds; ++i) {
+        const auto begin = steady_clock::now();
+
+        auto hr = this->check_vendor_data();
+        if (FAILED(hr)) {
+            return hr;
+        }
+
+        latencies[i] = duration_cast<microseconds>(steady_clock::now() - begin);
+    }
+
+    // Report the median as the typical latency, which is robust against the
+    // odd scheduling hiccup while measuring.
+    const auto end = latencies.begin() + rounds;
+    std::sort(latencies.begin(), end);
+    this->_response_latency = latencies[rounds / 2];
+
+    if (adjust) {
+        // If reads block until data arrive, there is no need to wait before
+        // reading. Otherwise, the shortest latency we have observed is the
+        // longest we can wait without delaying any response, but it still
+        // saves us from reading before anything has arrived.
+        this->_command_sleep = this->event_driven_reads()
+            ? microseconds::zero()
+            : latencies.front();
+    }
+
+    return S_OK;
+}
+
+
+/*
+ * benchlab_device::begin_start
+ */
+HRESULT benchlab_device::begin_start(
+        _In_ const benchlab_streaming_configuration& config) noexcept {
+    {
+        // Do not start a sampler if the handle is invalid in the first place.
+        auto hr = this->check_handle();
+        if (FAILED(hr)) {
+            return hr;
+        }
+    }
+
+    {
+        auto expected = stream_state::stopped;
+        auto succeeded = this->_state.compare_exchange_strong(expected,
+            stream_state::starting, std::memory_order::memory_order_acq_rel);
+        assert(!this->_thread.joinable() || !succeeded);
+        if (!succeeded) {
+            _benchlab_debug("The Benchlab device is already streaming data or "
+                "it is ain a transitional state.\r\n");
+            return E_NOT_VALID_STATE;
+        }
+    }
+
+    // If the thread exited on its own due to an I/O error, it has not been
+    // joined yet. The same applies to an acquisition that the caller drove
+    // until it failed.
+    if (this->_thread.joinable()) {
+        this->_thread.join();
+    }
+
+    this->_external.reset();
+    this->_statistics.reset();
+
+    // The buffer is reused if possible, which is safe, because there is no
+    // producer at this point and the consumer must not poll while the device
+    // is being started.
+    if (config.buffer_size == 0) {
+        this->_samples.reset();
+
+    } else if ((this->_samples != nullptr)
+            && (this->_samples->capacity() >= config.buffer_size)
+            && (this->_samples->capacity() / 2 < config.buffer_size)) {
+        this->_samples->clear();
+
+    } else {
+        this->_samples = sample_ring::create(config.buffer_size);
+        if (this->_samples == nullptr) {
+            _benchlab_debug("Insufficient memory for the sample buffer.\r\n");
+            this->_state.store(stream_state::stopped,
+                std::memory_order::memory_order_release);
+            return E_OUTOFMEMORY;
+        }
+    }
+
+    {
+        auto hr = this->_batch.reset(config);
+        if (FAILED(hr)) {
+            this->_state.store(stream_state::stopped,
+                std::memory_order::memory_order_release);
+            return hr;
+        }
+    }
+
+    this->_channels = channel_selection(config.channels);
+    this->_clock = sample_clock(config.clock, config.timestamp_point);
+
+    return S_OK;
+}
+
+
+/*
+ * benchlab_device::deliver
+ */
+void benchlab_device::deliver(_In_ const benchlab_sensor_readings& readings,
+        _In_ const benchlab_timestamp timestamp,
+        _In_ const benchlab_streaming_configuration& config) noexcept {
+    if (config.readings_callback != nullptr) {
+        config.readings_callback(this, &readings, timestamp, config.context);
+    }
+
+    if (config.compact_callback != nullptr) {
+        std::array<float, BENCHLAB_CHANNELS> values;
+        const auto cnt = this->_channels.extract(values.data(), readings);
+        config.compact_callback(this, timestamp, values.data(), cnt,
+            config.context);
+    }
+
+    if ((config.callback == nullptr) && (config.batch_callback == nullptr)
+            && (this->_samples == nullptr)) {
+        return;
+    }
+
+    benchlab_sample sample;
+    this->_channels.convert(sample, readings, timestamp);
+
+    if ((this->_samples != nullptr) && !this->_samples->push(sample)) {
+        this->_statistics.overflowed();
+    }
+
+    if (config.callback != nullptr) {
+        config.callback(this, &sample, config.context);
+    }
+
+    if ((config.batch_callback != nullptr)
+            && this->_batch.add(sample, sample_batch::clock_type::now())) {
+        this->_batch.flush(this, config);
+    }
+}
+
+
 /*
  * benchlab_device::check_handle
  */
 HRESULT benchlab_device::check_handle(void) const noexcept {
-    return (this->_handle != invalid_handle)
+    return ((this->_transport != nullptr) && this->_transport->is_open())
         ? S_OK
         : HRESULT_FROM_WIN32(ERROR_INVALID_HANDLE);
 }
@@ -529,6 +900,7 @@ HRESULT benchlab_device::check_vendor_data(void) noexcept {
     }
 
     this->_version = response[2];
+    this->_model = &supported_device_models::select(this->_version);
     return S_OK;
 }
 
@@ -580,36 +952,100 @@ HRESULT benchlab_device::check_welcome(void) const noexcept {
 
 
 /*
- * benchlab_device::read
+ * benchlab_device::purge
  */
-HRESULT benchlab_device::read(_Out_writes_bytes_(cnt) void *dst,
-        _Inout_ std::size_t& cnt) const noexcept {
-    assert(dst != nullptr);
+HRESULT benchlab_device::purge(_Out_ std::size_t& discarded) const noexcept {
+    using namespace std::chrono;
+    typedef benchlab_transport::clock_type clock_type;
+    std::array<std::uint8_t, 256> buffer;
+
+    // The overall limit prevents us from hanging if the device keeps sending
+    // garbage.
+    const auto quiet = this->quiet_time();
+    const auto limit = clock_type::now() + (std::max)(this->_timeout, quiet);
+    discarded = 0;
+
+    while (clock_type::now() < limit) {
+        std::size_t cnt = 0;
+        auto hr = this->_transport->available(cnt);
+        if (FAILED(hr)) {
+            return hr;
+        }
 
-#if defined(_WIN32)
-    DWORD read;
+        if (cnt > 0) {
+            cnt = (std::min)(cnt, buffer.size());
+            hr = this->read(buffer.data(), cnt);
+            if (FAILED(hr)) {
+                return hr;
+            }
 
-    if (::ReadFile(this->_handle, dst, static_cast<DWORD>(cnt), &read,
-        nullptr)) {
-        cnt = read;
-        return S_OK;
+            discarded += cnt;
+            continue;
+        }
 
-    } else {
-        cnt = 0;
-        _benchlab_debug("I/O erro while reading from COM.\r\n");
-        return HRESULT_FROM_WIN32(::GetLastError());
+        hr = this->wait(clock_type::now() + quiet);
+        if (hr == benchlab_transport::timeout_error()) {
+            return S_OK;
+        } else if (FAILED(hr)) {
+            return hr;
+        }
+
+        if (!this->event_driven_reads()) {
+            // The transport cannot wait for input, so we need to give any
+            // straggler the chance to arrive on our own.
+            std::this_thread::sleep_for(quiet);
+        }
+
+        hr = this->_transport->available(cnt);
+        if (FAILED(hr)) {
+            return hr;
+        }
+
+        if (cnt == 0) {
+            return S_OK;
+        }
     }
 
-#else /* defined(_WIN32) */
-    cnt = ::read(this->_handle, dst, cnt);
-    if (cnt < 0) {
-        cnt = 0;
-        _benchlab_debug("I/O erro while reading from COM.\r\n");
-        return static_cast<HRESULT>(-errno);
-    } else {
+    return S_OK;
+}
+
+
+/*
+ * benchlab_device::receive
+ */
+HRESULT benchlab_device::receive(
+        _Out_ benchlab_sensor_readings& readings,
+        _Out_opt_ benchlab_timestamp *completed) const noexcept {
+    this->command_sleep();
+
+    std::array<std::uint8_t, supported_device_models::max_frame_size> frame;
+    auto hr = this->read(frame.data(), this->_model->frame_size,
+        this->_timeout);
+    if (FAILED(hr)) {
+        return hr;
+    }
+
+    if (completed != nullptr) {
+        *completed = this->_clock.now();
+    }
+
+    this->_model->decode(readings, frame.data());
+
+    // The frames have no header, so the only way of detecting that we are out
+    // of sync with the device is surplus input. As we have not issued another
+    // command yet, anything in the input queue must be garbage or a late
+    // response, which means that the frame we just read is likely corrupted.
+    if (this->_transport->is_preloaded()) {
         return S_OK;
     }
-#endif /* defined(_WIN32) */
+
+    std::size_t surplus = 0;
+    hr = this->_transport->available(surplus);
+    if (FAILED(hr)) {
+        return hr;
+    }
+
+    return (surplus == 0) ? S_OK : benchlab_transport::invalid_data_error();
 }
 
 
@@ -623,7 +1059,7 @@ HRESULT benchlab_device::read(_Out_writes_bytes_(cnt) void *dst,
 
     auto cur = static_cast<std::uint8_t *>(dst);
     auto rem = cnt;
-    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    const auto deadline = benchlab_transport::clock_type::now() + timeout;
 
     while (true) {
         auto read = rem;
@@ -633,21 +1069,17 @@ HRESULT benchlab_device::read(_Out_writes_bytes_(cnt) void *dst,
         }
 
         assert(rem >= read);
+        cur += read;
         rem -= read;
 
         if (rem == 0) {
             return S_OK;
         }
 
-        if (std::chrono::steady_clock::now() > deadline) {
-#if defined(_WIN32)
-            return HRESULT_FROM_WIN32(ERROR_TIMEOUT);
-#else /* defined(_WIN32) */
-            return static_cast<HRESULT>(-ETIMEDOUT);
-#endif /* defined(_WIN32) */
+        hr = this->wait(deadline);
+        if (FAILED(hr)) {
+            return hr;
         }
-
-        std::this_thread::sleep_for(std::chrono::milliseconds(1));
     }
 }
 
@@ -655,13 +1087,14 @@ HRESULT benchlab_device::read(_Out_writes_bytes_(cnt) void *dst,
 /*
  * benchlab_device::stream
  */
-void benchlab_device::stream(_In_ const benchlab_sample_callback callback,
-        _In_opt_ void *context,
-        _In_ const std::chrono::milliseconds period) {
-    assert(callback != nullptr);
+void benchlab_device::stream(
+        _In_ const benchlab_streaming_configuration config) {
+    using namespace std::chrono;
+    assert(has_sink(config));
 
+    const auto pipelined = (config.acquisition_mode
+        == benchlab_acquisition_mode::pipelined);
     benchlab_sensor_readings readings;
-    benchlab_sample sample;
     //set_thread_name("powenetics sampler");
 
     // Signal to everyone that we are now running. If this fails (with a strong
@@ -679,89 +1112,141 @@ void benchlab_device::stream(_In_ const benchlab_sample_callback callback,
         }
     }
 
-    auto deadline = std::chrono::steady_clock::now() + period;
+    sample_schedule schedule(config, steady_clock::now());
+    std::uint32_t failures = 0;
+    steady_clock::time_point failed_since;
+    auto outstanding = false;
+    benchlab_timestamp requested = 0;
+    benchlab_timestamp completed = 0;
+
+    while (this->check_running()) {
+        auto hr = S_OK;
+        if (!outstanding) {
+            this->_statistics.overran(schedule.advance(steady_clock::now()));
+            requested = this->_clock.now();
+            hr = this->request();
+        }
+        outstanding = false;
+
+        if (SUCCEEDED(hr)) {
+            hr = this->receive(readings, &completed);
+        }
+
+        if (FAILED(hr)) {
+            // Timeouts and garbled responses are typically caused by glitches
+            // on the USB bus. We resynchronise by discarding anything that is
+            // still underway and try again unless the device is gone or we
+            // have given up.
+            if (!is_recoverable(hr)) {
+                _benchlab_debug("Streaming stopped due to an I/O error.\r\n");
+                break;
+            }
+
+            this->_statistics.failed();
+            if (failures++ == 0) {
+                failed_since = steady_clock::now();
+            }
+            if ((config.max_failures > 0) && (failures > config.max_failures)) {
+                _benchlab_debug("Streaming stopped after too many consecutive "
+                    "failures.\r\n");
+                break;
+            }
+
+            std::size_t discarded = 0;
+            hr = this->purge(discarded);
+            this->_statistics.discarded(discarded);
+            if (FAILED(hr) && !is_recoverable(hr)) {
+                break;
+            }
+
+            schedule.restart(steady_clock::now());
+            continue;
+        }
+
+        const auto timestamp = this->_clock.select(requested, completed);
+
+        if (failures > 0) {
+            this->_statistics.recovered(steady_clock::now() - failed_since);
+            failures = 0;
+        }
+
+        // In pipelined mode, we request the next sample before processing the
+        // current one if the next one is already due. This way, the transfer
+        // of the next frame overlaps with the conversion and the callback. If
+        // the next sample is not due yet, we fall back to the stop-and-wait
+        // behaviour as we would otherwise deliver stale data.
+        if (pipelined) {
+            const auto now = steady_clock::now();
+            if (now >= schedule.deadline()) {
+                this->_statistics.overran(schedule.advance(now));
+                requested = this->_clock.now();
+                outstanding = SUCCEEDED(this->request());
+            }
+        }
+
+        this->deliver(readings, timestamp, config);
+        this->_statistics.record();
 
-    while (this->check_running() && SUCCEEDED(this->unchecked_read(readings))) {
-        ::benchlab_readings_to_sample(&sample, &readings, nullptr);
-        callback(this, &sample, context);
-        std::this_thread::sleep_until(deadline);
-        deadline = std::chrono::steady_clock::now() + period;
+        if (!outstanding) {
+            // If an incomplete batch falls due before the next sample, it is
+            // delivered in between.
+            if (this->_batch.deadline() < schedule.deadline()) {
+                sample_schedule::sleep_until(this->_batch.deadline());
+                this->_batch.flush(this, config);
+            }
+
+            sample_schedule::sleep_until(schedule.deadline());
+
+        } else if (steady_clock::now() >= this->_batch.deadline()) {
+            this->_batch.flush(this, config);
+        }
+    }
+
+    // If we leave with a request in flight, consume its response. Otherwise,
+    // it would be mistaken for the answer to the next synchronous command.
+    if (outstanding) {
+        this->receive(readings);
     }
 
+    this->_batch.flush(this, config);
+
     // Indicate that we are done. We do not CAS this from
     // stream_state::stopping, because a request for orderly shutdown is only
     // one way we can get here, the file handle being closed and the I/O failing
     // being the other one. In the latter case, the state will still be
     // stream_state::running at this point.
-    this->_state.store(stream_state::stopped,
-        std::memory_order::memory_order_release);
+    this->stopped();
 }
 
 
 /*
- * benchlab_device::unchecked_read
+ * benchlab_device::stopped
  */
-HRESULT benchlab_device::unchecked_read(
-        _Out_ benchlab_sensor_readings &readings) const noexcept {
-    {
-        auto hr = this->write(command::read_sensors);
-        if (FAILED(hr)) {
-            return hr;
-        }
+void benchlab_device::stopped(void) noexcept {
+    // The buffer must be closed before the state changes, because the device
+    // might be restarted or destroyed as soon as it is stopped.
+    if (this->_samples != nullptr) {
+        this->_samples->close();
     }
 
-    this->command_sleep();
-
-    return this->read(&readings, sizeof(readings), this->_timeout);
+    this->_state.store(stream_state::stopped,
+        std::memory_order::memory_order_release);
 }
 
 
 /*
- * benchlab_device::write
+ * benchlab_device::unchecked_read
  */
-HRESULT benchlab_device::write(_In_reads_bytes_(cnt) const void *data,
-        _In_ const std::size_t cnt) const noexcept {
-    assert(data != nullptr);
-
-#if defined(_WIN32)
-    auto cur = static_cast<const std::uint8_t *>(data);
-    auto rem = static_cast<DWORD>(cnt);
-    DWORD written = 0;
-
-    while (::WriteFile(this->_handle, cur, rem, &written, nullptr)) {
-        if (written == 0) {
-            return S_OK;
-        }
-
-        assert(written <= rem);
-        cur += written;
-        rem -= written;
-    }
-
-    auto retval = HRESULT_FROM_WIN32(::GetLastError());
-    _benchlab_debug("I/O error while writing to COM port.\r\n");
-    return retval;
-
-#else /* defined(_WIN32) */
-    auto cur = static_cast<const std::uint8_t *>(data);
-    auto rem = cnt;
-
-    while (rem > 0) {
-        auto written = ::write(this->_handle, cur, sizeof(rem));
-
-        if (written < 0) {
-            auto hr = static_cast<HRESULT>(-errno);
-            _benchlab_debug("I/O error while writing to COM port.\r\n");
+HRESULT benchlab_device::unchecked_read(
+        _Out_ benchlab_sensor_readings &readings) const noexcept {
+    {
+        auto hr = this->request();
+        if (FAILED(hr)) {
             return hr;
         }
-
-        assert(written <= rem);
-        cur += written;
-        rem -= written;
     }
 
-    return S_OK;
-#endif /* defined(_WIN32) */
+    return this->receive(readings);
 }
 
 
@@ -8,12 +8,14 @@
 #define _BENCHLAB_DEVICE_H
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <cassert>
 #include <chrono>
 #include <cinttypes>
 #include <cstddef>
+#include <memory>
 #include <string>
 #include <thread>
 #include <vector>
@@ -26,11 +28,28 @@
 #endif /* defined(_WIN32) */
 
 #include "libbenchlab/serial.h"
+#include "libbenchlab/streaming.h"
 #include "libbenchlab/types.h"
 
+#include "acquisition.h"
+#include "benchlab_transport.h"
+#include "channel_selection.h"
+#include "debug.h"
+#include "device_model_registry.h"
+#include "io.h"
+#include "protocol.h"
+#include "sample_batch.h"
+#include "sample_clock.h"
+#include "sample_schedule.h"
+#include "sensor_frame.h"
+#include "spsc_ring.h"
 #include "stream_state.h"
+#include "stream_statistics.h"
 
 
+/* Forward declarations. */
+class reactor_loop;
+
 
 /// <summary>
 /// Represents the connection to a Benchlab device and implements the
@@ -42,6 +61,35 @@ public:
 
     template<class TIterator> static HRESULT ports(_In_ TIterator oit);
 
+    /// <summary>
+    /// Answer whether <paramref name="config" /> specifies anything that the
+    /// streamed samples can be delivered to.
+    /// </summary>
+    static inline bool has_sink(
+            _In_ const benchlab_streaming_configuration& config) noexcept {
+        return (config.callback != nullptr)
+            || (config.batch_callback != nullptr)
+            || (config.readings_callback != nullptr)
+            || (config.compact_callback != nullptr)
+            || (config.buffer_size > 0);
+    }
+
+#if !defined(_WIN32)
+    /// <summary>
+    /// Answer whether the tty at <paramref name="path" /> in sysfs belongs to
+    /// a USB device with the vendor and product ID of a Benchlab.
+    /// </summary>
+    /// <remarks>
+    /// This check only reads a few attributes from sysfs, which is much
+    /// faster than trying to open the port and to talk to the device.
+    /// </remarks>
+    /// <param name="path">The path of the tty in <c>/sys/class/tty</c>.
+    /// </param>
+    /// <returns><c>true</c> if the tty is a Benchlab, <c>false</c>
+    /// otherwise.</returns>
+    static bool is_benchlab_tty(_In_ const std::string& path);
+#endif /* !defined(_WIN32) */
+
     benchlab_device(void) noexcept;
 
     ~benchlab_device(void) noexcept;
@@ -51,11 +99,42 @@ public:
     /// </summary>
     HRESULT close(void) noexcept;
 
+    /// <summary>
+    /// Gets the delay between issuing a command and reading the response
+    /// as well as the response latency measured when opening the device.
+    /// </summary>
+    inline void command_timing(_Out_ std::chrono::microseconds& sleep,
+            _Out_ std::chrono::microseconds& latency) const noexcept {
+        sleep = this->_command_sleep;
+        latency = this->_response_latency;
+    }
+
+#if !defined(_WIN32)
+    /// <summary>
+    /// Gets the descriptor that becomes readable when a device that is
+    /// streaming via <see cref="start_external" /> has sent data.
+    /// </summary>
+    HRESULT descriptor(_Out_ int& descriptor) const noexcept;
+#endif /* !defined(_WIN32) */
+
     /// <summary>
     /// Gets the user-defined friendly name of the device.
     /// </summary>
     HRESULT name(_Out_ std::vector<char>& name) const noexcept;
 
+    /// <summary>
+    /// Gets the time after which <see cref="process" /> must be called even
+    /// if the device has not sent any data.
+    /// </summary>
+    /// <param name="timeout">Receives the time from now until the next
+    /// wakeup, which is zero if <see cref="process" /> should be called
+    /// right away.</param>
+    /// <returns><c>S_OK</c> in case of success, <c>E_NOT_VALID_STATE</c> if
+    /// the device is not streaming via <see cref="start_external" />.
+    /// </returns>
+    HRESULT next_wakeup(
+        _Out_ std::chrono::microseconds& timeout) const noexcept;
+
     /// <summary>
     /// Updates the user-defined friendly name of the device.
     /// </summary>
@@ -68,6 +147,55 @@ public:
     HRESULT open(_In_z_ const benchlab_char *com_port,
         _In_ const benchlab_serial_configuration *config) noexcept;
 
+    /// <summary>
+    /// Connects the device via the given <paramref name="transport" /> if the
+    /// device has not yet been opened.
+    /// </summary>
+    /// <remarks>
+    /// The device takes ownership of the <paramref name="transport" /> even
+    /// if the operation fails. Only the version, the timeouts and the
+    /// calibration settings of the <paramref name="config" /> are used in
+    /// this case, because the transport is expected to be open already.
+    /// </remarks>
+    HRESULT open(_Inout_ std::unique_ptr<benchlab_transport>&& transport,
+        _In_ const benchlab_serial_configuration *config) noexcept;
+
+    /// <summary>
+    /// Advances the acquisition of a device streaming via
+    /// <see cref="start_external" /> as far as possible without blocking.
+    /// </summary>
+    /// <remarks>
+    /// Samples that have been received completely are delivered to the
+    /// callback from within this method.
+    /// </remarks>
+    /// <returns><c>S_OK</c> if the device continues streaming,
+    /// <c>E_NOT_VALID_STATE</c> if the device is not streaming via
+    /// <see cref="start_external" />, or the error that stopped streaming.
+    /// </returns>
+    HRESULT process(void) noexcept;
+
+    /// <summary>
+    /// Retrieves up to <paramref name="cnt" /> buffered samples, waiting for
+    /// at most <paramref name="timeout" /> if none are available.
+    /// </summary>
+    /// <remarks>
+    /// Only a single thread may retrieve samples at any time.
+    /// </remarks>
+    /// <param name="dst">Receives the samples.</param>
+    /// <param name="cnt">The size of <paramref name="dst" /> on entry, the
+    /// number of samples retrieved on exit.</param>
+    /// <param name="timeout">The time to wait for the first sample, which
+    /// can be zero for not waiting at all.</param>
+    /// <returns><c>S_OK</c> if samples have been retrieved or none were
+    /// available and the <paramref name="timeout" /> is zero, a timeout error
+    /// if no sample arrived within a non-zero <paramref name="timeout" />,
+    /// <c>E_NOT_VALID_STATE</c> if the buffer is empty and no more samples
+    /// will arrive, because the device is not streaming into a buffer.
+    /// </returns>
+    HRESULT poll(_Out_writes_to_(cnt, cnt) benchlab_sample *dst,
+        _Inout_ std::size_t& cnt,
+        _In_ const std::chrono::milliseconds timeout) noexcept;
+
     /// <summary>
     /// Press the given button for the specified time.
     /// </summary>
@@ -101,7 +229,29 @@ public:
         _In_ const std::chrono::milliseconds period) noexcept;
 
     /// <summary>
-    /// Asks the streaming thread to stop and waits for it exit.
+    /// Start streaming data from the device as described by the given
+    /// <paramref name="config" />.
+    /// </summary>
+    HRESULT start(_In_ const benchlab_streaming_configuration& config) noexcept;
+
+    /// <summary>
+    /// Start streaming data from the device without a thread, which requires
+    /// the caller to drive the acquisition by calling <see cref="process" />.
+    /// </summary>
+    HRESULT start_external(
+        _In_ const benchlab_streaming_configuration& config) noexcept;
+
+    /// <summary>
+    /// Gets the statistics of the current or the last streaming session.
+    /// </summary>
+    inline void statistics(
+            _Out_ benchlab_streaming_statistics& statistics) const noexcept {
+        this->_statistics.get(statistics);
+    }
+
+    /// <summary>
+    /// Asks the streaming thread or the reactor to stop acquiring samples and
+    /// waits until they have stopped.
     /// </summary>
     HRESULT stop(void) noexcept;
 
@@ -110,6 +260,14 @@ public:
     /// </summary>
     HRESULT uid(_Out_ benchlab_device_uid_type& uid) const noexcept;
 
+    /// <summary>
+    /// Gets the model of the device, which has been selected based on the
+    /// firmware version.
+    /// </summary>
+    inline const device_model_info& model(void) const noexcept {
+        return *this->_model;
+    }
+
     /// <summary>
     /// Gets the firmware version of a connected device.
     /// </summary>
@@ -125,43 +283,45 @@ public:
 
 private:
 
-    enum class action : std::uint8_t {
-        none = 0,
-        button
-    };
-
-    enum class command : std::uint8_t {
-        welcome = 0,
-        read_sensors,
-        action,
-        read_name,
-        write_name,
-        read_fan_profile,
-        write_fan_profile,
-        read_rgb,
-        write_rgb,
-        read_calibration,
-        write_calibration,
-        load_calibration,
-        store_calibration,
-        read_uid,
-        read_vendor_data,
-    };
+    typedef benchlab_action action;
+    friend class acquisition;
+    friend class reactor_loop;
+    typedef benchlab_command command;
+    typedef spsc_ring<benchlab_sample> sample_ring;
 
-#if defined(_WIN32)
-    typedef HANDLE handle_type;
-#else /* defined(_WIN32) */
-    typedef int handle_type;
-#endif /* defined(_WIN32) */
+    /// <summary>
+    /// The maximum number of round trips that <see cref="calibrate" /> will
+    /// perform.
+    /// </summary>
+    static constexpr std::size_t max_calibration_rounds = 64;
 
-#if defined(_WIN32)
-    static constexpr handle_type invalid_handle = INVALID_HANDLE_VALUE;
-#else /* defined(_WIN32) */
-    static constexpr handle_type invalid_handle = -1;
-#endif /* defined(_WIN32) */
+    /// <summary>
+    /// Retrieves the vendor data <paramref name="rounds" /> times, measures
+    /// the response latency of the device and, if requested, derives the
+    /// <see cref="_command_sleep" /> from it.
+    /// </summary>
+    /// <param name="rounds">The number of round trips to measure, which will
+    /// be clamped to <see cref="max_calibration_rounds" />.</param>
+    /// <param name="adjust">If <c>true</c>, <see cref="_command_sleep" /> is
+    /// set to the smallest safe value for the device.</param>
+    /// <returns><c>S_OK</c> in case of success, or the error returned by
+    /// <see cref="check_vendor_data" />.</returns>
+    HRESULT calibrate(_In_ std::size_t rounds,
+        _In_ const bool adjust) noexcept;
 
     /// <summary>
-    /// Check whether <see cref="_handle" /> is valid.
+    /// Transitions the device from <see cref="stream_state::stopped" /> into
+    /// <see cref="stream_state::starting" /> and prepares a new streaming
+    /// session as described by <paramref name="config" />.
+    /// </summary>
+    /// <returns><c>S_OK</c> in case of success, an error code if the device
+    /// is not open or already streaming or if the sample buffer could not be
+    /// allocated.</returns>
+    HRESULT begin_start(
+        _In_ const benchlab_streaming_configuration& config) noexcept;
+
+    /// <summary>
+    /// Check whether <see cref="_transport" /> is open.
     /// </summary>
     /// <returns></returns>
     HRESULT check_handle(void) const noexcept;
@@ -211,9 +371,93 @@ private:
     /// be missing.
     /// </remarks>
     inline void command_sleep(void) const{
-        std::this_thread::sleep_for(this->_command_sleep);
+        if (this->_command_sleep.count() > 0) {
+            std::this_thread::sleep_for(this->_command_sleep);
+        }
+    }
+
+    /// <summary>
+    /// Passes <paramref name="readings" /> to the readings callback and the
+    /// selected channels converted from it to the compact callback, the
+    /// buffer, the callback and the batch as requested in
+    /// <paramref name="config" />.
+    /// </summary>
+    /// <remarks>
+    /// <para>The readings are only converted if anyone is interested in the
+    /// sample, and only the channels selected when streaming was started are
+    /// converted.</para>
+    /// <para>The batch is delivered once it is complete. Incomplete batches
+    /// must be delivered by the caller once their latency has expired and
+    /// before streaming stops.</para>
+    /// </remarks>
+    void deliver(_In_ const benchlab_sensor_readings& readings,
+        _In_ const benchlab_timestamp timestamp,
+        _In_ const benchlab_streaming_configuration& config) noexcept;
+
+    /// <summary>
+    /// Answer whether <see cref="read" /> blocks until data arrive rather than
+    /// returning immediately if the input queue is empty.
+    /// </summary>
+    /// <remarks>
+    /// If reads are event-driven, <see cref="command_sleep" /> is not required
+    /// to make sure that the first byte of the response is available.
+    /// </remarks>
+    inline bool event_driven_reads(void) const noexcept {
+        return this->_transport->is_event_driven();
+    }
+
+    /// <summary>
+    /// Answer whether the streaming thread can retry after an acquisition
+    /// failed with <paramref name="hr" />.
+    /// </summary>
+    static inline bool is_recoverable(_In_ const HRESULT hr) noexcept {
+        return (hr == benchlab_transport::timeout_error())
+            || (hr == benchlab_transport::invalid_data_error());
     }
 
+    /// <summary>
+    /// Discards all input until the device has not sent anything for a
+    /// while, which resynchronises the protocol after a failure.
+    /// </summary>
+    /// <param name="discarded">Receives the number of bytes discarded.
+    /// </param>
+    /// <returns><c>S_OK</c> in case of success, an error code if the
+    /// transport failed.</returns>
+    HRESULT purge(_Out_ std::size_t& discarded) const noexcept;
+
+    /// <summary>
+    /// Answer how long the line must not receive any input before it is
+    /// considered quiet after a failure.
+    /// </summary>
+    /// <remarks>
+    /// This is a couple of round trips, but not longer than any response
+    /// could take.
+    /// </remarks>
+    inline std::chrono::milliseconds quiet_time(void) const noexcept {
+        using namespace std::chrono;
+        return (std::min)(
+            (std::max)(duration_cast<milliseconds>(4 * this->_response_latency),
+                milliseconds(5)),
+            (std::max)(this->_timeout, milliseconds(5)));
+    }
+
+    /// <summary>
+    /// Receives the response to a <see cref="command::read_sensors" />
+    /// that has been issued before via <see cref="request" />.
+    /// </summary>
+    /// <remarks>
+    /// The method fails with
+    /// <see cref="benchlab_transport::invalid_data_error" /> if there is
+    /// surplus input after the response, which indicates that the response
+    /// is not aligned with the frame.
+    /// </remarks>
+    /// <param name="readings">Receives the sensor readings.</param>
+    /// <param name="completed">If not <c>nullptr</c>, receives the reading
+    /// of <see cref="_clock" /> immediately after the last byte of the
+    /// response has been read.</param>
+    HRESULT receive(_Out_ benchlab_sensor_readings& readings,
+        _Out_opt_ benchlab_timestamp *completed = nullptr) const noexcept;
+
     /// <summary>
     /// Reads at most <paramref name="cnt" /> bytes from the serial port.
     /// </summary>
@@ -227,16 +471,22 @@ private:
     /// number of bytes written on successful exit.</param>
     /// <returns><c>S_OK</c> in case of success, an error code otherwise.
     /// </returns>
-    HRESULT read(_Out_writes_bytes_(cnt) void *dst,
-        _Inout_ std::size_t& cnt) const noexcept;
+    inline HRESULT read(_Out_writes_bytes_(cnt) void *dst,
+            _Inout_ std::size_t& cnt) const noexcept {
+        return this->_transport->read(dst, cnt);
+    }
 
     /// <summary>
     /// Reads <paramref name="cnt" /> bytes from the serial port or fails
     /// after <paramref name="timeout" /> milliseconds.
     /// </summary>
     /// <remarks>
-    /// This method must not be called while the device is streaming. Only
-    /// the streaming thread within the object may read at this point.
+    /// <para>This method must not be called while the device is streaming.
+    /// Only the streaming thread within the object may read at this point.
+    /// </para>
+    /// <para>Between two attempts to read, the method blocks in
+    /// <see cref="wait" /> until new input arrives, so it returns as soon as
+    /// the last requested byte has been received.</para>
     /// </remarks>
     /// <param name="dst">A buffer that is able to receive at least
     /// <paramref name="cnt" /> bytes.</param>
@@ -292,9 +542,44 @@ private:
         return this->read(dst.data(), sizeof(TType) * dst.size(), timeout);
     }
 
-    void stream(_In_ const benchlab_sample_callback callback,
-        _In_opt_ void *context,
-        _In_ const std::chrono::milliseconds period);
+    /// <summary>
+    /// Blocks the calling thread until input is available from the serial
+    /// port or the given <paramref name="deadline" /> has passed.
+    /// </summary>
+    /// <remarks>
+    /// This method must not be called while the device is streaming. Only
+    /// the streaming thread within the object may read at this point.
+    /// </remarks>
+    /// <param name="deadline">The point in time after which the wait will
+    /// fail.</param>
+    /// <returns><c>S_OK</c> if data might be available, a timeout error if
+    /// the deadline has passed, or any other error code if the port failed,
+    /// e.g. because the device was unplugged.</returns>
+    inline HRESULT wait(
+            _In_ const benchlab_transport::clock_type::time_point deadline)
+            const noexcept {
+        return this->_transport->wait(deadline);
+    }
+
+    /// <summary>
+    /// Issues a <see cref="command::read_sensors" /> without waiting for the
+    /// response.
+    /// </summary>
+    inline HRESULT request(void) const noexcept {
+        return this->write(command::read_sensors);
+    }
+
+    /// <summary>
+    /// The body of the streaming thread.
+    /// </summary>
+    void stream(_In_ const benchlab_streaming_configuration config);
+
+    /// <summary>
+    /// Closes the sample buffer and wakes any thread waiting for samples
+    /// before transitioning the device into
+    /// <see cref="stream_state::stopped" /> after streaming ended.
+    /// </summary>
+    void stopped(void) noexcept;
 
     /// <summary>
     /// Obtains a single set of sensor readings from the device.
@@ -315,8 +600,10 @@ private:
     /// <param name="cnt">The number of bytes to write.</param>
     /// <returns><c>S_OK</c> in case of success, an error code otherwise.
     /// </returns>
-    HRESULT write(_In_reads_bytes_(cnt) const void *data,
-        _In_ const std::size_t cnt) const noexcept;
+    inline HRESULT write(_In_reads_bytes_(cnt) const void *data,
+            _In_ const std::size_t cnt) const noexcept {
+        return this->_transport->write(data, cnt);
+    }
 
     /// <summary>
     /// Writes the given <paramref name="command" /> to the device, potentially
@@ -331,11 +618,21 @@ private:
         _In_reads_bytes_opt_(cnt) const void *parameter = nullptr,
         _In_ const std::size_t cnt = 0) const noexcept;
 
+    sample_batch _batch;
+    channel_selection _channels;
+    sample_clock _clock;
     std::chrono::microseconds _command_sleep;
-    handle_type _handle;
+    std::unique_ptr<acquisition> _external;
+    reactor_loop *_loop;
+    const device_model_info *_model;
+    bool _processing;
+    std::chrono::microseconds _response_latency;
+    std::unique_ptr<sample_ring> _samples;
     std::atomic<stream_state> _state;
+    stream_statistics _statistics;
     std::thread _thread;
     std::chrono::milliseconds _timeout;
+    std::unique_ptr<benchlab_transport> _transport;
     std::uint8_t _version;
 };
 
@@ -48,20 +48,29 @@ HRESULT benchlab_device::ports(_In_ TIterator oit) {
     return S_OK;
 
 #else /* defined(_WIN32) */
-    //string[] ttyList = Directory.GetDirectories("/sys/bus/usb-serial/devices/");
+    static const std::string dev("/dev");
+    static const std::string sys_class_tty("/sys/class/tty");
 
-    //foreach(string portFile in ttyList) {
-    //    string realPortFile = Mono.Unix.UnixPath.GetRealPath(portFile);
-    //    string checkPath = Path.GetFullPath(Path.Combine(realPortFile, "../uevent"));
-    //    string[] lines = File.ReadAllLines(checkPath);
-    //    string productLine = lines.First(l = > l.StartsWith("PRODUCT="));
-    //    string[] productSplit = productLine.Remove(0, 8).Trim().Split('/');
+    // Every tty is represented by a link in sysfs, but only the ones backed by
+    // hardware have a device we can check the USB IDs of. We match the IDs
+    // rather than probing the ports to avoid opening unrelated devices.
+    try {
+        std::vector<std::string> ttys;
+        ::get_file_system_entries(std::back_inserter(ttys),
+            sys_class_tty,
+            false,
+            [](const struct dirent& e) {
+                return is_benchlab_tty(combine_path(sys_class_tty, e.d_name));
+            });
 
-    //    if (productSplit[0] == "1a86" && productSplit[1] == "7523") {
-    //        string portDevPath = Path.Combine("/dev/", Path.GetFileName(portFile));
-    //        ports.Add(portDevPath);
-    //    }
-    //}
-    return E_NOTIMPL;
+        for (auto& t : ttys) {
+            *oit++ = combine_path(dev, t.substr(t.find_last_of('/') + 1));
+        }
+    } catch (std::system_error& ex) {
+        _benchlab_debug("Enumerating ttys in sysfs failed.\r\n");
+        return static_cast<HRESULT>(-ex.code().value());
+    }
+
+    return S_OK;
 #endif /* defined(_WIN32) */
 }
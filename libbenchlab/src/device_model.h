@@ -0,0 +1,100 @@
+﻿// <copyright file="device_model.h" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#if !defined(_BENCHLAB_DEVICE_MODEL_H)
+#define _BENCHLAB_DEVICE_MODEL_H
+#pragma once
+
+#include <cinttypes>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "libbenchlab/constants.h"
+
+
+/// <summary>
+/// Describes the sensors of a revision of the Benchlab hardware at compile
+/// time.
+/// </summary>
+/// <remarks>
+/// <para>The layout of the frames sent by the device, the decoder and the
+/// conversion loops are instantiated from the model such that all of them
+/// work on the exact number of sensors of the revision.</para>
+/// <para>The readings of all models are decoded into
+/// <see cref="benchlab_sensor_readings" />, which is part of the public
+/// interface. Therefore, a model cannot have more sensors than this structure
+/// can hold. Sensors that a model does not have read as zero.</para>
+/// </remarks>
+/// <typeparam name="FirstFirmware">The first firmware version that reports
+/// the model.</typeparam>
+/// <typeparam name="VinSensors">The number of input voltage sensors.
+/// </typeparam>
+/// <typeparam name="TemperatureSensors">The number of temperature sensors.
+/// </typeparam>
+/// <typeparam name="PowerSensors">The number of power sensors.</typeparam>
+/// <typeparam name="Fans">The number of fans.</typeparam>
+template<std::uint8_t FirstFirmware,
+    std::size_t VinSensors,
+    std::size_t TemperatureSensors,
+    std::size_t PowerSensors,
+    std::size_t Fans>
+struct device_model final {
+    static_assert(VinSensors <= BENCHLAB_VIN_SENSORS, "The input voltages of "
+        "the model exceed the capacity of the public readings.");
+    static_assert(TemperatureSensors <= BENCHLAB_TEMPERATURE_SENSORS, "The "
+        "temperatures of the model exceed the capacity of the public "
+        "readings.");
+    static_assert(PowerSensors <= BENCHLAB_POWER_SENSORS, "The power sensors "
+        "of the model exceed the capacity of the public readings.");
+    static_assert(Fans <= BENCHLAB_FANS, "The fans of the model exceed the "
+        "capacity of the public readings.");
+
+    static constexpr std::uint8_t first_firmware = FirstFirmware;
+    static constexpr std::size_t vin_sensors = VinSensors;
+    static constexpr std::size_t temperature_sensors = TemperatureSensors;
+    static constexpr std::size_t power_sensors = PowerSensors;
+    static constexpr std::size_t fans = Fans;
+};
+
+
+/// <summary>
+/// The Benchlab as reported by all firmware versions released so far.
+/// </summary>
+typedef device_model<0,
+    BENCHLAB_VIN_SENSORS,
+    BENCHLAB_TEMPERATURE_SENSORS,
+    BENCHLAB_POWER_SENSORS,
+    BENCHLAB_FANS> benchlab_model_v1;
+
+
+/// <summary>
+/// Invokes <paramref name="func" /> with an
+/// <see cref="std::integral_constant" /> for each of the indices in
+/// <typeparamref name="I" />.
+/// </summary>
+/// <remarks>
+/// The calls are expanded at compile time, such that the index is a constant
+/// expression in each of them.
+/// </remarks>
+template<class TFunc, std::size_t... I>
+inline void unroll(_In_ TFunc&& func,
+        std::index_sequence<I...>) noexcept {
+    (func(std::integral_constant<std::size_t, I>()), ...);
+}
+
+
+/// <summary>
+/// Invokes <paramref name="func" /> with an
+/// <see cref="std::integral_constant" /> for each index in [0,
+/// <typeparamref name="Count" />[.
+/// </summary>
+template<std::size_t Count, class TFunc>
+inline void unroll(_In_ TFunc&& func) noexcept {
+    unroll(std::forward<TFunc>(func), std::make_index_sequence<Count>());
+}
+
+#endif /* !defined(_BENCHLAB_DEVICE_MODEL_H) */
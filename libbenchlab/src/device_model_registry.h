@@ -0,0 +1,144 @@
+﻿// <copyright file="device_model_registry.h" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#if !defined(_BENCHLAB_DEVICE_MODEL_REGISTRY_H)
+#define _BENCHLAB_DEVICE_MODEL_REGISTRY_H
+#pragma once
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstddef>
+
+#include "libbenchlab/types.h"
+
+#include "device_model.h"
+#include "sensor_frame.h"
+
+
+/// <summary>
+/// The runtime view of a <see cref="device_model" />, which a device selects
+/// once it knows the version of its firmware.
+/// </summary>
+struct device_model_info final {
+
+    /// <summary>
+    /// The signature of the decoder instantiated for the model.
+    /// </summary>
+    typedef void (*decoder_type)(_Out_ benchlab_sensor_readings&,
+        _In_ const std::uint8_t *) noexcept;
+
+    /// <summary>
+    /// The first firmware version that reports the model.
+    /// </summary>
+    std::uint8_t first_firmware;
+
+    /// <summary>
+    /// The number of bytes in a frame of the model.
+    /// </summary>
+    std::size_t frame_size;
+
+    /// <summary>
+    /// Restores the sensor readings from a frame of
+    /// <see cref="frame_size" /> bytes.
+    /// </summary>
+    decoder_type decode;
+
+    /// <summary>
+    /// Describes <typeparamref name="TModel" />.
+    /// </summary>
+    template<class TModel> static constexpr device_model_info describe(
+            void) noexcept {
+        typedef basic_sensor_frame<TModel> frame_type;
+        return device_model_info {
+            TModel::first_firmware,
+            frame_type::size,
+            static_cast<decoder_type>(&frame_type::decode)
+        };
+    }
+};
+
+
+/// <summary>
+/// Selects the <see cref="device_model" /> of a device from the models that
+/// the library has been compiled for.
+/// </summary>
+/// <remarks>
+/// Each model is instantiated separately, so supporting a new revision of
+/// the hardware adds no indirection besides the call to the decoder of the
+/// model.
+/// </remarks>
+/// <typeparam name="TModels">The supported models in ascending order of the
+/// firmware version that introduced them.</typeparam>
+template<class... TModels>
+struct device_model_registry final {
+    static_assert(sizeof...(TModels) > 0, "At least one device model must be "
+        "supported.");
+
+    /// <summary>
+    /// The size of the largest frame of any of the models.
+    /// </summary>
+    static constexpr std::size_t max_frame_size = (std::max)({
+        basic_sensor_frame<TModels>::size... });
+
+    /// <summary>
+    /// The descriptions of all models.
+    /// </summary>
+    static constexpr device_model_info models[] = {
+        device_model_info::describe<TModels>()...
+    };
+
+    /// <summary>
+    /// Answer whether the models are sorted by the firmware version that
+    /// introduced them.
+    /// </summary>
+    static constexpr bool is_sorted(void) noexcept {
+        for (std::size_t i = 1; i < sizeof...(TModels); ++i) {
+            if (models[i - 1].first_firmware >= models[i].first_firmware) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    /// <summary>
+    /// Gets the model that has been introduced last.
+    /// </summary>
+    static constexpr const device_model_info& latest(void) noexcept {
+        return models[sizeof...(TModels) - 1];
+    }
+
+    /// <summary>
+    /// Gets the newest model that firmware version
+    /// <paramref name="firmware" /> can report.
+    /// </summary>
+    /// <remarks>
+    /// Firmware older than any of the known models is treated as the first
+    /// model.
+    /// </remarks>
+    static constexpr const device_model_info& select(
+            _In_ const std::uint8_t firmware) noexcept {
+        std::size_t retval = 0;
+        for (std::size_t i = 1; i < sizeof...(TModels); ++i) {
+            if (models[i].first_firmware <= firmware) {
+                retval = i;
+            }
+        }
+
+        return models[retval];
+    }
+};
+
+
+/// <summary>
+/// The models that the library supports.
+/// </summary>
+typedef device_model_registry<benchlab_model_v1> supported_device_models;
+
+static_assert(supported_device_models::is_sorted(), "The supported device "
+    "models must be sorted by the firmware version introducing them.");
+
+#endif /* !defined(_BENCHLAB_DEVICE_MODEL_REGISTRY_H) */
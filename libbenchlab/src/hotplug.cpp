@@ -0,0 +1,87 @@
+﻿// <copyright file="hotplug.cpp" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#include "libbenchlab/hotplug.h"
+
+#include <memory>
+#include <new>
+
+#include "debug.h"
+#include "hotplug_monitor.h"
+
+
+/*
+ * ::benchlab_initialise_hotplug_configuration
+ */
+HRESULT LIBBENCHLAB_API benchlab_initialise_hotplug_configuration(
+        _In_ benchlab_hotplug_configuration *config) {
+    if (config == nullptr) {
+        return E_POINTER;
+    }
+
+    switch (config->version) {
+        case 1:
+            config->callback = nullptr;
+            config->context = nullptr;
+            config->open_devices = false;
+            config->report_existing = true;
+            config->serial_configuration = nullptr;
+            return S_OK;
+
+        default:
+            return E_INVALIDARG;
+    }
+}
+
+
+/*
+ * ::benchlab_start_hotplug_monitor
+ */
+HRESULT LIBBENCHLAB_API benchlab_start_hotplug_monitor(
+        _Out_ benchlab_hotplug_handle *out_monitor,
+        _In_ const benchlab_hotplug_configuration *config) {
+    if (out_monitor == nullptr) {
+        _benchlab_debug("Invalid storage location for monitor provided."
+            "\r\n");
+        return E_POINTER;
+    }
+
+    *out_monitor = nullptr;
+
+    if ((config == nullptr) || (config->version != 1)) {
+        _benchlab_debug("Invalid hotplug configuration provided.\r\n");
+        return E_INVALIDARG;
+    }
+    if (config->callback == nullptr) {
+        _benchlab_debug("A hotplug monitor requires a callback.\r\n");
+        return E_INVALIDARG;
+    }
+
+    std::unique_ptr<benchlab_hotplug_monitor> monitor(
+        new (std::nothrow) benchlab_hotplug_monitor());
+    if (monitor == nullptr) {
+        _benchlab_debug("Insufficient memory for hotplug monitor.\r\n");
+        return E_OUTOFMEMORY;
+    }
+
+    auto hr = monitor->start(*config);
+    if (SUCCEEDED(hr)) {
+        *out_monitor = monitor.release();
+    }
+
+    return hr;
+}
+
+
+/*
+ * ::benchlab_stop_hotplug_monitor
+ */
+HRESULT LIBBENCHLAB_API benchlab_stop_hotplug_monitor(
+        _In_opt_ benchlab_hotplug_handle monitor) {
+    // The destructor stops the monitor thread.
+    delete monitor;
+    return S_OK;
+}
@@ -0,0 +1,490 @@
+﻿// <copyright file="hotplug_monitor.cpp" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#include "hotplug_monitor.h"
+
+#include <array>
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <iterator>
+#include <system_error>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <linux/netlink.h>
+#endif /* !defined(_WIN32) */
+
+#include "libbenchlab/benchlab.h"
+
+#include "debug.h"
+#include "device.h"
+#include "serial_configuration.h"
+
+
+/*
+ * benchlab_hotplug_monitor::benchlab_hotplug_monitor
+ */
+benchlab_hotplug_monitor::benchlab_hotplug_monitor(void) noexcept
+    : _callback(nullptr), _context(nullptr), _open_devices(false)
+#if !defined(_WIN32)
+    , _cancel(-1), _events(-1), _inotify(false)
+#endif /* !defined(_WIN32) */
+    { }
+
+
+/*
+ * benchlab_hotplug_monitor::~benchlab_hotplug_monitor
+ */
+benchlab_hotplug_monitor::~benchlab_hotplug_monitor(void) noexcept {
+    this->stop();
+}
+
+
+/*
+ * benchlab_hotplug_monitor::start
+ */
+HRESULT benchlab_hotplug_monitor::start(
+        _In_ const benchlab_hotplug_configuration& config) noexcept {
+#if defined(_WIN32)
+    return E_NOTIMPL;
+
+#else /* defined(_WIN32) */
+    assert(config.callback != nullptr);
+
+    if (this->_thread.joinable()) {
+        _benchlab_debug("The hotplug monitor is already running.\r\n");
+        return E_NOT_VALID_STATE;
+    }
+
+    {
+        auto hr = ::copy_serial_configuration(this->_serial,
+            config.serial_configuration);
+        if (FAILED(hr)) {
+            _benchlab_debug("Invalid serial configuration provided.\r\n");
+            return hr;
+        }
+    }
+
+    this->_callback = config.callback;
+    this->_context = config.context;
+    this->_open_devices = config.open_devices;
+
+    this->_cancel = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (this->_cancel == -1) {
+        auto retval = static_cast<HRESULT>(-errno);
+        _benchlab_debug("Creating the cancellation event failed.\r\n");
+        return retval;
+    }
+
+    // Prefer the kernel uevents, which are what udev uses, and fall back to
+    // inotify if we are not allowed to bind the socket, e.g. in a container.
+    auto hr = this->listen_netlink();
+    if (FAILED(hr)) {
+        _benchlab_debug("Falling back to inotify for hotplug events.\r\n");
+        hr = this->listen_inotify();
+    }
+
+    if (SUCCEEDED(hr)) {
+        try {
+            this->_thread = std::thread(&benchlab_hotplug_monitor::monitor,
+                this, config.report_existing);
+        } catch (std::system_error& ex) {
+            hr = static_cast<HRESULT>(-ex.code().value());
+        }
+    }
+
+    if (FAILED(hr)) {
+        this->stop();
+    }
+
+    return hr;
+#endif /* defined(_WIN32) */
+}
+
+
+/*
+ * benchlab_hotplug_monitor::stop
+ */
+HRESULT benchlab_hotplug_monitor::stop(void) noexcept {
+#if !defined(_WIN32)
+    if (this->_thread.joinable()) {
+        const std::uint64_t one = 1;
+        auto status = ::write(this->_cancel, &one, sizeof(one));
+        static_cast<void>(status);
+        this->_thread.join();
+    }
+
+    if (this->_events != -1) {
+        ::close(this->_events);
+        this->_events = -1;
+    }
+
+    if (this->_cancel != -1) {
+        ::close(this->_cancel);
+        this->_cancel = -1;
+    }
+
+    this->_known.clear();
+#endif /* !defined(_WIN32) */
+
+    return S_OK;
+}
+
+
+#if !defined(_WIN32)
+/*
+ * benchlab_hotplug_monitor::parse_uevent
+ */
+bool benchlab_hotplug_monitor::parse_uevent(_Out_ std::string& action,
+        _Out_ std::string& name,
+        _In_reads_bytes_(cnt) const char *data,
+        _In_ const std::size_t cnt) {
+    static const std::string action_key("ACTION=");
+    static const std::string devname_key("DEVNAME=");
+    static const std::string subsystem_key("SUBSYSTEM=");
+    bool is_tty = false;
+
+    action.clear();
+    name.clear();
+
+    // The event is a sequence of null-terminated strings, the first of which
+    // is a summary in the form "action@devpath", which we skip. The others
+    // are key-value pairs.
+    auto cur = data;
+    auto end = data + cnt;
+    cur += ::strnlen(cur, end - cur) + 1;
+
+    while (cur < end) {
+        const auto len = ::strnlen(cur, end - cur);
+        const std::string line(cur, len);
+        cur += len + 1;
+
+        if (line.compare(0, action_key.size(), action_key) == 0) {
+            action = line.substr(action_key.size());
+
+        } else if (line.compare(0, devname_key.size(), devname_key) == 0) {
+            name = line.substr(devname_key.size());
+
+        } else if (line.compare(0, subsystem_key.size(), subsystem_key) == 0) {
+            is_tty = (line.compare(subsystem_key.size(),
+                std::string::npos, "tty") == 0);
+        }
+    }
+
+    // Nodes in sub-directories of /dev are not serial ports we could open.
+    return is_tty
+        && !action.empty()
+        && !name.empty()
+        && (name.find('/') == std::string::npos);
+}
+
+
+/*
+ * benchlab_hotplug_monitor::attached
+ */
+void benchlab_hotplug_monitor::attached(
+        _In_ const std::string& name) noexcept {
+    static const std::string dev("/dev");
+    static const std::string sys_class_tty("/sys/class/tty");
+
+    if (this->_known.find(name) != this->_known.end()) {
+        return;
+    }
+
+    if (!benchlab_device::is_benchlab_tty(combine_path(sys_class_tty, name))) {
+        return;
+    }
+
+    try {
+        this->_known.insert(name);
+    } catch (std::bad_alloc&) {
+        _benchlab_debug("Insufficient memory to track hotplug device.\r\n");
+        return;
+    }
+
+    const auto port = combine_path(dev, name);
+    benchlab_handle handle = nullptr;
+
+    if (this->_open_devices) {
+        for (std::size_t i = 0; i < max_open_attempts; ++i) {
+            if (SUCCEEDED(::benchlab_open(&handle, port.c_str(),
+                    &this->_serial))) {
+                break;
+            }
+
+            if (this->cancelled(open_retry_delay)) {
+                return;
+            }
+        }
+    }
+
+    this->_callback(benchlab_hotplug_event::attached,
+        port.c_str(),
+        handle,
+        this->_context);
+}
+
+
+/*
+ * benchlab_hotplug_monitor::cancelled
+ */
+bool benchlab_hotplug_monitor::cancelled(
+        _In_ const std::chrono::milliseconds timeout) noexcept {
+    pollfd fd { this->_cancel, POLLIN, 0 };
+    return (::poll(&fd, 1, static_cast<int>(timeout.count())) > 0);
+}
+
+
+/*
+ * benchlab_hotplug_monitor::detached
+ */
+void benchlab_hotplug_monitor::detached(
+        _In_ const std::string& name) noexcept {
+    static const std::string dev("/dev");
+
+    // Only report devices that have been reported as attached before. We
+    // cannot check removed devices in sysfs, because they are already gone.
+    if (this->_known.erase(name) > 0) {
+        const auto port = combine_path(dev, name);
+        this->_callback(benchlab_hotplug_event::detached,
+            port.c_str(),
+            nullptr,
+            this->_context);
+    }
+}
+
+
+/*
+ * benchlab_hotplug_monitor::listen_inotify
+ */
+HRESULT benchlab_hotplug_monitor::listen_inotify(void) noexcept {
+    assert(this->_events == -1);
+
+    this->_events = ::inotify_init1(IN_CLOEXEC | IN_NONBLOCK);
+    if (this->_events == -1) {
+        auto retval = static_cast<HRESULT>(-errno);
+        _benchlab_debug("Creating an inotify instance failed.\r\n");
+        return retval;
+    }
+
+    if (::inotify_add_watch(this->_events, "/dev", IN_CREATE | IN_DELETE)
+            == -1) {
+        auto retval = static_cast<HRESULT>(-errno);
+        _benchlab_debug("Watching /dev failed.\r\n");
+        ::close(this->_events);
+        this->_events = -1;
+        return retval;
+    }
+
+    this->_inotify = true;
+    return S_OK;
+}
+
+
+/*
+ * benchlab_hotplug_monitor::listen_netlink
+ */
+HRESULT benchlab_hotplug_monitor::listen_netlink(void) noexcept {
+    assert(this->_events == -1);
+
+    this->_events = ::socket(AF_NETLINK,
+        SOCK_DGRAM | SOCK_CLOEXEC | SOCK_NONBLOCK,
+        NETLINK_KOBJECT_UEVENT);
+    if (this->_events == -1) {
+        auto retval = static_cast<HRESULT>(-errno);
+        _benchlab_debug("Creating a uevent socket failed.\r\n");
+        return retval;
+    }
+
+    // Group 1 receives the events directly from the kernel.
+    sockaddr_nl address;
+    ::memset(&address, 0, sizeof(address));
+    address.nl_family = AF_NETLINK;
+    address.nl_groups = 1;
+
+    if (::bind(this->_events, reinterpret_cast<sockaddr *>(&address),
+            sizeof(address)) == -1) {
+        auto retval = static_cast<HRESULT>(-errno);
+        _benchlab_debug("Binding the uevent socket failed.\r\n");
+        ::close(this->_events);
+        this->_events = -1;
+        return retval;
+    }
+
+    this->_inotify = false;
+    return S_OK;
+}
+
+
+/*
+ * benchlab_hotplug_monitor::monitor
+ */
+void benchlab_hotplug_monitor::monitor(
+        _In_ const bool report_existing) noexcept {
+    // We started listening before enumerating the existing devices, so we do
+    // not miss anything attached in between.
+    this->resync(report_existing);
+
+    std::array<pollfd, 2> fds;
+    fds[0].fd = this->_events;
+    fds[0].events = POLLIN;
+    fds[1].fd = this->_cancel;
+    fds[1].events = POLLIN;
+
+    while (true) {
+        fds[0].revents = fds[1].revents = 0;
+
+        if (::poll(fds.data(), fds.size(), -1) == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            _benchlab_debug("Polling for hotplug events failed.\r\n");
+            return;
+        }
+
+        if (fds[1].revents != 0) {
+            return;
+        }
+
+        if ((fds[0].revents & POLLIN) != 0) {
+            if (this->_inotify) {
+                this->process_inotify();
+            } else {
+                this->process_netlink();
+            }
+        }
+
+        if ((fds[0].revents & (POLLERR | POLLHUP | POLLNVAL)) != 0) {
+            _benchlab_debug("The hotplug event source failed.\r\n");
+            return;
+        }
+    }
+}
+
+
+/*
+ * benchlab_hotplug_monitor::process_inotify
+ */
+void benchlab_hotplug_monitor::process_inotify(void) noexcept {
+    alignas(inotify_event) std::array<char, 4096> buffer;
+
+    while (true) {
+        auto cnt = ::read(this->_events, buffer.data(), buffer.size());
+        if (cnt <= 0) {
+            return;
+        }
+
+        for (auto cur = buffer.data(); cur < buffer.data() + cnt;) {
+            auto e = reinterpret_cast<const inotify_event *>(cur);
+            cur += sizeof(inotify_event) + e->len;
+
+            if ((e->mask & IN_Q_OVERFLOW) != 0) {
+                this->resync(true);
+
+            } else if ((e->len > 0) && ((e->mask & IN_CREATE) != 0)) {
+                this->attached(e->name);
+
+            } else if ((e->len > 0) && ((e->mask & IN_DELETE) != 0)) {
+                this->detached(e->name);
+            }
+        }
+    }
+}
+
+
+/*
+ * benchlab_hotplug_monitor::process_netlink
+ */
+void benchlab_hotplug_monitor::process_netlink(void) noexcept {
+    static const std::string add("add");
+    static const std::string remove("remove");
+    std::array<char, 8192> buffer;
+    std::string action, name;
+
+    while (true) {
+        sockaddr_nl sender;
+        socklen_t size = sizeof(sender);
+        auto cnt = ::recvfrom(this->_events, buffer.data(), buffer.size(), 0,
+            reinterpret_cast<sockaddr *>(&sender), &size);
+
+        if (cnt < 0) {
+            if (errno == ENOBUFS) {
+                // The socket overflowed, so we have lost events and need to
+                // check what is actually there.
+                this->resync(true);
+                continue;
+            }
+
+            return;
+        }
+
+        // Only trust messages from the kernel, which has port ID zero.
+        if ((size != sizeof(sender)) || (sender.nl_pid != 0)) {
+            continue;
+        }
+
+        try {
+            if (!parse_uevent(action, name, buffer.data(), cnt)) {
+                continue;
+            }
+        } catch (std::bad_alloc&) {
+            continue;
+        }
+
+        if (action == add) {
+            this->attached(name);
+        } else if (action == remove) {
+            this->detached(name);
+        }
+    }
+}
+
+
+/*
+ * benchlab_hotplug_monitor::resync
+ */
+void benchlab_hotplug_monitor::resync(_In_ const bool report) noexcept {
+    std::vector<std::string> ports;
+    std::set<std::string> current;
+
+    try {
+        if (FAILED(benchlab_device::ports(std::back_inserter(ports)))) {
+            _benchlab_debug("Enumerating the attached devices failed.\r\n");
+            return;
+        }
+
+        for (auto& p : ports) {
+            current.insert(p.substr(p.find_last_of('/') + 1));
+        }
+    } catch (std::bad_alloc&) {
+        return;
+    }
+
+    // Copy the known devices, because reporting them modifies the set.
+    const auto known = this->_known;
+    for (auto& k : known) {
+        if (current.find(k) == current.end()) {
+            this->detached(k);
+        }
+    }
+
+    for (auto& c : current) {
+        if (report) {
+            this->attached(c);
+        } else {
+            this->_known.insert(c);
+        }
+    }
+}
+#endif /* !defined(_WIN32) */
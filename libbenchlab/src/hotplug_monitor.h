@@ -0,0 +1,155 @@
+﻿// <copyright file="hotplug_monitor.h" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#if !defined(_BENCHLAB_HOTPLUG_MONITOR_H)
+#define _BENCHLAB_HOTPLUG_MONITOR_H
+#pragma once
+
+#include <chrono>
+#include <set>
+#include <string>
+#include <thread>
+
+#include "libbenchlab/hotplug.h"
+#include "libbenchlab/serial.h"
+
+
+/// <summary>
+/// Watches for Benchlab devices being attached to or detached from the local
+/// machine on a background thread.
+/// </summary>
+struct LIBBENCHLAB_TEST_API benchlab_hotplug_monitor final {
+
+public:
+
+    /// <summary>
+    /// Initialises a new instance.
+    /// </summary>
+    benchlab_hotplug_monitor(void) noexcept;
+
+    benchlab_hotplug_monitor(const benchlab_hotplug_monitor&) = delete;
+
+    /// <summary>
+    /// Finalises the instance, which stops the monitor if it is running.
+    /// </summary>
+    ~benchlab_hotplug_monitor(void) noexcept;
+
+    /// <summary>
+    /// Starts the monitor thread.
+    /// </summary>
+    /// <param name="config">The configuration of the monitor, which must be
+    /// valid and have a callback.</param>
+    /// <returns><c>S_OK</c> in case of success, <c>E_NOT_VALID_STATE</c> if
+    /// the monitor is already running, <c>E_NOTIMPL</c> on Windows, or
+    /// another error code if the monitor could not be started.</returns>
+    HRESULT start(_In_ const benchlab_hotplug_configuration& config) noexcept;
+
+    /// <summary>
+    /// Stops the monitor thread and waits for it to exit.
+    /// </summary>
+    /// <returns><c>S_OK</c>, unconditionally.</returns>
+    HRESULT stop(void) noexcept;
+
+    benchlab_hotplug_monitor& operator =(
+        const benchlab_hotplug_monitor&) = delete;
+
+private:
+
+#if !defined(_WIN32)
+    /// <summary>
+    /// The number of times the monitor tries to open a device that has just
+    /// been attached, which might not yet be accessible until udev has
+    /// finished setting it up.
+    /// </summary>
+    static constexpr std::size_t max_open_attempts = 10;
+
+    /// <summary>
+    /// The time between two attempts to open a new device.
+    /// </summary>
+    static constexpr std::chrono::milliseconds open_retry_delay
+        = std::chrono::milliseconds(100);
+
+    /// <summary>
+    /// Parses a kernel uevent and extracts the action and the name of a tty
+    /// that has been added or removed.
+    /// </summary>
+    /// <returns><c>true</c> if the event is about a tty and
+    /// <paramref name="action" /> and <paramref name="name" /> have been set,
+    /// <c>false</c> if the event should be ignored.</returns>
+    static bool parse_uevent(_Out_ std::string& action,
+        _Out_ std::string& name,
+        _In_reads_bytes_(cnt) const char *data,
+        _In_ const std::size_t cnt);
+
+    /// <summary>
+    /// Handles the tty <paramref name="name" /> having been created.
+    /// </summary>
+    void attached(_In_ const std::string& name) noexcept;
+
+    /// <summary>
+    /// Sleeps for <paramref name="timeout" /> or until the monitor is being
+    /// stopped.
+    /// </summary>
+    /// <returns><c>true</c> if the monitor is being stopped, <c>false</c> if
+    /// the timeout expired.</returns>
+    bool cancelled(_In_ const std::chrono::milliseconds timeout) noexcept;
+
+    /// <summary>
+    /// Handles the tty <paramref name="name" /> having been removed.
+    /// </summary>
+    void detached(_In_ const std::string& name) noexcept;
+
+    /// <summary>
+    /// Sets up <see cref="_events" /> to watch <c>/dev</c>.
+    /// </summary>
+    HRESULT listen_inotify(void) noexcept;
+
+    /// <summary>
+    /// Sets up <see cref="_events" /> to receive kernel uevents.
+    /// </summary>
+    HRESULT listen_netlink(void) noexcept;
+
+    /// <summary>
+    /// The body of the monitor thread.
+    /// </summary>
+    void monitor(_In_ const bool report_existing) noexcept;
+
+    /// <summary>
+    /// Processes all pending events from the inotify instance.
+    /// </summary>
+    void process_inotify(void) noexcept;
+
+    /// <summary>
+    /// Processes all pending kernel uevents.
+    /// </summary>
+    void process_netlink(void) noexcept;
+
+    /// <summary>
+    /// Compares the <see cref="_known" /> devices with the ones currently
+    /// attached and reports the differences if <paramref name="report" /> is
+    /// set.
+    /// </summary>
+    /// <remarks>
+    /// This is used to initialise the monitor and to recover from lost
+    /// events.
+    /// </remarks>
+    void resync(_In_ const bool report) noexcept;
+#endif /* !defined(_WIN32) */
+
+    benchlab_hotplug_callback _callback;
+    void *_context;
+    bool _open_devices;
+    benchlab_serial_configuration _serial;
+    std::thread _thread;
+#if !defined(_WIN32)
+    int _cancel;
+    int _events;
+    bool _inotify;
+    std::set<std::string> _known;
+#endif /* !defined(_WIN32) */
+};
+
+#endif /* !defined(_BENCHLAB_HOTPLUG_MONITOR_H) */
@@ -137,9 +137,9 @@ inline void get_file_system_entries(_In_ TIterator oit,
         _In_ const bool is_recursive = false) {
 #if defined(_WIN32)
     typedef WIN32_FIND_DATAW file_system_entry;
-#else defined(_WIN32)
+#else /* defined(_WIN32) */
     typedef struct dirent file_system_entry;
-#endif defined(_WIN32)
+#endif /* defined(_WIN32) */
 
     ::get_file_system_entries(oit, path, is_recursive,
         [](const file_system_entry&) { return true; });
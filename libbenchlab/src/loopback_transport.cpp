@@ -0,0 +1,38 @@
+﻿// <copyright file="loopback_transport.cpp" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#include "loopback_transport.h"
+
+#include <cassert>
+
+
+/*
+ * loopback_transport::loopback_transport
+ */
+loopback_transport::loopback_transport(
+        _In_opt_ const benchlab_loopback_handler handler,
+        _In_opt_ void *context) noexcept
+    : _context(context), _handler(handler) { }
+
+
+/*
+ * loopback_transport::write
+ */
+HRESULT loopback_transport::write(_In_reads_bytes_(cnt) const void *data,
+        _In_ const std::size_t cnt) noexcept {
+    assert(data != nullptr);
+
+    if (!this->is_open()) {
+        return closed_error();
+    }
+
+    if (this->_handler != nullptr) {
+        this->_handler(this, data, cnt, this->_context);
+        return S_OK;
+    } else {
+        return this->push(data, cnt);
+    }
+}
@@ -0,0 +1,43 @@
+﻿// <copyright file="loopback_transport.h" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#if !defined(_BENCHLAB_LOOPBACK_TRANSPORT_H)
+#define _BENCHLAB_LOOPBACK_TRANSPORT_H
+#pragma once
+
+#include "memory_transport.h"
+
+
+/// <summary>
+/// A transport that passes all commands to a user-defined handler, which
+/// emulates the device in the same process.
+/// </summary>
+class LIBBENCHLAB_TEST_API loopback_transport final
+        : public memory_transport {
+
+public:
+
+    /// <summary>
+    /// Initialises a new instance.
+    /// </summary>
+    /// <param name="handler">The handler to receive all data written to the
+    /// transport. If <c>nullptr</c>, the data are echoed.</param>
+    /// <param name="context">A user-defined pointer to be passed to the
+    /// <paramref name="handler" />.</param>
+    loopback_transport(_In_opt_ const benchlab_loopback_handler handler,
+        _In_opt_ void *context) noexcept;
+
+    /// <inheritdoc />
+    HRESULT write(_In_reads_bytes_(cnt) const void *data,
+        _In_ const std::size_t cnt) noexcept override;
+
+private:
+
+    void *_context;
+    benchlab_loopback_handler _handler;
+};
+
+#endif /* !defined(_BENCHLAB_LOOPBACK_TRANSPORT_H) */
@@ -4,7 +4,7 @@
 // </copyright>
 // <author>Christoph Müller</author>
 
-#if defined(_WIN32)
+#if (defined(_WIN32) && !defined(LIBBENCHLAB_STATIC))
 #include <Windows.h>
 
 
@@ -27,4 +27,4 @@ BOOL WINAPI DllMain(HINSTANCE handle, DWORD reason, LPVOID reserved) {
 
     return TRUE;
 }
-#endif /* defined(_WIN32) */
+#endif /* (defined(_WIN32) && !defined(LIBBENCHLAB_STATIC)) */
@@ -0,0 +1,133 @@
+﻿// <copyright file="memory_transport.cpp" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#include "memory_transport.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+
+/*
+ * memory_transport::memory_transport
+ */
+memory_transport::memory_transport(void) noexcept
+    : _closed(false), _offset(0) { }
+
+
+/*
+ * memory_transport::available
+ */
+HRESULT memory_transport::available(_Out_ std::size_t& cnt) noexcept {
+    std::lock_guard<decltype(this->_lock)> l(this->_lock);
+
+    if (this->_closed) {
+        cnt = 0;
+        return closed_error();
+    }
+
+    cnt = this->_input.size() - this->_offset;
+    return S_OK;
+}
+
+
+/*
+ * memory_transport::close
+ */
+HRESULT memory_transport::close(void) noexcept {
+    {
+        std::lock_guard<decltype(this->_lock)> l(this->_lock);
+        this->_closed = true;
+    }
+
+    this->_cv.notify_all();
+    return S_OK;
+}
+
+
+/*
+ * memory_transport::is_open
+ */
+bool memory_transport::is_open(void) const noexcept {
+    std::lock_guard<decltype(this->_lock)> l(this->_lock);
+    return !this->_closed;
+}
+
+
+/*
+ * memory_transport::push
+ */
+HRESULT memory_transport::push(_In_reads_bytes_(cnt) const void *data,
+        _In_ const std::size_t cnt) noexcept {
+    assert((data != nullptr) || (cnt == 0));
+    auto src = static_cast<const std::uint8_t *>(data);
+
+    {
+        std::lock_guard<decltype(this->_lock)> l(this->_lock);
+        if (this->_closed) {
+            return closed_error();
+        }
+
+        try {
+            this->_input.insert(this->_input.end(), src, src + cnt);
+        } catch (std::bad_alloc&) {
+            return E_OUTOFMEMORY;
+        }
+    }
+
+    this->_cv.notify_all();
+    return S_OK;
+}
+
+
+/*
+ * memory_transport::read
+ */
+HRESULT memory_transport::read(_Out_writes_bytes_(cnt) void *dst,
+        _Inout_ std::size_t& cnt) noexcept {
+    assert(dst != nullptr);
+    std::lock_guard<decltype(this->_lock)> l(this->_lock);
+
+    if (this->_closed) {
+        cnt = 0;
+        return closed_error();
+    }
+
+    assert(this->_offset <= this->_input.size());
+    cnt = (std::min)(cnt, this->_input.size() - this->_offset);
+    if (cnt > 0) {
+        std::memcpy(dst, this->_input.data() + this->_offset, cnt);
+        this->_offset += cnt;
+    }
+
+    // Rewind once everything has been consumed, which is the normal case for
+    // request-response traffic, so the buffer does not grow indefinitely.
+    if (this->_offset == this->_input.size()) {
+        this->_input.clear();
+        this->_offset = 0;
+    }
+
+    return S_OK;
+}
+
+
+/*
+ * memory_transport::wait
+ */
+HRESULT memory_transport::wait(
+        _In_ const clock_type::time_point deadline) noexcept {
+    std::unique_lock<decltype(this->_lock)> l(this->_lock);
+
+    const auto ready = this->_cv.wait_until(l, deadline, [this](void) {
+        return (this->_closed || (this->_offset < this->_input.size()));
+    });
+
+    if (this->_closed) {
+        return closed_error();
+    }
+
+    return ready ? S_OK : timeout_error();
+}
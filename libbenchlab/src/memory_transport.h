@@ -0,0 +1,83 @@
+﻿// <copyright file="memory_transport.h" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#if !defined(_BENCHLAB_MEMORY_TRANSPORT_H)
+#define _BENCHLAB_MEMORY_TRANSPORT_H
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+#include "benchlab_transport.h"
+
+
+/// <summary>
+/// The base class for transports that deliver their input from memory rather
+/// than from the operating system.
+/// </summary>
+/// <remarks>
+/// Subclasses only need to decide what happens with the data written to the
+/// transport and call <see cref="push" /> to make a response available to the
+/// reader.
+/// </remarks>
+class LIBBENCHLAB_TEST_API memory_transport : public benchlab_transport {
+
+public:
+
+    /// <summary>
+    /// Initialises a new instance.
+    /// </summary>
+    memory_transport(void) noexcept;
+
+    memory_transport(const memory_transport&) = delete;
+
+    /// <summary>
+    /// Finalises the instance.
+    /// </summary>
+    virtual ~memory_transport(void) noexcept = default;
+
+    /// <inheritdoc />
+    HRESULT available(_Out_ std::size_t& cnt) noexcept override;
+
+    /// <inheritdoc />
+    HRESULT close(void) noexcept override;
+
+    /// <inheritdoc />
+    bool is_open(void) const noexcept override;
+
+    /// <summary>
+    /// Appends <paramref name="cnt" /> bytes to the input of the transport
+    /// and wakes any thread waiting for it.
+    /// </summary>
+    /// <param name="data">A pointer to at least <paramref name="cnt" />
+    /// bytes of valid data.</param>
+    /// <param name="cnt">The number of bytes to append.</param>
+    /// <returns><c>S_OK</c> in case of success, <c>E_OUTOFMEMORY</c> if
+    /// the input could not be enlarged, or an error if the transport has
+    /// been closed.</returns>
+    HRESULT push(_In_reads_bytes_(cnt) const void *data,
+        _In_ const std::size_t cnt) noexcept;
+
+    /// <inheritdoc />
+    HRESULT read(_Out_writes_bytes_(cnt) void *dst,
+        _Inout_ std::size_t& cnt) noexcept override;
+
+    /// <inheritdoc />
+    HRESULT wait(_In_ const clock_type::time_point deadline) noexcept override;
+
+    memory_transport& operator =(const memory_transport&) = delete;
+
+private:
+
+    std::condition_variable _cv;
+    bool _closed;
+    std::vector<std::uint8_t> _input;
+    mutable std::mutex _lock;
+    std::size_t _offset;
+};
+
+#endif /* !defined(_BENCHLAB_MEMORY_TRANSPORT_H) */
@@ -0,0 +1,30 @@
+﻿// <copyright file="probe.cpp" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#include "libbenchlab/probe.h"
+
+
+/*
+ * ::benchlab_initialise_probe_configuration
+ */
+HRESULT LIBBENCHLAB_API benchlab_initialise_probe_configuration(
+        _In_ benchlab_probe_configuration *config) {
+    if (config == nullptr) {
+        return E_POINTER;
+    }
+
+    switch (config->version) {
+        case 1:
+            config->callback = nullptr;
+            config->context = nullptr;
+            config->serial_configuration = nullptr;
+            config->timeout = 1000;
+            return S_OK;
+
+        default:
+            return E_INVALIDARG;
+    }
+}
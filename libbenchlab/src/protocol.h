@@ -0,0 +1,62 @@
+﻿// <copyright file="protocol.h" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2024 - 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#if !defined(_BENCHLAB_PROTOCOL_H)
+#define _BENCHLAB_PROTOCOL_H
+#pragma once
+
+#include <cinttypes>
+
+
+/// <summary>
+/// The USB vendor ID of the Benchlab.
+/// </summary>
+constexpr std::uint16_t benchlab_vendor_id = 0x0483;
+
+
+/// <summary>
+/// The USB product ID of the Benchlab.
+/// </summary>
+constexpr std::uint16_t benchlab_product_id = 0x5740;
+
+
+/// <summary>
+/// The types of actions that can be triggered via
+/// <see cref="benchlab_command::action" />.
+/// </summary>
+enum class benchlab_action : std::uint8_t {
+    none = 0,
+    button
+};
+
+
+/// <summary>
+/// The commands understood by the firmware of the device.
+/// </summary>
+/// <remarks>
+/// Each command is a single byte, which is followed by the parameters of the
+/// command, if any. The response, if any, is the raw memory of the
+/// corresponding structure from <c>libbenchlab/types.h</c>.
+/// </remarks>
+enum class benchlab_command : std::uint8_t {
+    welcome = 0,
+    read_sensors,
+    action,
+    read_name,
+    write_name,
+    read_fan_profile,
+    write_fan_profile,
+    read_rgb,
+    write_rgb,
+    read_calibration,
+    write_calibration,
+    load_calibration,
+    store_calibration,
+    read_uid,
+    read_vendor_data,
+};
+
+#endif /* !defined(_BENCHLAB_PROTOCOL_H) */
@@ -0,0 +1,45 @@
+﻿// <copyright file="pty_transport.cpp" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#include "pty_transport.h"
+
+#include <cassert>
+
+#include "debug.h"
+
+
+#if !defined(_WIN32)
+/*
+ * pty_transport::configure
+ */
+HRESULT pty_transport::configure(
+        _In_ const benchlab_serial_configuration *config) noexcept {
+    assert(config != nullptr);
+    struct termios tio;
+
+    if (::tcgetattr(this->handle(), &tio) != 0) {
+        auto retval = static_cast<HRESULT>(-errno);
+        _benchlab_debug("Retrieving state of pseudo-terminal failed.\r\n");
+        return retval;
+    }
+
+    // Without raw mode, the line discipline would translate or swallow some
+    // of the binary bytes of the protocol.
+    ::cfmakeraw(&tio);
+    tio.c_cc[VMIN] = 0;
+    tio.c_cc[VTIME] = 0;
+
+    if (::tcsetattr(this->handle(), TCSANOW, &tio) != 0) {
+        auto retval = static_cast<HRESULT>(-errno);
+        _benchlab_debug("Updating state of pseudo-terminal failed.\r\n");
+        return retval;
+    }
+
+    ::tcflush(this->handle(), TCIOFLUSH);
+
+    return S_OK;
+}
+#endif /* !defined(_WIN32) */
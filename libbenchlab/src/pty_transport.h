@@ -0,0 +1,34 @@
+﻿// <copyright file="pty_transport.h" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#if !defined(_BENCHLAB_PTY_TRANSPORT_H)
+#define _BENCHLAB_PTY_TRANSPORT_H
+#pragma once
+
+#include "serial_transport.h"
+
+
+#if !defined(_WIN32)
+/// <summary>
+/// Implements the <see cref="benchlab_transport" /> for the subordinate side
+/// of a pseudo-terminal, which is how emulated devices are connected.
+/// </summary>
+/// <remarks>
+/// A pseudo-terminal has no line settings and no modem control lines, so
+/// this transport only puts the terminal in raw mode and ignores the baud
+/// rate, the parity and the handshake of the configuration.
+/// </remarks>
+class LIBBENCHLAB_TEST_API pty_transport final : public serial_transport {
+
+protected:
+
+    /// <inheritdoc />
+    HRESULT configure(
+        _In_ const benchlab_serial_configuration *config) noexcept override;
+};
+#endif /* !defined(_WIN32) */
+
+#endif /* !defined(_BENCHLAB_PTY_TRANSPORT_H) */
@@ -0,0 +1,85 @@
+﻿// <copyright file="reactor.cpp" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#include "libbenchlab/reactor.h"
+
+#include <memory>
+#include <new>
+
+#include "benchlab_reactor.h"
+#include "debug.h"
+
+
+/*
+ * ::benchlab_initialise_reactor_configuration
+ */
+HRESULT LIBBENCHLAB_API benchlab_initialise_reactor_configuration(
+        _In_ benchlab_reactor_configuration *config) {
+    if (config == nullptr) {
+        return E_POINTER;
+    }
+
+    switch (config->version) {
+        case 1:
+            config->threads = 1;
+            return S_OK;
+
+        default:
+            return E_INVALIDARG;
+    }
+}
+
+
+/*
+ * ::benchlab_create_reactor
+ */
+HRESULT LIBBENCHLAB_API benchlab_create_reactor(
+        _Out_ benchlab_reactor_handle *out_reactor,
+        _In_opt_ const benchlab_reactor_configuration *config) {
+    if (out_reactor == nullptr) {
+        _benchlab_debug("Invalid storage location for reactor provided.\r\n");
+        return E_POINTER;
+    }
+
+    *out_reactor = nullptr;
+
+    benchlab_reactor_configuration default_config;
+    if (config == nullptr) {
+        default_config.version = 1;
+        ::benchlab_initialise_reactor_configuration(&default_config);
+        config = &default_config;
+    }
+
+    if ((config->version != 1) || (config->threads < 1)) {
+        _benchlab_debug("Invalid reactor configuration provided.\r\n");
+        return E_INVALIDARG;
+    }
+
+    std::unique_ptr<benchlab_reactor> reactor(
+        new (std::nothrow) benchlab_reactor());
+    if (reactor == nullptr) {
+        _benchlab_debug("Insufficient memory for reactor.\r\n");
+        return E_OUTOFMEMORY;
+    }
+
+    auto hr = reactor->start(*config);
+    if (SUCCEEDED(hr)) {
+        *out_reactor = reactor.release();
+    }
+
+    return hr;
+}
+
+
+/*
+ * ::benchlab_destroy_reactor
+ */
+HRESULT LIBBENCHLAB_API benchlab_destroy_reactor(
+        _In_opt_ benchlab_reactor_handle reactor) {
+    // The destructor stops all threads of the reactor.
+    delete reactor;
+    return S_OK;
+}
@@ -0,0 +1,449 @@
+﻿// <copyright file="reactor_loop.cpp" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#include "reactor_loop.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cerrno>
+#include <new>
+#include <system_error>
+
+#if !defined(_WIN32)
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif /* !defined(_WIN32) */
+
+#include "debug.h"
+#include "device.h"
+
+
+/*
+ * reactor_loop::reactor_loop
+ */
+reactor_loop::reactor_loop(void) noexcept
+    : _epoll(-1), _load(0), _reap(false), _stopping(false), _wake(-1) { }
+
+
+/*
+ * reactor_loop::~reactor_loop
+ */
+reactor_loop::~reactor_loop(void) noexcept {
+    this->stop();
+}
+
+
+/*
+ * reactor_loop::attach
+ */
+HRESULT reactor_loop::attach(_In_ benchlab_device& device,
+        _In_ const benchlab_streaming_configuration& config) noexcept {
+#if defined(_WIN32)
+    return E_NOTIMPL;
+
+#else /* defined(_WIN32) */
+    std::unique_ptr<session> s(new (std::nothrow) session(device, config,
+        clock_type::now()));
+    if (s == nullptr) {
+        _benchlab_debug("Insufficient memory for reactor session.\r\n");
+        return E_OUTOFMEMORY;
+    }
+
+    if (s->state.descriptor() == -1) {
+        _benchlab_debug("The transport of the device cannot be used in a "
+            "reactor.\r\n");
+        return E_NOTIMPL;
+    }
+
+    {
+        std::lock_guard<std::mutex> l(this->_lock);
+        if ((this->_epoll == -1) || this->_stopping) {
+            _benchlab_debug("The reactor is not running.\r\n");
+            return E_NOT_VALID_STATE;
+        }
+
+        this->_commands.push_back(command { &device, std::move(s) });
+        this->_load.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    this->wake();
+    return S_OK;
+#endif /* defined(_WIN32) */
+}
+
+
+/*
+ * reactor_loop::detach
+ */
+void reactor_loop::detach(_In_ benchlab_device& device) noexcept {
+    // If we are called from a callback, the session can only finish after
+    // we returned, so we must not wait for it.
+    if (std::this_thread::get_id() == this->_thread.get_id()) {
+        this->halt(device);
+        return;
+    }
+
+    std::unique_lock<std::mutex> l(this->_lock);
+    this->_commands.push_back(command { &device, nullptr });
+    this->wake();
+
+    this->_cv.wait(l, [&device](void) {
+        return (device._state.load(std::memory_order::memory_order_acquire)
+            == stream_state::stopped);
+    });
+}
+
+
+/*
+ * reactor_loop::start
+ */
+HRESULT reactor_loop::start(void) noexcept {
+#if defined(_WIN32)
+    return E_NOTIMPL;
+
+#else /* defined(_WIN32) */
+    if (this->_thread.joinable()) {
+        _benchlab_debug("The reactor is already running.\r\n");
+        return E_NOT_VALID_STATE;
+    }
+
+    this->_stopping = false;
+
+    this->_epoll = ::epoll_create1(EPOLL_CLOEXEC);
+    if (this->_epoll == -1) {
+        auto retval = static_cast<HRESULT>(-errno);
+        _benchlab_debug("Creating the epoll instance failed.\r\n");
+        return retval;
+    }
+
+    auto hr = S_OK;
+
+    this->_wake = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (this->_wake == -1) {
+        hr = static_cast<HRESULT>(-errno);
+        _benchlab_debug("Creating the wake-up event failed.\r\n");
+    }
+
+    if (SUCCEEDED(hr)) {
+        // The wake-up event is the only one without a session.
+        epoll_event event { };
+        event.events = EPOLLIN;
+        event.data.ptr = nullptr;
+        if (::epoll_ctl(this->_epoll, EPOLL_CTL_ADD, this->_wake, &event)
+                == -1) {
+            hr = static_cast<HRESULT>(-errno);
+            _benchlab_debug("Registering the wake-up event failed.\r\n");
+        }
+    }
+
+    if (SUCCEEDED(hr)) {
+        try {
+            this->_thread = std::thread(&reactor_loop::run, this);
+        } catch (std::system_error& ex) {
+            hr = static_cast<HRESULT>(-ex.code().value());
+        }
+    }
+
+    if (FAILED(hr)) {
+        this->stop();
+    }
+
+    return hr;
+#endif /* defined(_WIN32) */
+}
+
+
+/*
+ * reactor_loop::stop
+ */
+void reactor_loop::stop(void) noexcept {
+#if !defined(_WIN32)
+    if (this->_thread.joinable()) {
+        {
+            std::lock_guard<std::mutex> l(this->_lock);
+            this->_stopping = true;
+        }
+
+        this->wake();
+        this->_thread.join();
+    }
+
+    if (this->_wake != -1) {
+        ::close(this->_wake);
+        this->_wake = -1;
+    }
+
+    std::lock_guard<std::mutex> l(this->_lock);
+    if (this->_epoll != -1) {
+        ::close(this->_epoll);
+        this->_epoll = -1;
+    }
+#endif /* !defined(_WIN32) */
+}
+
+
+/*
+ * reactor_loop::dispatch
+ */
+void reactor_loop::dispatch(_In_ const clock_type::time_point now) noexcept {
+#if !defined(_WIN32)
+    std::uint64_t value;
+    auto status = ::read(this->_wake, &value, sizeof(value));
+    static_cast<void>(status);
+
+    std::vector<command> commands;
+    bool stopping;
+
+    {
+        std::lock_guard<std::mutex> l(this->_lock);
+        commands.swap(this->_commands);
+        stopping = this->_stopping;
+    }
+
+    for (auto& c : commands) {
+        if (c.attach == nullptr) {
+            this->halt(*c.device);
+            continue;
+        }
+
+        auto& s = *c.attach;
+        this->_sessions.push_back(std::move(c.attach));
+
+        epoll_event event { };
+        event.events = EPOLLIN;
+        event.data.ptr = &s;
+        if (::epoll_ctl(this->_epoll, EPOLL_CTL_ADD, s.state.descriptor(),
+                &event) == -1) {
+            _benchlab_debug("Registering a device with the reactor "
+                "failed.\r\n");
+            s.state.abort();
+        }
+
+        // The first sample is due right away.
+        this->step(s, now);
+    }
+
+    // When the whole loop is stopped, all of its devices stop as well. Each
+    // of them finishes once it is safe to do so.
+    if (stopping) {
+        for (auto& s : this->_sessions) {
+            s->state.stop();
+            this->_wheel.schedule(*s, s->state.next_wakeup());
+        }
+    }
+#endif /* !defined(_WIN32) */
+}
+
+
+/*
+ * reactor_loop::halt
+ */
+void reactor_loop::halt(_In_ benchlab_device& device) noexcept {
+    auto it = std::find_if(this->_sessions.begin(), this->_sessions.end(),
+        [&device](const std::unique_ptr<session>& s) {
+            return (&s->state.device() == &device);
+    });
+
+    if (it != this->_sessions.end()) {
+        auto& s = **it;
+        s.state.stop();
+        if (!s.state.finished()) {
+            this->_wheel.schedule(s, s.state.next_wakeup());
+        }
+    }
+}
+
+
+/*
+ * reactor_loop::process
+ */
+HRESULT reactor_loop::process(
+        _In_ const std::chrono::milliseconds timeout) noexcept {
+#if defined(_WIN32)
+    return E_NOTIMPL;
+
+#else /* defined(_WIN32) */
+    using namespace std::chrono;
+
+    // Wait until the next timer expires. We round up, because waking up
+    // early would only make us wait again.
+    auto wait = timeout;
+    {
+        const auto next = this->_wheel.next_expiry();
+        const auto now = clock_type::now();
+        if (next <= now) {
+            wait = milliseconds::zero();
+
+        } else if (next != (clock_type::time_point::max)()) {
+            const auto dt = duration_cast<milliseconds>(next - now
+                + milliseconds(1) - nanoseconds(1));
+            if ((wait < milliseconds::zero()) || (dt < wait)) {
+                wait = dt;
+            }
+        }
+    }
+
+    std::array<epoll_event, max_events> events;
+    auto cnt = ::epoll_wait(this->_epoll, events.data(),
+        static_cast<int>(events.size()), static_cast<int>(wait.count()));
+    if (cnt == -1) {
+        if (errno == EINTR) {
+            return S_OK;
+        }
+
+        auto retval = static_cast<HRESULT>(-errno);
+        _benchlab_debug("Waiting for events in the reactor failed.\r\n");
+        return retval;
+    }
+
+    const auto now = clock_type::now();
+
+    for (int i = 0; i < cnt; ++i) {
+        auto s = static_cast<session *>(events[i].data.ptr);
+
+        if (s == nullptr) {
+            this->dispatch(now);
+            continue;
+        }
+
+        // If the device has been unplugged, we get a hang-up without any
+        // data, which would be reported over and over again.
+        if (((events[i].events & EPOLLIN) == 0)
+                && ((events[i].events & (EPOLLERR | EPOLLHUP)) != 0)) {
+            _benchlab_debug("A device in the reactor was hung up.\r\n");
+            s->state.abort();
+        }
+
+        this->step(*s, now);
+    }
+
+    this->_wheel.expire(now, [this, now](timer_wheel_entry& e) {
+        this->step(static_cast<session&>(e), now);
+    });
+
+    this->reap();
+    return S_OK;
+#endif /* defined(_WIN32) */
+}
+
+
+/*
+ * reactor_loop::reap
+ */
+void reactor_loop::reap(void) noexcept {
+#if !defined(_WIN32)
+    if (!this->_reap) {
+        return;
+    }
+
+    this->_reap = false;
+
+    auto it = std::stable_partition(this->_sessions.begin(),
+        this->_sessions.end(), [](const std::unique_ptr<session>& s) {
+            return !s->state.finished();
+    });
+
+    for (auto jt = it; jt != this->_sessions.end(); ++jt) {
+        auto& s = **jt;
+        auto& device = s.state.device();
+        this->_wheel.cancel(s);
+
+        // The descriptor must be removed before the device is marked as
+        // stopped, because the owner might close it right afterwards.
+        ::epoll_ctl(this->_epoll, EPOLL_CTL_DEL, s.state.descriptor(),
+            nullptr);
+        this->_load.fetch_sub(1, std::memory_order_relaxed);
+
+        {
+            std::lock_guard<std::mutex> l(this->_lock);
+            device.stopped();
+        }
+    }
+
+    if (it != this->_sessions.end()) {
+        this->_sessions.erase(it, this->_sessions.end());
+        this->_cv.notify_all();
+    }
+#endif /* !defined(_WIN32) */
+}
+
+
+/*
+ * reactor_loop::run
+ */
+void reactor_loop::run(void) noexcept {
+    while (true) {
+        auto hr = this->process(std::chrono::milliseconds(-1));
+        if (FAILED(hr)) {
+            break;
+        }
+
+        std::lock_guard<std::mutex> l(this->_lock);
+        if (this->_stopping && this->_commands.empty()
+                && this->_sessions.empty()) {
+            return;
+        }
+    }
+
+    // If the loop itself failed, we cannot keep the promise of delivering
+    // samples, so we abort all sessions including the ones that have not yet
+    // been attached.
+    {
+        std::lock_guard<std::mutex> l(this->_lock);
+        this->_stopping = true;
+
+        for (auto& c : this->_commands) {
+            if (c.attach != nullptr) {
+                this->_sessions.push_back(std::move(c.attach));
+            }
+        }
+
+        this->_commands.clear();
+    }
+
+    for (auto& s : this->_sessions) {
+        s->state.abort();
+    }
+
+    this->_reap = true;
+    this->reap();
+}
+
+
+/*
+ * reactor_loop::step
+ */
+void reactor_loop::step(_Inout_ session& session,
+        _In_ const clock_type::time_point now) noexcept {
+    if (!session.state.finished()) {
+        auto hr = session.state.process(now);
+        if (FAILED(hr)) {
+            _benchlab_debug("A device in the reactor stopped due to an "
+                "error.\r\n");
+        }
+    }
+
+    if (session.state.finished()) {
+        this->_wheel.cancel(session);
+        this->_reap = true;
+    } else {
+        this->_wheel.schedule(session, session.state.next_wakeup());
+    }
+}
+
+
+/*
+ * reactor_loop::wake
+ */
+void reactor_loop::wake(void) noexcept {
+#if !defined(_WIN32)
+    const std::uint64_t one = 1;
+    auto status = ::write(this->_wake, &one, sizeof(one));
+    static_cast<void>(status);
+#endif /* !defined(_WIN32) */
+}
@@ -0,0 +1,194 @@
+﻿// <copyright file="reactor_loop.h" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#if !defined(_BENCHLAB_REACTOR_LOOP_H)
+#define _BENCHLAB_REACTOR_LOOP_H
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "libbenchlab/streaming.h"
+
+#include "acquisition.h"
+#include "timer_wheel.h"
+
+
+/* Forward declarations. */
+struct benchlab_device;
+
+
+/// <summary>
+/// An event loop that acquires samples from any number of devices on a
+/// single thread.
+/// </summary>
+/// <remarks>
+/// <para>The loop waits for the descriptors of all of its devices at once
+/// using epoll and schedules the requests of each device in a
+/// <see cref="timer_wheel" />. The per-device protocol is implemented by
+/// <see cref="acquisition" />.</para>
+/// <para>Devices are attached and detached from other threads by posting
+/// commands, which the loop picks up when it is woken via an eventfd. All
+/// state except for the command queue is only accessed by the thread running
+/// the loop.</para>
+/// </remarks>
+class LIBBENCHLAB_TEST_API reactor_loop final {
+
+public:
+
+    typedef acquisition::clock_type clock_type;
+
+    /// <summary>
+    /// Initialises a new instance.
+    /// </summary>
+    reactor_loop(void) noexcept;
+
+    reactor_loop(const reactor_loop&) = delete;
+
+    /// <summary>
+    /// Finalises the instance, which stops all devices and the thread of the
+    /// loop.
+    /// </summary>
+    ~reactor_loop(void) noexcept;
+
+    /// <summary>
+    /// Starts acquiring samples from <paramref name="device" />.
+    /// </summary>
+    /// <remarks>
+    /// The caller must have transitioned the device into the running state
+    /// before. If the device stops, the loop transitions it into the stopped
+    /// state.
+    /// </remarks>
+    /// <returns><c>S_OK</c> in case of success, <c>E_NOTIMPL</c> if the
+    /// transport of the device has no descriptor, or another error code if
+    /// the loop is not running.</returns>
+    HRESULT attach(_In_ benchlab_device& device,
+        _In_ const benchlab_streaming_configuration& config) noexcept;
+
+    /// <summary>
+    /// Stops acquiring samples from <paramref name="device" /> and waits
+    /// until the device has been transitioned into the stopped state.
+    /// </summary>
+    /// <remarks>
+    /// If this method is called from within a sample callback, it does not
+    /// wait, because the device can only be stopped once the callback has
+    /// returned.
+    /// </remarks>
+    void detach(_In_ benchlab_device& device) noexcept;
+
+    /// <summary>
+    /// Answer the number of devices attached to the loop.
+    /// </summary>
+    inline std::size_t load(void) const noexcept {
+        return this->_load.load(std::memory_order_relaxed);
+    }
+
+    /// <summary>
+    /// Creates the epoll instance and starts the thread of the loop.
+    /// </summary>
+    HRESULT start(void) noexcept;
+
+    /// <summary>
+    /// Stops all devices and waits for the thread of the loop to exit.
+    /// </summary>
+    void stop(void) noexcept;
+
+    reactor_loop& operator =(const reactor_loop&) = delete;
+
+private:
+
+    /// <summary>
+    /// The maximum number of events retrieved by a single call to
+    /// <c>epoll_wait</c>.
+    /// </summary>
+    static constexpr std::size_t max_events = 64;
+
+    /// <summary>
+    /// A device attached to the loop.
+    /// </summary>
+    struct session final : public timer_wheel_entry {
+        inline session(_In_ benchlab_device& device,
+                _In_ const benchlab_streaming_configuration& config,
+                _In_ const clock_type::time_point now) noexcept
+            : state(device, config, now) { }
+
+        acquisition state;
+    };
+
+    /// <summary>
+    /// A request from another thread to attach or detach a device.
+    /// </summary>
+    struct command final {
+        benchlab_device *device;
+        std::unique_ptr<session> attach;
+    };
+
+    /// <summary>
+    /// Performs the <see cref="_commands" /> posted by other threads.
+    /// </summary>
+    void dispatch(_In_ const clock_type::time_point now) noexcept;
+
+    /// <summary>
+    /// Stops the session of <paramref name="device" /> if it is attached.
+    /// </summary>
+    void halt(_In_ benchlab_device& device) noexcept;
+
+    /// <summary>
+    /// Waits for at most <paramref name="timeout" /> for events and handles
+    /// all events and timers that are due.
+    /// </summary>
+    /// <param name="timeout">The maximum time to wait if no timer expires
+    /// before, or a negative value for waiting indefinitely.</param>
+    /// <returns><c>S_OK</c> in case of success, an error code if waiting
+    /// failed.</returns>
+    HRESULT process(_In_ const std::chrono::milliseconds timeout) noexcept;
+
+    /// <summary>
+    /// Removes all sessions that have finished and marks their devices as
+    /// stopped.
+    /// </summary>
+    /// <remarks>
+    /// Sessions are only removed at the end of <see cref="process" />, such
+    /// that the events retrieved before never refer to a deleted session.
+    /// </remarks>
+    void reap(void) noexcept;
+
+    /// <summary>
+    /// The body of the thread of the loop.
+    /// </summary>
+    void run(void) noexcept;
+
+    /// <summary>
+    /// Advances the state machine of <paramref name="session" />.
+    /// </summary>
+    void step(_Inout_ session& session,
+        _In_ const clock_type::time_point now) noexcept;
+
+    /// <summary>
+    /// Wakes the thread of the loop.
+    /// </summary>
+    void wake(void) noexcept;
+
+    std::vector<command> _commands;
+    std::condition_variable _cv;
+    int _epoll;
+    std::atomic<std::size_t> _load;
+    std::mutex _lock;
+    bool _reap;
+    std::vector<std::unique_ptr<session>> _sessions;
+    bool _stopping;
+    std::thread _thread;
+    int _wake;
+    timer_wheel _wheel;
+};
+
+#endif /* !defined(_BENCHLAB_REACTOR_LOOP_H) */
@@ -0,0 +1,242 @@
+﻿// <copyright file="replay_transport.cpp" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#include "replay_transport.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <fstream>
+
+#include "capture_format.h"
+#include "debug.h"
+
+
+/*
+ * replay_transport::replay_transport
+ */
+replay_transport::replay_transport(
+        _In_ const benchlab_replay_mode mode) noexcept
+    : _mode(mode), _next(0), _preloaded(true),
+        _segment(clock_type::now()) { }
+
+
+/*
+ * replay_transport::available
+ */
+HRESULT replay_transport::available(_Out_ std::size_t& cnt) noexcept {
+    {
+        std::lock_guard<decltype(this->_lock)> l(this->_lock);
+        this->release(clock_type::now());
+    }
+
+    return memory_transport::available(cnt);
+}
+
+
+/*
+ * replay_transport::is_preloaded
+ */
+bool replay_transport::is_preloaded(void) const noexcept {
+    return this->_preloaded;
+}
+
+
+/*
+ * replay_transport::load
+ */
+HRESULT replay_transport::load(_In_z_ const benchlab_char *path) noexcept {
+    assert(path != nullptr);
+    std::ifstream file(path, std::ios::binary);
+
+    if (!file.is_open()) {
+        _benchlab_debug("Opening the recording failed.\r\n");
+        return HRESULT_FROM_WIN32(ERROR_FILE_NOT_FOUND);
+    }
+
+    std::array<std::uint8_t, capture_magic.size()> magic;
+    file.read(reinterpret_cast<char *>(magic.data()), magic.size());
+
+    if (file && (magic == capture_magic)) {
+        try {
+            std::lock_guard<decltype(this->_lock)> l(this->_lock);
+            auto retval = this->load_capture(file);
+            this->_preloaded = (this->_mode
+                != benchlab_replay_mode::recorded_speed);
+            this->_segment = clock_type::now();
+            return retval;
+        } catch (std::bad_alloc&) {
+            return E_OUTOFMEMORY;
+        }
+
+    } else {
+        file.clear();
+        file.seekg(0);
+        return this->load_raw(file);
+    }
+}
+
+
+/*
+ * replay_transport::read
+ */
+HRESULT replay_transport::read(_Out_writes_bytes_(cnt) void *dst,
+        _Inout_ std::size_t& cnt) noexcept {
+    {
+        std::lock_guard<decltype(this->_lock)> l(this->_lock);
+        this->release(clock_type::now());
+    }
+
+    return memory_transport::read(dst, cnt);
+}
+
+
+/*
+ * replay_transport::wait
+ */
+HRESULT replay_transport::wait(
+        _In_ const clock_type::time_point deadline) noexcept {
+    while (true) {
+        clock_type::time_point due;
+        {
+            std::lock_guard<decltype(this->_lock)> l(this->_lock);
+            due = this->release(clock_type::now());
+        }
+
+        // Wake up if the next chunk becomes due before the caller's deadline.
+        // Timing out on such an intermediate wake-up is not an error, but we
+        // need to release the chunk and go on waiting.
+        auto hr = memory_transport::wait((std::min)(deadline, due));
+        if ((hr != timeout_error()) || (due >= deadline)) {
+            return hr;
+        }
+    }
+}
+
+
+/*
+ * replay_transport::write
+ */
+HRESULT replay_transport::write(_In_ const void *data,
+        _In_ const std::size_t) noexcept {
+    assert(data != nullptr);
+
+    if (!this->is_open()) {
+        return closed_error();
+    }
+
+    // The responses are already in the recording, so there is nothing to do
+    // with the commands except for starting the next segment of a timed
+    // capture. Anything left from the previous segment becomes due at once.
+    std::lock_guard<decltype(this->_lock)> l(this->_lock);
+    this->release((clock_type::time_point::max)());
+
+    if ((this->_next < this->_chunks.size())
+            && this->_chunks[this->_next].sent) {
+        ++this->_next;
+        this->_segment = clock_type::now();
+    }
+
+    return S_OK;
+}
+
+
+/*
+ * replay_transport::load_capture
+ */
+HRESULT replay_transport::load_capture(_Inout_ std::istream& file) {
+    using namespace std::chrono;
+    std::array<std::uint8_t, capture_record::serialised_size> header;
+    clock_type::duration delay = clock_type::duration::zero();
+
+    while (file.read(reinterpret_cast<char *>(header.data()), header.size())) {
+        const auto record = capture_record::deserialise(header.data());
+        delay += microseconds(record.delta);
+
+        const auto begin = this->_data.size();
+        this->_data.resize(begin + record.size);
+        if (!file.read(reinterpret_cast<char *>(this->_data.data() + begin),
+                record.size)) {
+            _benchlab_debug("The capture is truncated.\r\n");
+            return HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+        }
+
+        if (record.direction == capture_direction::sent) {
+            // Commands only matter for timing the responses, so we drop their
+            // payload and do not need them at all if timing is ignored.
+            this->_data.resize(begin);
+            if (this->_mode == benchlab_replay_mode::recorded_speed) {
+                this->_chunks.push_back({ begin, delay, true, 0 });
+            }
+            delay = clock_type::duration::zero();
+
+        } else if (this->_mode == benchlab_replay_mode::recorded_speed) {
+            this->_chunks.push_back({ begin, delay, false, record.size });
+        }
+    }
+
+    if (file.bad()) {
+        _benchlab_debug("Reading the capture failed.\r\n");
+        return E_FAIL;
+    }
+
+    // Without timing, all received data can be made available at once.
+    if (this->_mode != benchlab_replay_mode::recorded_speed) {
+        auto retval = this->push(this->_data.data(), this->_data.size());
+        this->_data.clear();
+        this->_data.shrink_to_fit();
+        return retval;
+    }
+
+    return S_OK;
+}
+
+
+/*
+ * replay_transport::load_raw
+ */
+HRESULT replay_transport::load_raw(_Inout_ std::istream& file) noexcept {
+    std::array<char, 4096> buffer;
+    while (file.read(buffer.data(), buffer.size()) || (file.gcount() > 0)) {
+        auto hr = this->push(buffer.data(),
+            static_cast<std::size_t>(file.gcount()));
+        if (FAILED(hr)) {
+            return hr;
+        }
+    }
+
+    if (file.bad()) {
+        _benchlab_debug("Reading the recording failed.\r\n");
+        return E_FAIL;
+    }
+
+    return S_OK;
+}
+
+
+/*
+ * replay_transport::release
+ */
+replay_transport::clock_type::time_point replay_transport::release(
+        _In_ const clock_type::time_point now) noexcept {
+    while (this->_next < this->_chunks.size()) {
+        const auto& c = this->_chunks[this->_next];
+        if (c.sent) {
+            // The rest of the capture must wait for the next command.
+            break;
+        }
+
+        const auto due = this->_segment + c.delay;
+        if (due > now) {
+            return due;
+        }
+
+        this->push(this->_data.data() + c.begin, c.size);
+        ++this->_next;
+    }
+
+    return (clock_type::time_point::max)();
+}
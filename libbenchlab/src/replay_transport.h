@@ -0,0 +1,126 @@
+﻿// <copyright file="replay_transport.h" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#if !defined(_BENCHLAB_REPLAY_TRANSPORT_H)
+#define _BENCHLAB_REPLAY_TRANSPORT_H
+#pragma once
+
+#include <istream>
+
+#include "libbenchlab/transport.h"
+
+#include "memory_transport.h"
+
+
+/// <summary>
+/// A transport that delivers a recording of the bytes received from a device
+/// and discards all commands.
+/// </summary>
+/// <remarks>
+/// <para>The recording is either a plain dump of the bytes received or a
+/// capture created by <see cref="capture_transport" />, which is recognised
+/// by its magic number.</para>
+/// <para>Plain dumps are always available for reading immediately, i.e. the
+/// replay runs as fast as the consumer can process the data. Captures can
+/// additionally be replayed at the recorded speed, in which case the
+/// responses following a command in the capture are released with their
+/// recorded delay after the respective command has been written to the
+/// transport.</para>
+/// </remarks>
+class LIBBENCHLAB_TEST_API replay_transport final : public memory_transport {
+
+public:
+
+    /// <summary>
+    /// Initialises a new instance.
+    /// </summary>
+    /// <param name="mode">Determines the timing of captures.</param>
+    replay_transport(_In_ const benchlab_replay_mode mode) noexcept;
+
+    /// <inheritdoc />
+    HRESULT available(_Out_ std::size_t& cnt) noexcept override;
+
+    /// <inheritdoc />
+    bool is_preloaded(void) const noexcept override;
+
+    /// <summary>
+    /// Loads the recording in the file at <paramref name="path" /> into the
+    /// input of the transport.
+    /// </summary>
+    /// <param name="path">The path to the recording.</param>
+    /// <returns><c>S_OK</c> in case of success, an error code otherwise.
+    /// </returns>
+    HRESULT load(_In_z_ const benchlab_char *path) noexcept;
+
+    /// <inheritdoc />
+    HRESULT read(_Out_writes_bytes_(cnt) void *dst,
+        _Inout_ std::size_t& cnt) noexcept override;
+
+    /// <inheritdoc />
+    HRESULT wait(_In_ const clock_type::time_point deadline) noexcept override;
+
+    /// <inheritdoc />
+    HRESULT write(_In_reads_bytes_(cnt) const void *data,
+        _In_ const std::size_t cnt) noexcept override;
+
+private:
+
+    /// <summary>
+    /// A chunk of a capture, which is waiting to be released.
+    /// </summary>
+    struct chunk {
+        /// <summary>
+        /// The offset of the payload in <see cref="_data" />.
+        /// </summary>
+        std::size_t begin;
+
+        /// <summary>
+        /// The delay since the command that started the segment of the chunk.
+        /// </summary>
+        clock_type::duration delay;
+
+        /// <summary>
+        /// Marks a recorded command, which starts a new segment.
+        /// </summary>
+        bool sent;
+
+        /// <summary>
+        /// The size of the payload in bytes.
+        /// </summary>
+        std::size_t size;
+    };
+
+    /// <summary>
+    /// Parses the capture in <paramref name="file" />, whose magic number has
+    /// already been consumed.
+    /// </summary>
+    HRESULT load_capture(_Inout_ std::istream& file);
+
+    /// <summary>
+    /// Loads the plain dump in <paramref name="file" />.
+    /// </summary>
+    HRESULT load_raw(_Inout_ std::istream& file) noexcept;
+
+    /// <summary>
+    /// Pushes all chunks of the current segment that are due at
+    /// <paramref name="now" /> and answers when the next one is due.
+    /// </summary>
+    /// <remarks>
+    /// The caller must hold <see cref="_lock" />.
+    /// </remarks>
+    clock_type::time_point release(_In_ const clock_type::time_point now)
+        noexcept;
+
+    std::vector<chunk> _chunks;
+    std::vector<std::uint8_t> _data;
+    std::mutex _lock;
+    benchlab_replay_mode _mode;
+    std::size_t _next;
+    bool _preloaded;
+    clock_type::time_point _segment;
+};
+
+#endif /* !defined(_BENCHLAB_REPLAY_TRANSPORT_H) */
@@ -0,0 +1,78 @@
+﻿// <copyright file="sample_batch.cpp" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#include "sample_batch.h"
+
+#include <cassert>
+#include <new>
+
+#include "debug.h"
+
+
+/*
+ * sample_batch::add
+ */
+bool sample_batch::add(_In_ const benchlab_sample& sample,
+        _In_ const clock_type::time_point now) noexcept {
+    assert(this->_count < this->_capacity);
+
+    if (this->_count == 0) {
+        this->_deadline = (this->_latency.count() > 0)
+            ? now + this->_latency
+            : (clock_type::time_point::max)();
+    }
+
+    this->_samples[this->_count++] = sample;
+    return (this->_count >= this->_capacity);
+}
+
+
+/*
+ * sample_batch::flush
+ */
+void sample_batch::flush(_In_ benchlab_handle source,
+        _In_ const benchlab_streaming_configuration& config) noexcept {
+    if (this->_count > 0) {
+        assert(config.batch_callback != nullptr);
+        // Reset the count first such that the callback cannot observe a
+        // batch that has already been delivered if it stops streaming.
+        const auto cnt = this->_count;
+        this->_count = 0;
+        config.batch_callback(source, this->_samples.get(), cnt,
+            config.context);
+    }
+}
+
+
+/*
+ * sample_batch::reset
+ */
+HRESULT sample_batch::reset(
+        _In_ const benchlab_streaming_configuration& config) noexcept {
+    this->_count = 0;
+    this->_latency = std::chrono::milliseconds(config.batch_latency);
+
+    if (config.batch_callback == nullptr) {
+        this->_capacity = 0;
+        this->_samples.reset();
+        return S_OK;
+    }
+
+    assert(config.batch_size > 0);
+    if (this->_capacity != config.batch_size) {
+        this->_capacity = 0;
+        this->_samples.reset(new (std::nothrow)
+            benchlab_sample[config.batch_size]);
+        if (this->_samples == nullptr) {
+            _benchlab_debug("Insufficient memory for the sample batch.\r\n");
+            return E_OUTOFMEMORY;
+        }
+
+        this->_capacity = config.batch_size;
+    }
+
+    return S_OK;
+}
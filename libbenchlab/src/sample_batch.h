@@ -0,0 +1,93 @@
+﻿// <copyright file="sample_batch.h" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#if !defined(_BENCHLAB_SAMPLE_BATCH_H)
+#define _BENCHLAB_SAMPLE_BATCH_H
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+
+#include "libbenchlab/streaming.h"
+#include "libbenchlab/types.h"
+
+
+/// <summary>
+/// Collects the samples for the batch callback of a streaming device.
+/// </summary>
+/// <remarks>
+/// The batch is only accessed by the thread acquiring the samples, so it
+/// requires no synchronisation. Its storage is allocated when streaming is
+/// started such that adding samples never allocates memory.
+/// </remarks>
+class sample_batch final {
+
+public:
+
+    typedef std::chrono::steady_clock clock_type;
+
+    /// <summary>
+    /// Initialises a new instance without any storage.
+    /// </summary>
+    inline sample_batch(void) noexcept : _capacity(0), _count(0) { }
+
+    sample_batch(const sample_batch&) = delete;
+
+    /// <summary>
+    /// Adds <paramref name="sample" />, which has been acquired at
+    /// <paramref name="now" />, to the batch.
+    /// </summary>
+    /// <returns><c>true</c> if the batch is complete after adding the sample,
+    /// <c>false</c> otherwise.</returns>
+    bool add(_In_ const benchlab_sample& sample,
+        _In_ const clock_type::time_point now) noexcept;
+
+    /// <summary>
+    /// Answer when the batch must be delivered even though it is incomplete.
+    /// </summary>
+    /// <remarks>
+    /// If the batch is empty or has no latency limit, this is the maximum
+    /// representable time.
+    /// </remarks>
+    inline clock_type::time_point deadline(void) const noexcept {
+        return (this->_count > 0)
+            ? this->_deadline
+            : (clock_type::time_point::max)();
+    }
+
+    /// <summary>
+    /// Passes all samples in the batch to the batch callback in
+    /// <paramref name="config" /> and empties the batch.
+    /// </summary>
+    void flush(_In_ benchlab_handle source,
+        _In_ const benchlab_streaming_configuration& config) noexcept;
+
+    /// <summary>
+    /// Discards any samples and prepares the storage for the batches
+    /// requested in <paramref name="config" />.
+    /// </summary>
+    /// <remarks>
+    /// The storage is reused if it has the requested capacity. If the
+    /// configuration has no batch callback, the storage is released.
+    /// </remarks>
+    /// <returns><c>S_OK</c> in case of success, <c>E_OUTOFMEMORY</c> if the
+    /// storage could not be allocated.</returns>
+    HRESULT reset(
+        _In_ const benchlab_streaming_configuration& config) noexcept;
+
+    sample_batch& operator =(const sample_batch&) = delete;
+
+private:
+
+    std::size_t _capacity;
+    std::size_t _count;
+    clock_type::time_point _deadline;
+    clock_type::duration _latency;
+    std::unique_ptr<benchlab_sample[]> _samples;
+};
+
+#endif /* !defined(_BENCHLAB_SAMPLE_BATCH_H) */
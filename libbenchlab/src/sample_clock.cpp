@@ -0,0 +1,254 @@
+﻿// <copyright file="sample_clock.cpp" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#include "sample_clock.h"
+
+#include <chrono>
+#include <limits>
+#include <thread>
+
+#if defined(_WIN32)
+#include <Windows.h>
+#else /* defined(_WIN32) */
+#include <time.h>
+#endif /* defined(_WIN32) */
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) \
+    || defined(_M_IX86)
+#define BENCHLAB_CLOCK_TSC
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else /* defined(_MSC_VER) */
+#include <cpuid.h>
+#include <x86intrin.h>
+#endif /* defined(_MSC_VER) */
+#endif /* defined(__x86_64__) || ... */
+
+#include "debug.h"
+
+
+/// <summary>
+/// The number of timestamp units per second.
+/// </summary>
+constexpr benchlab_timestamp timestamp_frequency = 10000000;
+
+
+/// <summary>
+/// The offset of the <c>FILETIME</c> epoch from the UNIX epoch in timestamp
+/// units.
+/// </summary>
+constexpr benchlab_timestamp unix_epoch = 116444736000000000LL;
+
+
+/// <summary>
+/// The number of alternating readings that
+/// <see cref="sample_clock::correlate" /> takes to find the tightest pair.
+/// </summary>
+constexpr int correlation_rounds = 16;
+
+
+#if !defined(_WIN32)
+/// <summary>
+/// Reads the POSIX clock <paramref name="id" /> in timestamp units from
+/// <paramref name="epoch" />.
+/// </summary>
+static inline benchlab_timestamp read_posix(_In_ const clockid_t id,
+        _In_ const benchlab_timestamp epoch) noexcept {
+    timespec ts;
+    ::clock_gettime(id, &ts);
+    return epoch + static_cast<benchlab_timestamp>(ts.tv_sec)
+        * timestamp_frequency + ts.tv_nsec / 100;
+}
+#endif /* !defined(_WIN32) */
+
+
+/// <summary>
+/// Reads the high-resolution wall clock.
+/// </summary>
+static inline benchlab_timestamp read_wall_time(void) noexcept {
+    return sample_clock::read(benchlab_clock::realtime);
+}
+
+
+#if defined(BENCHLAB_CLOCK_TSC)
+/// <summary>
+/// Answer whether the processor has an invariant time stamp counter, which
+/// ticks at a constant rate in all power states.
+/// </summary>
+static bool has_invariant_tsc(void) noexcept {
+    unsigned int edx = 0;
+
+#if defined(_MSC_VER)
+    int info[4];
+    ::__cpuid(info, 0x80000000);
+    if (static_cast<unsigned int>(info[0]) >= 0x80000007) {
+        ::__cpuid(info, 0x80000007);
+        edx = static_cast<unsigned int>(info[3]);
+    }
+#else /* defined(_MSC_VER) */
+    unsigned int eax, ebx, ecx;
+    if (::__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx) == 0) {
+        edx = 0;
+    }
+#endif /* defined(_MSC_VER) */
+
+    return (edx & (1 << 8)) != 0;
+}
+
+
+/// <summary>
+/// Measures the frequency of the time stamp counter against the monotonic
+/// clock.
+/// </summary>
+static double measure_tsc_frequency(void) noexcept {
+    using namespace std::chrono;
+    const auto t0 = sample_clock::read(benchlab_clock::monotonic_raw);
+    const auto c0 = __rdtsc();
+    std::this_thread::sleep_for(milliseconds(20));
+    const auto t1 = sample_clock::read(benchlab_clock::monotonic_raw);
+    const auto c1 = __rdtsc();
+    return static_cast<double>(c1 - c0) * timestamp_frequency
+        / static_cast<double>(t1 - t0);
+}
+#endif /* defined(BENCHLAB_CLOCK_TSC) */
+
+
+/*
+ * sample_clock::check
+ */
+HRESULT sample_clock::check(_In_ const benchlab_clock clock) noexcept {
+    switch (clock) {
+        case benchlab_clock::system:
+        case benchlab_clock::realtime:
+        case benchlab_clock::monotonic_raw:
+            return S_OK;
+
+        case benchlab_clock::tai:
+#if defined(_WIN32)
+            _benchlab_debug("TAI is not available on Windows.\r\n");
+            return E_NOTIMPL;
+#else /* defined(_WIN32) */
+            return S_OK;
+#endif /* defined(_WIN32) */
+
+        case benchlab_clock::tsc: {
+#if defined(BENCHLAB_CLOCK_TSC)
+            static const auto invariant = ::has_invariant_tsc();
+            if (invariant) {
+                return S_OK;
+            }
+#endif /* defined(BENCHLAB_CLOCK_TSC) */
+            _benchlab_debug("The processor has no invariant time stamp "
+                "counter.\r\n");
+            return E_NOTIMPL;
+            }
+
+        default:
+            _benchlab_debug("The clock is not valid.\r\n");
+            return E_INVALIDARG;
+    }
+}
+
+
+/*
+ * sample_clock::correlate
+ */
+HRESULT sample_clock::correlate(_Out_ benchlab_clock_correlation& dst,
+        _In_ const benchlab_clock clock) noexcept {
+    {
+        auto hr = check(clock);
+        if (FAILED(hr)) {
+            return hr;
+        }
+    }
+
+    dst.clock = clock;
+    dst.frequency = static_cast<double>(timestamp_frequency);
+    dst.uncertainty = (std::numeric_limits<benchlab_timestamp>::max)();
+
+#if defined(BENCHLAB_CLOCK_TSC)
+    if (clock == benchlab_clock::tsc) {
+        static const auto frequency = ::measure_tsc_frequency();
+        dst.frequency = frequency;
+    }
+#endif /* defined(BENCHLAB_CLOCK_TSC) */
+
+    for (int i = 0; i < correlation_rounds; ++i) {
+        const auto before = ::read_wall_time();
+        const auto reference = read(clock);
+        const auto after = ::read_wall_time();
+        const auto uncertainty = (after - before + 1) / 2;
+
+        if (uncertainty < dst.uncertainty) {
+            dst.reference = reference;
+            dst.uncertainty = uncertainty;
+            dst.wall_time = before + (after - before) / 2;
+        }
+    }
+
+    return S_OK;
+}
+
+
+/*
+ * sample_clock::read
+ */
+benchlab_timestamp sample_clock::read(
+        _In_ const benchlab_clock clock) noexcept {
+#if defined(_WIN32)
+    switch (clock) {
+        case benchlab_clock::realtime: {
+            FILETIME file_time;
+            ULARGE_INTEGER retval;
+            ::GetSystemTimePreciseAsFileTime(&file_time);
+            retval.HighPart = file_time.dwHighDateTime;
+            retval.LowPart = file_time.dwLowDateTime;
+            return static_cast<benchlab_timestamp>(retval.QuadPart);
+            }
+
+        case benchlab_clock::monotonic_raw: {
+            static const auto frequency = [](void) {
+                LARGE_INTEGER retval;
+                ::QueryPerformanceFrequency(&retval);
+                return retval.QuadPart;
+            }();
+            LARGE_INTEGER counter;
+            ::QueryPerformanceCounter(&counter);
+            return (counter.QuadPart / frequency) * timestamp_frequency
+                + (counter.QuadPart % frequency) * timestamp_frequency
+                / frequency;
+            }
+
+#if defined(BENCHLAB_CLOCK_TSC)
+        case benchlab_clock::tsc:
+            return static_cast<benchlab_timestamp>(__rdtsc());
+#endif /* defined(BENCHLAB_CLOCK_TSC) */
+
+        default:
+            return ::benchlab_make_timestamp();
+    }
+
+#else /* defined(_WIN32) */
+    switch (clock) {
+        case benchlab_clock::monotonic_raw:
+            return ::read_posix(CLOCK_MONOTONIC_RAW, 0);
+
+        case benchlab_clock::tai:
+            return ::read_posix(CLOCK_TAI, unix_epoch);
+
+#if defined(BENCHLAB_CLOCK_TSC)
+        case benchlab_clock::tsc:
+            return static_cast<benchlab_timestamp>(__rdtsc());
+#endif /* defined(BENCHLAB_CLOCK_TSC) */
+
+        default:
+            // benchlab_make_timestamp uses the STL clock, which is
+            // CLOCK_REALTIME, too.
+            return ::read_posix(CLOCK_REALTIME, unix_epoch);
+    }
+#endif /* defined(_WIN32) */
+}
@@ -0,0 +1,107 @@
+﻿// <copyright file="sample_clock.h" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#if !defined(_BENCHLAB_SAMPLE_CLOCK_H)
+#define _BENCHLAB_SAMPLE_CLOCK_H
+#pragma once
+
+#include "libbenchlab/api.h"
+#include "libbenchlab/clock.h"
+#include "libbenchlab/timestamp.h"
+#include "libbenchlab/types.h"
+
+
+/// <summary>
+/// Timestamps the samples of a stream using the
+/// <see cref="benchlab_clock" /> and the
+/// <see cref="benchlab_timestamp_point" /> from its configuration.
+/// </summary>
+/// <remarks>
+/// Acquiring a sample takes two readings of the clock, one immediately
+/// before the command is issued and one immediately after the response has
+/// been received. The clocks are read directly via <c>clock_gettime</c>,
+/// which is served by the vDSO on Linux, the respective Windows API or the
+/// <c>rdtsc</c> instruction, such that a reading costs only a few tens of
+/// nanoseconds.
+/// </remarks>
+class LIBBENCHLAB_TEST_API sample_clock final {
+
+public:
+
+    /// <summary>
+    /// Checks whether <paramref name="clock" /> can be used on this machine.
+    /// </summary>
+    /// <returns><c>S_OK</c> if the clock is supported, <c>E_INVALIDARG</c>
+    /// if it is not a valid clock, <c>E_NOTIMPL</c> if it is not
+    /// available.</returns>
+    static HRESULT check(_In_ const benchlab_clock clock) noexcept;
+
+    /// <summary>
+    /// Relates the current reading of <paramref name="clock" /> to the wall
+    /// time.
+    /// </summary>
+    /// <remarks>
+    /// The clocks are read alternately several times, and the pair with the
+    /// shortest interval between them is used.
+    /// </remarks>
+    static HRESULT correlate(_Out_ benchlab_clock_correlation& dst,
+        _In_ const benchlab_clock clock) noexcept;
+
+    /// <summary>
+    /// Reads <paramref name="clock" />, which must have passed
+    /// <see cref="check" />.
+    /// </summary>
+    static benchlab_timestamp read(_In_ const benchlab_clock clock) noexcept;
+
+    /// <summary>
+    /// Initialises a new instance using the system time and timestamping at
+    /// completion, which is what the library did before the clock could be
+    /// chosen.
+    /// </summary>
+    inline sample_clock(void) noexcept
+        : _clock(benchlab_clock::system),
+        _point(benchlab_timestamp_point::completion) { }
+
+    /// <summary>
+    /// Initialises a new instance.
+    /// </summary>
+    inline sample_clock(_In_ const benchlab_clock clock,
+            _In_ const benchlab_timestamp_point point) noexcept
+        : _clock(clock), _point(point) { }
+
+    /// <summary>
+    /// Reads the clock.
+    /// </summary>
+    inline benchlab_timestamp now(void) const noexcept {
+        return read(this->_clock);
+    }
+
+    /// <summary>
+    /// Determines the timestamp of a sample that has been requested at
+    /// <paramref name="requested" /> and has been received at
+    /// <paramref name="completed" />.
+    /// </summary>
+    inline benchlab_timestamp select(_In_ const benchlab_timestamp requested,
+            _In_ const benchlab_timestamp completed) const noexcept {
+        switch (this->_point) {
+            case benchlab_timestamp_point::request:
+                return requested;
+
+            case benchlab_timestamp_point::midpoint:
+                return requested + (completed - requested) / 2;
+
+            default:
+                return completed;
+        }
+    }
+
+private:
+
+    benchlab_clock _clock;
+    benchlab_timestamp_point _point;
+};
+
+#endif /* !defined(_BENCHLAB_SAMPLE_CLOCK_H) */
@@ -0,0 +1,147 @@
+﻿// <copyright file="sample_columns.cpp" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#include "sample_columns.h"
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <new>
+#include <type_traits>
+
+#include "spsc_ring.h"
+
+
+/// <summary>
+/// Invokes <paramref name="action" /> for a reference to the pointer of
+/// every array of <paramref name="columns" />.
+/// </summary>
+template<class TAction>
+static void for_each_column(_In_ benchlab_sample_columns& columns,
+        _In_ TAction&& action) {
+    action(columns.timestamp);
+    for (auto& c : columns.input_voltage) {
+        action(c);
+    }
+    action(columns.supply_voltage);
+    action(columns.reference_voltage);
+    action(columns.chip_temperature);
+    for (auto& c : columns.temperatures) {
+        action(c);
+    }
+    action(columns.ambient_temperature);
+    action(columns.humidity);
+    action(columns.external_fan_duty);
+    for (auto& c : columns.voltages) {
+        action(c);
+    }
+    for (auto& c : columns.currents) {
+        action(c);
+    }
+    for (auto& c : columns.power) {
+        action(c);
+    }
+    for (auto& c : columns.fan_speeds) {
+        action(c);
+    }
+    for (auto& c : columns.fan_duties) {
+        action(c);
+    }
+}
+
+
+/*
+ * sample_columns::create
+ */
+std::unique_ptr<sample_columns> sample_columns::create(
+        _In_ const std::size_t capacity) noexcept {
+    assert(capacity > 0);
+    std::unique_ptr<sample_columns> retval(new (std::nothrow)
+        sample_columns());
+    if (retval == nullptr) {
+        return nullptr;
+    }
+
+    // Determine the size of the storage, rounding up every array to full
+    // cache lines, and make room for aligning the first one.
+    const auto pad = [](const std::size_t size) {
+        return (size + cache_line_size - 1) & ~(cache_line_size - 1);
+    };
+
+    std::size_t size = cache_line_size - 1;
+    for_each_column(*retval, [&](auto& column) {
+        typedef std::remove_reference_t<decltype(*column)> element_type;
+        size += pad(capacity * sizeof(element_type));
+    });
+
+    retval->_storage.reset(new (std::nothrow) std::uint8_t[size]);
+    if (retval->_storage == nullptr) {
+        return nullptr;
+    }
+
+    auto cur = reinterpret_cast<std::uintptr_t>(retval->_storage.get());
+    cur = pad(cur);
+
+    for_each_column(*retval, [&](auto& column) {
+        typedef std::remove_reference_t<decltype(*column)> element_type;
+        column = reinterpret_cast<element_type *>(cur);
+        cur += pad(capacity * sizeof(element_type));
+    });
+
+    retval->capacity = capacity;
+    return retval;
+}
+
+
+/*
+ * sample_columns::append
+ */
+void sample_columns::append(_In_reads_(cnt) const benchlab_sample *samples,
+        _In_ const std::size_t cnt) noexcept {
+    assert((samples != nullptr) || (cnt == 0));
+    assert(this->count + cnt <= this->capacity);
+    const auto offset = this->count;
+
+    for (std::size_t s = 0; s < cnt; ++s) {
+        const auto& src = samples[s];
+        const auto dst = offset + s;
+
+        this->timestamp[dst] = src.timestamp;
+        for (std::size_t i = 0; i < std::size(src.input_voltage); ++i) {
+            this->input_voltage[i][dst] = src.input_voltage[i];
+        }
+        this->supply_voltage[dst] = src.supply_voltage;
+        this->reference_voltage[dst] = src.reference_voltage;
+        this->chip_temperature[dst] = src.chip_temperature;
+        for (std::size_t i = 0; i < std::size(src.temperatures); ++i) {
+            this->temperatures[i][dst] = src.temperatures[i];
+        }
+        this->ambient_temperature[dst] = src.ambient_temperature;
+        this->humidity[dst] = src.humidity;
+        this->external_fan_duty[dst] = src.external_fan_duty;
+        for (std::size_t i = 0; i < std::size(src.power); ++i) {
+            this->voltages[i][dst] = src.voltages[i];
+            this->currents[i][dst] = src.currents[i];
+            this->power[i][dst] = src.power[i];
+        }
+        for (std::size_t i = 0; i < std::size(src.fan_speeds); ++i) {
+            this->fan_speeds[i][dst] = src.fan_speeds[i];
+            this->fan_duties[i][dst] = src.fan_duties[i];
+        }
+    }
+
+    this->count += cnt;
+}
+
+
+/*
+ * sample_columns::sample_columns
+ */
+sample_columns::sample_columns(void) noexcept {
+    ::memset(static_cast<benchlab_sample_columns *>(this), 0,
+        sizeof(benchlab_sample_columns));
+}
@@ -0,0 +1,57 @@
+﻿// <copyright file="sample_columns.h" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#if !defined(_BENCHLAB_SAMPLE_COLUMNS_H)
+#define _BENCHLAB_SAMPLE_COLUMNS_H
+#pragma once
+
+#include <cinttypes>
+#include <cstddef>
+#include <memory>
+
+#include "libbenchlab/columns.h"
+
+
+/// <summary>
+/// Implements <see cref="benchlab_sample_columns" /> by owning the storage
+/// of all arrays.
+/// </summary>
+/// <remarks>
+/// All arrays share a single allocation in which each of them starts at a
+/// cache line.
+/// </remarks>
+class LIBBENCHLAB_TEST_API sample_columns final
+        : public benchlab_sample_columns {
+
+public:
+
+    /// <summary>
+    /// Allocates a batch for <paramref name="capacity" /> samples.
+    /// </summary>
+    /// <returns>The batch, or <c>nullptr</c> if the memory could not be
+    /// allocated.</returns>
+    static std::unique_ptr<sample_columns> create(
+        _In_ const std::size_t capacity) noexcept;
+
+    sample_columns(const sample_columns&) = delete;
+
+    /// <summary>
+    /// Appends <paramref name="cnt" /> samples, for which the caller must
+    /// have made sure that there is enough space.
+    /// </summary>
+    void append(_In_reads_(cnt) const benchlab_sample *samples,
+        _In_ const std::size_t cnt) noexcept;
+
+    sample_columns& operator =(const sample_columns&) = delete;
+
+private:
+
+    sample_columns(void) noexcept;
+
+    std::unique_ptr<std::uint8_t[]> _storage;
+};
+
+#endif /* !defined(_BENCHLAB_SAMPLE_COLUMNS_H) */
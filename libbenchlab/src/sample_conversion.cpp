@@ -0,0 +1,369 @@
+﻿// <copyright file="sample_conversion.cpp" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#include "sample_conversion.h"
+
+#include <cassert>
+#include <cstddef>
+#include <limits>
+
+#include "channel_kernels.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) \
+    || defined(_M_IX86)
+#define BENCHLAB_CONVERSION_X86
+#include <immintrin.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif /* defined(_MSC_VER) */
+#endif /* defined(__x86_64__) || ... */
+
+// GCC and Clang only emit vector instructions in functions marked for the
+// respective target, whereas MSVC allows for using any intrinsic anywhere.
+#if defined(_MSC_VER) && !defined(__clang__)
+#define BENCHLAB_TARGET(isa)
+#else /* defined(_MSC_VER) && !defined(__clang__) */
+#define BENCHLAB_TARGET(isa) __attribute__((target(isa)))
+#endif /* defined(_MSC_VER) && !defined(__clang__) */
+
+
+/// <summary>
+/// The number of the first input voltage channel.
+/// </summary>
+constexpr auto first_vin = channel_index(benchlab_channel::input_voltage);
+
+/// <summary>
+/// The number of the first temperature channel.
+/// </summary>
+constexpr auto first_ts = channel_index(benchlab_channel::temperature);
+
+/// <summary>
+/// The number of the first voltage channel of the power sensors.
+/// </summary>
+constexpr auto first_power = channel_index(benchlab_channel::voltage);
+
+/// <summary>
+/// The marker of a sensor that is not connected.
+/// </summary>
+constexpr auto invalid_reading = static_cast<std::int16_t>(
+    visus::benchlab::channel_descriptors[first_vin].invalid_value);
+
+/// <summary>
+/// The divisor of the input voltages.
+/// </summary>
+constexpr auto vin_divisor
+    = visus::benchlab::channel_descriptors[first_vin].divisor;
+
+/// <summary>
+/// The divisor of the temperatures.
+/// </summary>
+constexpr auto ts_divisor
+    = visus::benchlab::channel_descriptors[first_ts].divisor;
+
+/// <summary>
+/// The divisor of the voltages, currents and power of the power sensors.
+/// </summary>
+constexpr auto power_divisor
+    = visus::benchlab::channel_descriptors[first_power].divisor;
+
+static_assert(BENCHLAB_VIN_SENSORS >= 8, "The vectorised conversion of the "
+    "input voltages requires at least eight sensors.");
+static_assert(BENCHLAB_TEMPERATURE_SENSORS == 4, "The vectorised conversion "
+    "of the temperatures requires exactly four sensors.");
+static_assert(BENCHLAB_POWER_SENSORS >= 8, "The vectorised conversion of the "
+    "power sensors requires at least eight sensors.");
+static_assert(offsetof(benchlab_power_reading, voltage) == 0,
+    "The layout of benchlab_power_reading is unexpected.");
+static_assert(offsetof(benchlab_power_reading, current) == 4,
+    "The layout of benchlab_power_reading is unexpected.");
+static_assert(offsetof(benchlab_power_reading, power) == 8,
+    "The layout of benchlab_power_reading is unexpected.");
+static_assert(sizeof(benchlab_power_reading) == 12,
+    "The layout of benchlab_power_reading is unexpected.");
+static_assert(is_uniform_channel_range(first_vin,
+    first_vin + BENCHLAB_VIN_SENSORS), "The vectorised conversion requires "
+    "all input voltages to be converted alike.");
+static_assert(visus::benchlab::channel_descriptors[first_vin].has_invalid_value,
+    "The vectorised conversion of the input voltages checks for invalid "
+    "readings.");
+static_assert(is_uniform_channel_range(first_ts,
+    first_ts + BENCHLAB_TEMPERATURE_SENSORS), "The vectorised conversion "
+    "requires all temperatures to be converted alike.");
+static_assert(visus::benchlab::channel_descriptors[first_ts].has_invalid_value
+    && (visus::benchlab::channel_descriptors[first_ts].invalid_value
+    == invalid_reading), "The vectorised conversion of the temperatures "
+    "checks for invalid readings.");
+static_assert(is_uniform_channel_range(first_power,
+    first_power + BENCHLAB_POWER_SENSORS), "The vectorised conversion "
+    "requires all voltages of the power sensors to be converted alike.");
+static_assert(!visus::benchlab::channel_descriptors[first_power]
+    .has_invalid_value, "The vectorised conversion of the power sensors does "
+    "not check for invalid readings.");
+static_assert(is_uniform_channel_range(first_power + BENCHLAB_POWER_SENSORS,
+    first_power + 3 * BENCHLAB_POWER_SENSORS), "The vectorised conversion "
+    "requires all currents and power readings to be converted alike.");
+static_assert(!visus::benchlab::channel_descriptors[first_power
+    + BENCHLAB_POWER_SENSORS].has_invalid_value
+    && (visus::benchlab::channel_descriptors[first_power
+    + BENCHLAB_POWER_SENSORS].divisor == power_divisor), "The vectorised "
+    "conversion of the power sensors uses the same divisor throughout.");
+
+
+/// <summary>
+/// Converts the members of <paramref name="src" /> that are not vectorised.
+/// </summary>
+static inline void convert_remainder(_Out_ benchlab_sample& dst,
+        _In_ const benchlab_sensor_readings& src,
+        _In_ const benchlab_timestamp timestamp) noexcept {
+    dst.timestamp = timestamp;
+    convert_channels<first_vin + BENCHLAB_VIN_SENSORS, first_ts>(dst, src);
+    convert_channels<first_ts + BENCHLAB_TEMPERATURE_SENSORS, first_power>(
+        dst, src);
+    convert_channels<first_power + 3 * BENCHLAB_POWER_SENSORS,
+        BENCHLAB_CHANNELS>(dst, src);
+}
+
+
+/// <summary>
+/// Converts the readings one channel at a time using the routines generated
+/// from the channel descriptors.
+/// </summary>
+static void convert_scalar(_Out_writes_(cnt) benchlab_sample *dst,
+        _In_reads_(cnt) const benchlab_sensor_readings *src,
+        _In_ const std::size_t cnt,
+        _In_reads_opt_(cnt) const benchlab_timestamp *timestamps,
+        _In_ const benchlab_timestamp now) noexcept {
+    for (std::size_t s = 0; s < cnt; ++s) {
+        dst[s].timestamp = (timestamps != nullptr) ? timestamps[s] : now;
+        convert_channels<0, BENCHLAB_CHANNELS>(dst[s], src[s]);
+    }
+}
+
+
+#if defined(BENCHLAB_CONVERSION_X86)
+/// <summary>
+/// Converts four signed 16-bit readings at <paramref name="src" /> to
+/// floats, replacing invalid ones by the lowest float.
+/// </summary>
+/// <remarks>
+/// The conversion divides rather than multiplying by the reciprocal, which
+/// yields the same results as the scalar implementation.
+/// </remarks>
+BENCHLAB_TARGET("sse4.1")
+static inline void convert_readings4(_Out_writes_(4) float *dst,
+        _In_reads_(4) const std::int16_t *src,
+        _In_ const __m128 divisor) noexcept {
+    const auto v = _mm_cvtepi16_epi32(_mm_loadl_epi64(
+        reinterpret_cast<const __m128i *>(src)));
+    const auto invalid = _mm_castsi128_ps(_mm_cmpeq_epi32(v,
+        _mm_set1_epi32(invalid_reading)));
+    const auto f = _mm_div_ps(_mm_cvtepi32_ps(v), divisor);
+    _mm_storeu_ps(dst, _mm_blendv_ps(f,
+        _mm_set1_ps(std::numeric_limits<float>::lowest()), invalid));
+}
+
+
+/// <summary>
+/// Converts the readings using SSE 4.1, one sample at a time.
+/// </summary>
+BENCHLAB_TARGET("sse4.1")
+static void convert_sse41(_Out_writes_(cnt) benchlab_sample *dst,
+        _In_reads_(cnt) const benchlab_sensor_readings *src,
+        _In_ const std::size_t cnt,
+        _In_reads_opt_(cnt) const benchlab_timestamp *timestamps,
+        _In_ const benchlab_timestamp now) noexcept {
+    constexpr auto vins = BENCHLAB_VIN_SENSORS;
+    constexpr auto powers = BENCHLAB_POWER_SENSORS;
+    const auto milli = _mm_set1_ps(power_divisor);
+    const auto vin_milli = _mm_set1_ps(vin_divisor);
+    const auto deci = _mm_set1_ps(ts_divisor);
+
+    for (std::size_t s = 0; s < cnt; ++s) {
+        auto& d = dst[s];
+        auto& r = src[s];
+
+        convert_remainder(d, r, (timestamps != nullptr) ? timestamps[s] : now);
+
+        // If the number of sensors is not a multiple of the vector width,
+        // the last vector overlaps with the previous one, which does no harm
+        // as the overlapping values are converted to the same results.
+        for (std::size_t i = 0; i < vins; i += 4) {
+            const auto o = (i + 4 <= vins) ? i : vins - 4;
+            convert_readings4(d.input_voltage + o, r.vin + o, vin_milli);
+        }
+
+        convert_readings4(d.temperatures, r.ts, deci);
+
+        for (std::size_t i = 0; i < powers; i += 4) {
+            const auto o = (i + 4 <= powers) ? i : powers - 4;
+            const auto p = r.power_readings + o;
+
+            const auto v = _mm_setr_epi32(p[0].voltage, p[1].voltage,
+                p[2].voltage, p[3].voltage);
+            _mm_storeu_ps(d.voltages + o, _mm_div_ps(_mm_cvtepi32_ps(v),
+                milli));
+
+            const auto c = _mm_setr_epi32(p[0].current, p[1].current,
+                p[2].current, p[3].current);
+            _mm_storeu_ps(d.currents + o, _mm_div_ps(_mm_cvtepi32_ps(c),
+                milli));
+
+            const auto w = _mm_setr_epi32(p[0].power, p[1].power,
+                p[2].power, p[3].power);
+            _mm_storeu_ps(d.power + o, _mm_div_ps(_mm_cvtepi32_ps(w),
+                milli));
+        }
+    }
+}
+
+
+/// <summary>
+/// Converts the readings using AVX2, one sample at a time.
+/// </summary>
+BENCHLAB_TARGET("avx2")
+static void convert_avx2(_Out_writes_(cnt) benchlab_sample *dst,
+        _In_reads_(cnt) const benchlab_sensor_readings *src,
+        _In_ const std::size_t cnt,
+        _In_reads_opt_(cnt) const benchlab_timestamp *timestamps,
+        _In_ const benchlab_timestamp now) noexcept {
+    constexpr auto vins = BENCHLAB_VIN_SENSORS;
+    constexpr auto powers = BENCHLAB_POWER_SENSORS;
+    const auto deci = _mm_set1_ps(ts_divisor);
+    const auto invalid = _mm256_set1_epi32(invalid_reading);
+    const auto lowest = _mm256_set1_ps(std::numeric_limits<float>::lowest());
+    const auto milli = _mm256_set1_ps(power_divisor);
+    const auto vin_milli = _mm256_set1_ps(vin_divisor);
+
+    for (std::size_t s = 0; s < cnt; ++s) {
+        auto& d = dst[s];
+        auto& r = src[s];
+
+        convert_remainder(d, r, (timestamps != nullptr) ? timestamps[s] : now);
+
+        for (std::size_t i = 0; i < vins; i += 8) {
+            const auto o = (i + 8 <= vins) ? i : vins - 8;
+            const auto v = _mm256_cvtepi16_epi32(_mm_loadu_si128(
+                reinterpret_cast<const __m128i *>(r.vin + o)));
+            const auto m = _mm256_castsi256_ps(_mm256_cmpeq_epi32(v,
+                invalid));
+            const auto f = _mm256_div_ps(_mm256_cvtepi32_ps(v), vin_milli);
+            _mm256_storeu_ps(d.input_voltage + o, _mm256_blendv_ps(f, lowest,
+                m));
+        }
+
+        convert_readings4(d.temperatures, r.ts, deci);
+
+        for (std::size_t i = 0; i < powers; i += 8) {
+            const auto o = (i + 8 <= powers) ? i : powers - 8;
+            const auto p = r.power_readings + o;
+
+            const auto v = _mm256_setr_epi32(p[0].voltage, p[1].voltage,
+                p[2].voltage, p[3].voltage, p[4].voltage, p[5].voltage,
+                p[6].voltage, p[7].voltage);
+            _mm256_storeu_ps(d.voltages + o, _mm256_div_ps(
+                _mm256_cvtepi32_ps(v), milli));
+
+            const auto c = _mm256_setr_epi32(p[0].current, p[1].current,
+                p[2].current, p[3].current, p[4].current, p[5].current,
+                p[6].current, p[7].current);
+            _mm256_storeu_ps(d.currents + o, _mm256_div_ps(
+                _mm256_cvtepi32_ps(c), milli));
+
+            const auto w = _mm256_setr_epi32(p[0].power, p[1].power,
+                p[2].power, p[3].power, p[4].power, p[5].power, p[6].power,
+                p[7].power);
+            _mm256_storeu_ps(d.power + o, _mm256_div_ps(
+                _mm256_cvtepi32_ps(w), milli));
+        }
+    }
+}
+#endif /* defined(BENCHLAB_CONVERSION_X86) */
+
+
+/*
+ * ::convert_readings
+ */
+void LIBBENCHLAB_TEST_API convert_readings(
+        _Out_writes_(cnt) benchlab_sample *dst,
+        _In_reads_(cnt) const benchlab_sensor_readings *src,
+        _In_ const std::size_t cnt,
+        _In_reads_opt_(cnt) const benchlab_timestamp *timestamps,
+        _In_ const benchlab_timestamp now) noexcept {
+    static const auto isa = supported_conversion_isa();
+    convert_readings(isa, dst, src, cnt, timestamps, now);
+}
+
+
+/*
+ * ::convert_readings
+ */
+void LIBBENCHLAB_TEST_API convert_readings(
+        _In_ const conversion_isa isa,
+        _Out_writes_(cnt) benchlab_sample *dst,
+        _In_reads_(cnt) const benchlab_sensor_readings *src,
+        _In_ const std::size_t cnt,
+        _In_reads_opt_(cnt) const benchlab_timestamp *timestamps,
+        _In_ const benchlab_timestamp now) noexcept {
+    assert((dst != nullptr) || (cnt == 0));
+    assert((src != nullptr) || (cnt == 0));
+
+    switch (isa) {
+#if defined(BENCHLAB_CONVERSION_X86)
+        case conversion_isa::avx2:
+            convert_avx2(dst, src, cnt, timestamps, now);
+            break;
+
+        case conversion_isa::sse41:
+            convert_sse41(dst, src, cnt, timestamps, now);
+            break;
+#endif /* defined(BENCHLAB_CONVERSION_X86) */
+
+        default:
+            convert_scalar(dst, src, cnt, timestamps, now);
+            break;
+    }
+}
+
+
+/*
+ * ::supported_conversion_isa
+ */
+conversion_isa LIBBENCHLAB_TEST_API supported_conversion_isa(void) noexcept {
+#if defined(BENCHLAB_CONVERSION_X86)
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+
+    ::__cpuid(info, 0);
+    const auto max_leaf = info[0];
+
+    ::__cpuid(info, 1);
+    const auto sse41 = (info[2] & (1 << 19)) != 0;
+    const auto osxsave = (info[2] & (1 << 27)) != 0;
+    const auto avx = (info[2] & (1 << 28)) != 0;
+
+    // AVX can only be used if the operating system saves the YMM registers.
+    auto avx2 = false;
+    if (osxsave && avx && ((::_xgetbv(0) & 0x6) == 0x6) && (max_leaf >= 7)) {
+        ::__cpuidex(info, 7, 0);
+        avx2 = (info[1] & (1 << 5)) != 0;
+    }
+
+#else /* defined(_MSC_VER) && !defined(__clang__) */
+    __builtin_cpu_init();
+    const auto avx2 = (__builtin_cpu_supports("avx2") != 0);
+    const auto sse41 = (__builtin_cpu_supports("sse4.1") != 0);
+#endif /* defined(_MSC_VER) && !defined(__clang__) */
+
+    if (avx2) {
+        return conversion_isa::avx2;
+    } else if (sse41) {
+        return conversion_isa::sse41;
+    }
+#endif /* defined(BENCHLAB_CONVERSION_X86) */
+
+    return conversion_isa::scalar;
+}
@@ -0,0 +1,67 @@
+﻿// <copyright file="sample_conversion.h" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#if !defined(_BENCHLAB_SAMPLE_CONVERSION_H)
+#define _BENCHLAB_SAMPLE_CONVERSION_H
+#pragma once
+
+#include <cstddef>
+
+#include "libbenchlab/api.h"
+#include "libbenchlab/types.h"
+
+
+/// <summary>
+/// The instruction sets that the conversion of readings can use.
+/// </summary>
+enum class conversion_isa {
+    scalar,
+    sse41,
+    avx2
+};
+
+
+/// <summary>
+/// Converts <paramref name="cnt" /> sensor readings to samples using the best
+/// instruction set that the processor supports.
+/// </summary>
+/// <remarks>
+/// All implementations produce the very same results as the scalar one. The
+/// instruction set is determined on the first call.
+/// </remarks>
+/// <param name="dst">Receives <paramref name="cnt" /> samples.</param>
+/// <param name="src">The <paramref name="cnt" /> readings to convert.</param>
+/// <param name="cnt">The number of readings to convert.</param>
+/// <param name="timestamps">The timestamps of the individual samples, or
+/// <c>nullptr</c> for using <paramref name="now" /> for all of them.</param>
+/// <param name="now">The timestamp used if there are no individual ones.
+/// </param>
+void LIBBENCHLAB_TEST_API convert_readings(
+    _Out_writes_(cnt) benchlab_sample *dst,
+    _In_reads_(cnt) const benchlab_sensor_readings *src,
+    _In_ const std::size_t cnt,
+    _In_reads_opt_(cnt) const benchlab_timestamp *timestamps,
+    _In_ const benchlab_timestamp now) noexcept;
+
+/// <summary>
+/// Converts the readings like <see cref="convert_readings" />, but using the
+/// given instruction set, which must be supported by the processor.
+/// </summary>
+void LIBBENCHLAB_TEST_API convert_readings(
+    _In_ const conversion_isa isa,
+    _Out_writes_(cnt) benchlab_sample *dst,
+    _In_reads_(cnt) const benchlab_sensor_readings *src,
+    _In_ const std::size_t cnt,
+    _In_reads_opt_(cnt) const benchlab_timestamp *timestamps,
+    _In_ const benchlab_timestamp now) noexcept;
+
+/// <summary>
+/// Answer the best instruction set for the conversion that the processor
+/// supports.
+/// </summary>
+conversion_isa LIBBENCHLAB_TEST_API supported_conversion_isa(void) noexcept;
+
+#endif /* !defined(_BENCHLAB_SAMPLE_CONVERSION_H) */
@@ -0,0 +1,41 @@
+﻿// <copyright file="sample_schedule.cpp" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#include "sample_schedule.h"
+
+#if defined(_WIN32)
+#include <thread>
+#else /* defined(_WIN32) */
+#include <cerrno>
+
+#include <time.h>
+#endif /* defined(_WIN32) */
+
+
+/*
+ * sample_schedule::sleep_until
+ */
+void sample_schedule::sleep_until(
+        _In_ const clock_type::time_point deadline) noexcept {
+#if defined(_WIN32)
+    std::this_thread::sleep_until(deadline);
+
+#else /* defined(_WIN32) */
+    using namespace std::chrono;
+
+    // The steady clock of libstdc++ and libc++ is CLOCK_MONOTONIC on Linux,
+    // so its time points can be used as absolute deadlines of the clock.
+    const auto t = deadline.time_since_epoch();
+    const auto s = duration_cast<seconds>(t);
+    timespec ts;
+    ts.tv_sec = static_cast<time_t>(s.count());
+    ts.tv_nsec = static_cast<long>(duration_cast<nanoseconds>(t - s).count());
+
+    // Interrupted sleeps can be resumed with the same absolute deadline.
+    while (::clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr)
+            == EINTR);
+#endif /* defined(_WIN32) */
+}
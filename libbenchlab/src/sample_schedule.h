@@ -0,0 +1,125 @@
+﻿// <copyright file="sample_schedule.h" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#if !defined(_BENCHLAB_SAMPLE_SCHEDULE_H)
+#define _BENCHLAB_SAMPLE_SCHEDULE_H
+#pragma once
+
+#include <chrono>
+#include <cinttypes>
+
+#include "libbenchlab/api.h"
+#include "libbenchlab/streaming.h"
+
+
+/// <summary>
+/// Determines when the samples of a stream are due.
+/// </summary>
+/// <remarks>
+/// <para>The deadlines form a grid of absolute points in time that are one
+/// period apart, such that neither the time spent on acquiring and
+/// delivering a sample nor the latency of waking up accumulates over the
+/// course of a recording. If a sample is requested a whole period or more
+/// after its deadline, the <see cref="benchlab_overrun_policy" />
+/// determines how the schedule continues.</para>
+/// <para>The schedule is used by the streaming thread and by the acquisition
+/// state machine alike.</para>
+/// </remarks>
+class LIBBENCHLAB_TEST_API sample_schedule final {
+
+public:
+
+    typedef std::chrono::steady_clock clock_type;
+
+    /// <summary>
+    /// Blocks the calling thread until <paramref name="deadline" />.
+    /// </summary>
+    /// <remarks>
+    /// On Linux, the thread sleeps via <c>clock_nanosleep</c> with an
+    /// absolute deadline, which cannot oversleep because of being preempted
+    /// between computing and starting a relative sleep.
+    /// </remarks>
+    static void sleep_until(_In_ const clock_type::time_point deadline)
+        noexcept;
+
+    /// <summary>
+    /// Initialises a new instance with the first deadline at
+    /// <paramref name="start" />.
+    /// </summary>
+    inline sample_schedule(
+            _In_ const benchlab_streaming_configuration& config,
+            _In_ const clock_type::time_point start) noexcept
+        : _deadline(start),
+        _period(std::chrono::milliseconds(config.period)),
+        _policy(config.overrun_policy) { }
+
+    /// <summary>
+    /// Advances the schedule after the sample that is due at
+    /// <see cref="deadline" /> has been requested at <paramref name="now" />.
+    /// </summary>
+    /// <returns>The number of overruns, which is the number of skipped
+    /// deadlines for <see cref="benchlab_overrun_policy::skip" /> and one
+    /// for any other policy if the request was late by at least a period.
+    /// </returns>
+    inline std::uint64_t advance(
+            _In_ const clock_type::time_point now) noexcept {
+        std::uint64_t retval = 0;
+        auto next = this->_deadline + this->_period;
+
+        if ((this->_period > clock_type::duration::zero()) && (now >= next)) {
+            switch (this->_policy) {
+                case benchlab_overrun_policy::catch_up:
+                    // Keep the deadline, which is due immediately.
+                    retval = 1;
+                    break;
+
+                case benchlab_overrun_policy::rephase:
+                    retval = 1;
+                    next = now + this->_period;
+                    break;
+
+                default:
+                    retval = static_cast<std::uint64_t>(
+                        (now - this->_deadline) / this->_period);
+                    next = this->_deadline + (retval + 1) * this->_period;
+                    break;
+            }
+        }
+
+        this->_deadline = next;
+        return retval;
+    }
+
+    /// <summary>
+    /// Gets the point in time when the next sample is due.
+    /// </summary>
+    inline clock_type::time_point deadline(void) const noexcept {
+        return this->_deadline;
+    }
+
+    /// <summary>
+    /// Gets the time between two deadlines.
+    /// </summary>
+    inline clock_type::duration period(void) const noexcept {
+        return this->_period;
+    }
+
+    /// <summary>
+    /// Moves the grid of deadlines such that the next sample is due at
+    /// <paramref name="deadline" />, which is used after a failure.
+    /// </summary>
+    inline void restart(_In_ const clock_type::time_point deadline) noexcept {
+        this->_deadline = deadline;
+    }
+
+private:
+
+    clock_type::time_point _deadline;
+    clock_type::duration _period;
+    benchlab_overrun_policy _policy;
+};
+
+#endif /* !defined(_BENCHLAB_SAMPLE_SCHEDULE_H) */
@@ -0,0 +1,325 @@
+﻿// <copyright file="sensor_frame.h" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#if !defined(_BENCHLAB_SENSOR_FRAME_H)
+#define _BENCHLAB_SENSOR_FRAME_H
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cinttypes>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+#include "libbenchlab/api.h"
+#include "libbenchlab/channel_descriptors.h"
+#include "libbenchlab/types.h"
+
+#include "device_model.h"
+#include "sample_conversion.h"
+
+
+/// <summary>
+/// Describes where a value is stored in a frame sent by the device.
+/// </summary>
+struct wire_field final {
+
+    /// <summary>
+    /// The offset of the first byte of the value from the begin of the frame.
+    /// </summary>
+    std::size_t offset;
+
+    /// <summary>
+    /// The number of bytes of the value, which is stored in little-endian
+    /// byte order.
+    /// </summary>
+    std::size_t width;
+
+    /// <summary>
+    /// Answer the offset of the first byte after the value.
+    /// </summary>
+    constexpr std::size_t end(void) const noexcept {
+        return this->offset + this->width;
+    }
+};
+
+
+/// <summary>
+/// Describes the layout of the frame that a device of the given model sends
+/// in response to <see cref="benchlab_command::read_sensors" />.
+/// </summary>
+/// <remarks>
+/// <para>The schema describes the bytes on the wire rather than relying on the
+/// compiler to lay out <see cref="benchlab_sensor_readings" /> the same way
+/// as the firmware does. The gaps in the frame, e.g. between the voltage and
+/// the current of a power sensor, are padding that the firmware sends, but
+/// that carries no information.</para>
+/// <para>The firmware sends the groups of sensors back to back, so the
+/// location of each field follows from the number of sensors in the model.
+/// </para>
+/// <para>All multi-byte values are little-endian.</para>
+/// </remarks>
+/// <typeparam name="TModel">The <see cref="device_model" /> describing the
+/// sensors of the device.</typeparam>
+template<class TModel>
+struct basic_sensor_frame final {
+
+    /// <summary>
+    /// The model of the device sending the frame.
+    /// </summary>
+    typedef TModel model_type;
+
+    static constexpr wire_field vin(_In_ const std::size_t i) noexcept {
+        return wire_field { 2 * i, 2 };
+    }
+
+    static constexpr wire_field vdd { 2 * TModel::vin_sensors, 2 };
+    static constexpr wire_field vref { vdd.end(), 2 };
+    static constexpr wire_field tchip { vref.end(), 2 };
+
+    static constexpr wire_field ts(_In_ const std::size_t i) noexcept {
+        return wire_field { tchip.end() + 2 * i, 2 };
+    }
+
+    static constexpr wire_field tamb {
+        tchip.end() + 2 * TModel::temperature_sensors, 2 };
+    static constexpr wire_field hum { tamb.end(), 2 };
+    static constexpr wire_field fan_switch { hum.end(), 1 };
+    static constexpr wire_field rgb_switch { fan_switch.end(), 1 };
+    static constexpr wire_field rgb_extended_status { rgb_switch.end(), 1 };
+    static constexpr wire_field external_fan_duty {
+        rgb_extended_status.end(), 1 };
+
+    static constexpr wire_field power_voltage(
+            _In_ const std::size_t i) noexcept {
+        return wire_field { external_fan_duty.end() + 12 * i, 2 };
+    }
+
+    static constexpr wire_field power_current(
+            _In_ const std::size_t i) noexcept {
+        return wire_field { external_fan_duty.end() + 12 * i + 4, 4 };
+    }
+
+    static constexpr wire_field power_power(
+            _In_ const std::size_t i) noexcept {
+        return wire_field { external_fan_duty.end() + 12 * i + 8, 4 };
+    }
+
+    static constexpr wire_field fan_enable(_In_ const std::size_t i) noexcept {
+        return wire_field { power_voltage(TModel::power_sensors).offset
+            + 4 * i, 1 };
+    }
+
+    static constexpr wire_field fan_duty(_In_ const std::size_t i) noexcept {
+        return wire_field { fan_enable(i).offset + 1, 1 };
+    }
+
+    static constexpr wire_field fan_tach(_In_ const std::size_t i) noexcept {
+        return wire_field { fan_enable(i).offset + 2, 2 };
+    }
+
+    /// <summary>
+    /// The number of bytes in a frame.
+    /// </summary>
+    static constexpr std::size_t size = fan_enable(TModel::fans).offset;
+
+    /// <summary>
+    /// Gets the field holding the raw reading of the channel described by
+    /// <paramref name="descriptor" />.
+    /// </summary>
+    static constexpr wire_field field(
+            _In_ const benchlab_channel_descriptor& descriptor) noexcept {
+        const auto i = descriptor.sensor;
+        switch (descriptor.channel) {
+            case benchlab_channel::input_voltage: return vin(i);
+            case benchlab_channel::supply_voltage: return vdd;
+            case benchlab_channel::reference_voltage: return vref;
+            case benchlab_channel::chip_temperature: return tchip;
+            case benchlab_channel::temperature: return ts(i);
+            case benchlab_channel::ambient_temperature: return tamb;
+            case benchlab_channel::humidity: return hum;
+            case benchlab_channel::external_fan_duty: return external_fan_duty;
+            case benchlab_channel::voltage: return power_voltage(i);
+            case benchlab_channel::current: return power_current(i);
+            case benchlab_channel::power: return power_power(i);
+            case benchlab_channel::fan_speed: return fan_tach(i);
+            case benchlab_channel::fan_duty: return fan_duty(i);
+            default: return wire_field { size, 0 };
+        }
+    }
+
+    /// <summary>
+    /// Answer whether the raw offsets and types in the channel descriptors
+    /// match the fields of the frame.
+    /// </summary>
+    static constexpr bool matches_channel_descriptors(void) noexcept {
+        for (auto& d : visus::benchlab::channel_descriptors) {
+            const auto f = field(d);
+            if (f.offset != d.raw_offset) {
+                return false;
+            }
+
+            switch (d.raw_type) {
+                case benchlab_value_type::int16:
+                case benchlab_value_type::uint16:
+                    if (f.width != 2) {
+                        return false;
+                    }
+                    break;
+
+                case benchlab_value_type::int32:
+                    if (f.width != 4) {
+                        return false;
+                    }
+                    break;
+
+                case benchlab_value_type::uint8:
+                    if (f.width != 1) {
+                        return false;
+                    }
+                    break;
+
+                default:
+                    return false;
+            }
+        }
+
+        return true;
+    }
+
+    /// <summary>
+    /// Restores the sensor readings from a frame.
+    /// </summary>
+    /// <remarks>
+    /// The readings of sensors that the model does not have are zero.
+    /// </remarks>
+    /// <param name="dst">Receives the readings.</param>
+    /// <param name="src">The <see cref="size" /> bytes of the frame.</param>
+    static void decode(_Out_ benchlab_sensor_readings& dst,
+        _In_reads_(size) const std::uint8_t *src) noexcept;
+
+    /// <summary>
+    /// Converts <paramref name="cnt" /> consecutive frames to samples.
+    /// </summary>
+    /// <remarks>
+    /// The frames are decoded in chunks that stay in the cache, which are
+    /// converted using <see cref="convert_readings" />.
+    /// </remarks>
+    /// <param name="dst">Receives <paramref name="cnt" /> samples.</param>
+    /// <param name="src">The <paramref name="cnt" /> frames.</param>
+    /// <param name="cnt">The number of frames to convert.</param>
+    /// <param name="timestamps">The timestamps of the individual samples, or
+    /// <c>nullptr</c> for using <paramref name="now" /> for all of them.
+    /// </param>
+    /// <param name="now">The timestamp used if there are no individual ones.
+    /// </param>
+    static void decode(_Out_writes_(cnt) benchlab_sample *dst,
+        _In_reads_bytes_(cnt * size) const std::uint8_t *src,
+        _In_ const std::size_t cnt,
+        _In_reads_opt_(cnt) const benchlab_timestamp *timestamps,
+        _In_ const benchlab_timestamp now) noexcept;
+
+    /// <summary>
+    /// Converts the sensor readings into a frame as sent by the firmware.
+    /// </summary>
+    /// <param name="dst">Receives the <see cref="size" /> bytes of the frame.
+    /// </param>
+    /// <param name="src">The readings to be serialised. Readings of sensors
+    /// that the model does not have are ignored.</param>
+    static void encode(_Out_writes_(size) std::uint8_t *dst,
+        _In_ const benchlab_sensor_readings& src) noexcept;
+
+    /// <summary>
+    /// Reads the unsigned value described by <paramref name="field" /> from
+    /// <paramref name="src" />.
+    /// </summary>
+    template<class TValue>
+    static inline TValue load(_In_reads_(size) const std::uint8_t *src,
+            _In_ const wire_field field) noexcept {
+        static_assert(std::is_integral<TValue>::value, "Only integral values "
+            "can be loaded from a frame.");
+        typedef std::make_unsigned_t<TValue> unsigned_type;
+        unsigned_type retval = 0;
+        for (std::size_t i = 0; i < field.width; ++i) {
+            retval |= static_cast<unsigned_type>(static_cast<unsigned_type>(
+                src[field.offset + i]) << (8 * i));
+        }
+        return static_cast<TValue>(retval);
+    }
+
+    /// <summary>
+    /// Writes <paramref name="value" /> to the location described by
+    /// <paramref name="field" /> in <paramref name="dst" />.
+    /// </summary>
+    template<class TValue>
+    static inline void store(_Out_writes_(size) std::uint8_t *dst,
+            _In_ const wire_field field,
+            _In_ const TValue value) noexcept {
+        static_assert(std::is_integral<TValue>::value, "Only integral values "
+            "can be stored in a frame.");
+        typedef std::make_unsigned_t<TValue> unsigned_type;
+        const auto v = static_cast<unsigned_type>(value);
+        for (std::size_t i = 0; i < field.width; ++i) {
+            dst[field.offset + i] = static_cast<std::uint8_t>(v >> (8 * i));
+        }
+    }
+};
+
+
+/// <summary>
+/// The frame sent by <see cref="benchlab_model_v1" />, which is the format
+/// of <see cref="BENCHLAB_SENSOR_FRAME_SIZE" />-byte frames in the public
+/// API.
+/// </summary>
+typedef basic_sensor_frame<benchlab_model_v1> sensor_frame;
+
+
+// Make sure that the fields follow each other without overlapping and
+// that the frame ends where the firmware stops sending.
+static_assert(sensor_frame::size == BENCHLAB_SENSOR_FRAME_SIZE, "The "
+    "firmware sends 216 bytes in response to a request for the sensor "
+    "readings.");
+static_assert(sensor_frame::vin(0).offset == 0, "The frame must start with "
+    "the input voltages.");
+static_assert(sensor_frame::vin(BENCHLAB_VIN_SENSORS - 1).end()
+    == sensor_frame::vdd.offset, "The input voltages overlap.");
+static_assert(sensor_frame::vdd.end() == sensor_frame::vref.offset,
+    "The supply voltage overlaps.");
+static_assert(sensor_frame::vref.end() == sensor_frame::tchip.offset,
+    "The reference voltage overlaps.");
+static_assert(sensor_frame::tchip.end() == sensor_frame::ts(0).offset,
+    "The chip temperature overlaps.");
+static_assert(sensor_frame::ts(BENCHLAB_TEMPERATURE_SENSORS - 1).end()
+    == sensor_frame::tamb.offset, "The temperatures overlap.");
+static_assert(sensor_frame::tamb.end() == sensor_frame::hum.offset,
+    "The ambient temperature overlaps.");
+static_assert(sensor_frame::hum.end() == sensor_frame::fan_switch.offset,
+    "The humidity overlaps.");
+static_assert(sensor_frame::external_fan_duty.end()
+    == sensor_frame::power_voltage(0).offset,
+    "The status bytes overlap.");
+static_assert(sensor_frame::power_voltage(0).end()
+    <= sensor_frame::power_current(0).offset,
+    "The voltage of a power sensor overlaps.");
+static_assert(sensor_frame::power_current(0).end()
+    == sensor_frame::power_power(0).offset,
+    "The current of a power sensor overlaps.");
+static_assert(sensor_frame::power_power(BENCHLAB_POWER_SENSORS - 1).end()
+    == sensor_frame::fan_enable(0).offset,
+    "The power sensors overlap.");
+static_assert(sensor_frame::fan_tach(BENCHLAB_FANS - 1).end()
+    == sensor_frame::size, "The fans do not end with the frame.");
+static_assert(sensor_frame::power_voltage(0).offset == 48, "The power "
+    "sensors start where the firmware sends them.");
+static_assert(sensor_frame::fan_enable(0).offset == 180, "The fans start "
+    "where the firmware sends them.");
+static_assert(sensor_frame::matches_channel_descriptors(), "The channel "
+    "descriptors locate the raw readings where the frame has them.");
+
+#include "sensor_frame.inl"
+
+#endif /* !defined(_BENCHLAB_SENSOR_FRAME_H) */
@@ -0,0 +1,121 @@
+﻿// <copyright file="sensor_frame.inl" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+
+
+/*
+ * basic_sensor_frame<TModel>::decode
+ */
+template<class TModel>
+void basic_sensor_frame<TModel>::decode(_Out_ benchlab_sensor_readings& dst,
+        _In_reads_(size) const std::uint8_t *src) noexcept {
+    // Clear the padding, which is not sent.
+    ::memset(&dst, 0, sizeof(dst));
+
+    unroll<TModel::vin_sensors>([&](const auto i) {
+        dst.vin[i] = load<std::int16_t>(src, vin(i));
+    });
+
+    dst.vdd = load<std::uint16_t>(src, vdd);
+    dst.vref = load<std::uint16_t>(src, vref);
+    dst.tchip = load<std::int16_t>(src, tchip);
+
+    unroll<TModel::temperature_sensors>([&](const auto i) {
+        dst.ts[i] = load<std::int16_t>(src, ts(i));
+    });
+
+    dst.tamb = load<std::int16_t>(src, tamb);
+    dst.hum = load<std::uint16_t>(src, hum);
+    dst.fan_switch = static_cast<benchlab_fan_switch_status>(
+        load<std::uint8_t>(src, fan_switch));
+    dst.rgb_switch = static_cast<benchlab_rgb_switch_status>(
+        load<std::uint8_t>(src, rgb_switch));
+    dst.rgb_extended_status = static_cast<benchlab_rgb_extended_status>(
+        load<std::uint8_t>(src, rgb_extended_status));
+    dst.external_fan_duty = load<std::uint8_t>(src, external_fan_duty);
+
+    unroll<TModel::power_sensors>([&](const auto i) {
+        auto& p = dst.power_readings[i];
+        p.voltage = load<std::int16_t>(src, power_voltage(i));
+        p.current = load<std::int32_t>(src, power_current(i));
+        p.power = load<std::int32_t>(src, power_power(i));
+    });
+
+    unroll<TModel::fans>([&](const auto i) {
+        auto& f = dst.fans[i];
+        f.enable = load<std::uint8_t>(src, fan_enable(i));
+        f.duty = load<std::uint8_t>(src, fan_duty(i));
+        f.tach = load<std::uint16_t>(src, fan_tach(i));
+    });
+}
+
+
+/*
+ * basic_sensor_frame<TModel>::decode
+ */
+template<class TModel>
+void basic_sensor_frame<TModel>::decode(_Out_writes_(cnt) benchlab_sample *dst,
+        _In_reads_bytes_(cnt * size) const std::uint8_t *src,
+        _In_ const std::size_t cnt,
+        _In_reads_opt_(cnt) const benchlab_timestamp *timestamps,
+        _In_ const benchlab_timestamp now) noexcept {
+    std::array<benchlab_sensor_readings, 32> readings;
+
+    for (std::size_t i = 0; i < cnt; i += readings.size()) {
+        const auto n = (std::min)(readings.size(), cnt - i);
+
+        for (std::size_t j = 0; j < n; ++j) {
+            decode(readings[j], src + (i + j) * size);
+        }
+
+        convert_readings(dst + i, readings.data(), n,
+            (timestamps != nullptr) ? timestamps + i : nullptr, now);
+    }
+}
+
+
+/*
+ * basic_sensor_frame<TModel>::encode
+ */
+template<class TModel>
+void basic_sensor_frame<TModel>::encode(_Out_writes_(size) std::uint8_t *dst,
+        _In_ const benchlab_sensor_readings& src) noexcept {
+    ::memset(dst, 0, size);
+
+    unroll<TModel::vin_sensors>([&](const auto i) {
+        store(dst, vin(i), src.vin[i]);
+    });
+
+    store(dst, vdd, src.vdd);
+    store(dst, vref, src.vref);
+    store(dst, tchip, src.tchip);
+
+    unroll<TModel::temperature_sensors>([&](const auto i) {
+        store(dst, ts(i), src.ts[i]);
+    });
+
+    store(dst, tamb, src.tamb);
+    store(dst, hum, src.hum);
+    store(dst, fan_switch, static_cast<std::uint8_t>(src.fan_switch));
+    store(dst, rgb_switch, static_cast<std::uint8_t>(src.rgb_switch));
+    store(dst, rgb_extended_status,
+        static_cast<std::uint8_t>(src.rgb_extended_status));
+    store(dst, external_fan_duty, src.external_fan_duty);
+
+    unroll<TModel::power_sensors>([&](const auto i) {
+        auto& p = src.power_readings[i];
+        store(dst, power_voltage(i), p.voltage);
+        store(dst, power_current(i), p.current);
+        store(dst, power_power(i), p.power);
+    });
+
+    unroll<TModel::fans>([&](const auto i) {
+        auto& f = src.fans[i];
+        store(dst, fan_enable(i), f.enable);
+        store(dst, fan_duty(i), f.duty);
+        store(dst, fan_tach(i), f.tach);
+    });
+}
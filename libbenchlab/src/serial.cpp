@@ -6,6 +6,54 @@
 
 #include "libbenchlab/serial.h"
 
+#include "serial_configuration.h"
+
+
+/*
+ * ::copy_serial_configuration
+ */
+HRESULT copy_serial_configuration(_Out_ benchlab_serial_configuration& dst,
+        _In_opt_ const benchlab_serial_configuration *src) noexcept {
+    dst.version = 3;
+    {
+        auto hr = ::benchlab_initialise_serial_configuration(&dst);
+        if (FAILED(hr)) {
+            return hr;
+        }
+    }
+
+    if (src == nullptr) {
+        return S_OK;
+    }
+
+    switch (src->version) {
+        case 3:
+            /* The capture path is ignored on purpose. */
+            /* Fall through. */
+
+        case 2:
+            dst.calibrate_command_sleep = src->calibrate_command_sleep;
+            dst.calibration_rounds = src->calibration_rounds;
+            /* Fall through. */
+
+        case 1:
+            dst.baud_rate = src->baud_rate;
+            dst.command_sleep = src->command_sleep;
+            dst.data_bits = src->data_bits;
+            dst.dtr_enable = src->dtr_enable;
+            dst.handshake = src->handshake;
+            dst.parity = src->parity;
+            dst.read_timeout = src->read_timeout;
+            dst.rts_enable = src->rts_enable;
+            dst.stop_bits = src->stop_bits;
+            dst.write_timeout = src->write_timeout;
+            return S_OK;
+
+        default:
+            return E_INVALIDARG;
+    }
+}
+
 
 /*
  * ::benchlab_initialise_serial_configuration
@@ -17,6 +65,15 @@ HRESULT LIBBENCHLAB_API benchlab_initialise_serial_configuration(
     }
 
     switch (config->version) {
+        case 3:
+            config->capture_path = nullptr;
+            /* Fall through. */
+
+        case 2:
+            config->calibrate_command_sleep = false;
+            config->calibration_rounds = 8;
+            /* Fall through. */
+
         case 1:
             config->baud_rate = 115200;
             config->command_sleep = 10;
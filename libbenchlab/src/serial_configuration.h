@@ -0,0 +1,31 @@
+﻿// <copyright file="serial_configuration.h" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#if !defined(_BENCHLAB_SERIAL_CONFIGURATION_H)
+#define _BENCHLAB_SERIAL_CONFIGURATION_H
+#pragma once
+
+#include "libbenchlab/serial.h"
+
+
+/// <summary>
+/// Creates a copy of the latest version of <paramref name="src" /> in
+/// <paramref name="dst" />, which can be retained by the library.
+/// </summary>
+/// <remarks>
+/// Members not present in the version of <paramref name="src" /> are set to
+/// their defaults. The capture path is never copied, because the caller only
+/// guarantees the string to be valid during the call that passed it in.
+/// </remarks>
+/// <param name="dst">Receives the copy.</param>
+/// <param name="src">The configuration to be copied. If this is
+/// <c>nullptr</c>, <paramref name="dst" /> receives the defaults.</param>
+/// <returns><c>S_OK</c> in case of success, <c>E_INVALIDARG</c> if the
+/// version of <paramref name="src" /> is not supported.</returns>
+HRESULT copy_serial_configuration(_Out_ benchlab_serial_configuration& dst,
+    _In_opt_ const benchlab_serial_configuration *src) noexcept;
+
+#endif /* !defined(_BENCHLAB_SERIAL_CONFIGURATION_H) */
@@ -0,0 +1,645 @@
+﻿// <copyright file="serial_transport.cpp" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2024 - 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#include "serial_transport.h"
+
+#include <cassert>
+#include <cerrno>
+#include <limits>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+#include <linux/serial.h>
+#include <sys/ioctl.h>
+#endif /* !defined(_WIN32) */
+
+#include "debug.h"
+
+
+#if !defined(_WIN32)
+/// <summary>
+/// Converts the numeric <paramref name="baud_rate" /> into the constant
+/// used by termios.
+/// </summary>
+/// <param name="speed">Receives the termios constant.</param>
+/// <param name="baud_rate">The baud rate in bits per second.</param>
+/// <returns><c>S_OK</c> in case of success, <c>E_INVALIDARG</c> if the
+/// baud rate is not supported by termios.</returns>
+static HRESULT to_speed(_Out_ speed_t& speed,
+        _In_ const std::uint32_t baud_rate) noexcept {
+    switch (baud_rate) {
+        case 1200: speed = B1200; return S_OK;
+        case 2400: speed = B2400; return S_OK;
+        case 4800: speed = B4800; return S_OK;
+        case 9600: speed = B9600; return S_OK;
+        case 19200: speed = B19200; return S_OK;
+        case 38400: speed = B38400; return S_OK;
+        case 57600: speed = B57600; return S_OK;
+        case 115200: speed = B115200; return S_OK;
+        case 230400: speed = B230400; return S_OK;
+        case 460800: speed = B460800; return S_OK;
+        case 500000: speed = B500000; return S_OK;
+        case 576000: speed = B576000; return S_OK;
+        case 921600: speed = B921600; return S_OK;
+        case 1000000: speed = B1000000; return S_OK;
+        case 1152000: speed = B1152000; return S_OK;
+        case 1500000: speed = B1500000; return S_OK;
+        case 2000000: speed = B2000000; return S_OK;
+        default: speed = B0; return E_INVALIDARG;
+    }
+}
+#endif /* !defined(_WIN32) */
+
+
+/*
+ * serial_transport::serial_transport
+ */
+serial_transport::serial_transport(void) noexcept
+    : _event_driven(true),
+        _handle(invalid_handle),
+        _write_timeout(0) { }
+
+
+/*
+ * serial_transport::~serial_transport
+ */
+serial_transport::~serial_transport(void) noexcept {
+    if (this->is_open()) {
+        this->close();
+    }
+}
+
+
+/*
+ * serial_transport::available
+ */
+HRESULT serial_transport::available(_Out_ std::size_t& cnt) noexcept {
+    if (!this->is_open()) {
+        cnt = 0;
+        return closed_error();
+    }
+
+#if defined(_WIN32)
+    COMSTAT status;
+    if (!::ClearCommError(this->_handle, nullptr, &status)) {
+        cnt = 0;
+        return HRESULT_FROM_WIN32(::GetLastError());
+    }
+
+    cnt = status.cbInQue;
+    return S_OK;
+
+#else /* defined(_WIN32) */
+    int queued = 0;
+    if (::ioctl(this->_handle, FIONREAD, &queued) != 0) {
+        cnt = 0;
+        return static_cast<HRESULT>(-errno);
+    }
+
+    cnt = static_cast<std::size_t>(queued);
+    return S_OK;
+#endif /* defined(_WIN32) */
+}
+
+
+/*
+ * serial_transport::close
+ */
+HRESULT serial_transport::close(void) noexcept {
+#if defined(_WIN32)
+    auto retval = ::CloseHandle(this->_handle)
+        ? S_OK
+        : HRESULT_FROM_WIN32(::GetLastError());
+#else /* defined(_WIN32) */
+    auto retval = (::close(this->_handle) == 0)
+        ? S_OK
+        : static_cast<HRESULT>(-errno);
+#endif /* defined(_WIN32) */
+
+    this->_handle = invalid_handle;
+    return retval;
+}
+
+
+#if !defined(_WIN32)
+/*
+ * serial_transport::descriptor
+ */
+int serial_transport::descriptor(void) const noexcept {
+    return this->_handle;
+}
+#endif /* !defined(_WIN32) */
+
+
+/*
+ * serial_transport::open
+ */
+HRESULT serial_transport::open(_In_z_ const benchlab_char *path,
+        _In_ const benchlab_serial_configuration *config) noexcept {
+    assert(path != nullptr);
+    assert(config != nullptr);
+
+    if (this->is_open()) {
+        _benchlab_debug("Tried opening a serial port that is already "
+            "open.\r\n");
+        return E_NOT_VALID_STATE;
+    }
+
+#if defined(_WIN32)
+    // With a zero timeout, ReadFile returns immediately rather than blocking
+    // for the first byte.
+    this->_event_driven = (config->read_timeout > 0);
+
+    this->_handle = ::CreateFileW(path, GENERIC_READ | GENERIC_WRITE, 0,
+        nullptr, OPEN_EXISTING, 0, NULL);
+    if (this->_handle == invalid_handle) {
+        auto retval = HRESULT_FROM_WIN32(::GetLastError());
+        _benchlab_debug("CreateFile on COM port failed.\r\n");
+        return retval;
+    }
+
+    {
+        DCB dcb { 0 };
+        dcb.DCBlength = sizeof(dcb);
+
+        if (!::GetCommState(this->_handle, &dcb)) {
+            auto retval = HRESULT_FROM_WIN32(::GetLastError());
+            _benchlab_debug("Retrieving state of COM port failed.\r\n");
+            this->close();
+            return retval;
+        }
+
+        dcb.BaudRate = static_cast<DWORD>(config->baud_rate);
+        dcb.ByteSize = static_cast<BYTE>(config->data_bits);
+        dcb.Parity = static_cast<BYTE>(config->parity);
+        dcb.StopBits = static_cast<BYTE>(config->stop_bits);
+
+        // Like in the .NET framework, mak the handshake stuff to DCB. Cf.
+        // https://github.com/dotnet/runtime/blob/9d5a6a9aa463d6d10b0b0ba6d5982cc82f363dc3/src/libraries/System.IO.Ports/src/System/IO/Ports/SerialStream.Windows.cs#L191-L235
+        const auto rts = (config->handshake
+            == benchlab_handshake::request_to_send);
+        const auto rts_xon_xoff = (config->handshake
+            == benchlab_handshake::request_to_send_xon_xoff);
+        const auto xon_xoff = (config->handshake
+            == benchlab_handshake::xon_xoff);
+
+        dcb.fInX = dcb.fOutX = (xon_xoff || rts_xon_xoff) ? 1 : 0;
+        dcb.fOutxCtsFlow = (rts || rts_xon_xoff) ? 1 : 0;
+
+        if (rts || rts_xon_xoff) {
+            dcb.fRtsControl = RTS_CONTROL_HANDSHAKE;
+        //} else if (_rtsEnable) {
+        //    SetDcbFlag(Interop.Kernel32.DCBFlags.FRTSCONTROL, Interop.Kernel32.DCBRTSFlowControl.RTS_CONTROL_ENABLE);
+        } else {
+            dcb.fRtsControl = RTS_CONTROL_DISABLE;
+        }
+
+        if (!::SetCommState(this->_handle, &dcb)) {
+            auto retval = HRESULT_FROM_WIN32(::GetLastError());
+            _benchlab_debug("Updating state of COM port failed.\r\n");
+            this->close();
+            return retval;
+        }
+    }
+
+    {
+        COMMTIMEOUTS cto { 0 };
+        constexpr auto infinite = (std::numeric_limits<std::uint32_t>::max)();
+        // Cf. https://github.com/dotnet/runtime/blob/9d5a6a9aa463d6d10b0b0ba6d5982cc82f363dc3/src/libraries/System.IO.Ports/src/System/IO/Ports/SerialStream.Windows.cs#L363-L364
+        constexpr auto infinite_magic = -2;
+
+        if (config->read_timeout == 0) {
+            cto.ReadTotalTimeoutConstant = 0;
+            cto.ReadTotalTimeoutMultiplier = 0;
+            cto.ReadIntervalTimeout = MAXDWORD;
+
+        } else if (config->read_timeout == infinite) {
+            cto.ReadTotalTimeoutConstant = infinite_magic;
+            cto.ReadTotalTimeoutMultiplier = 0;
+            cto.ReadIntervalTimeout = MAXDWORD;
+
+        } else {
+            cto.ReadTotalTimeoutConstant = config->read_timeout;
+            cto.ReadTotalTimeoutMultiplier = MAXDWORD;
+            cto.ReadIntervalTimeout = MAXDWORD;
+        }
+
+        cto.WriteTotalTimeoutConstant = config->write_timeout;
+        if (cto.WriteTotalTimeoutConstant == infinite) {
+            cto.WriteTotalTimeoutConstant = 0;
+        }
+
+        if (!::SetCommTimeouts(this->_handle, &cto)) {
+            auto retval = HRESULT_FROM_WIN32(::GetLastError());
+            _benchlab_debug("Setting COM timeouts failed.\r\n");
+            this->close();
+            return retval;
+        }
+    }
+
+    return S_OK;
+
+#else /* defined(_WIN32) */
+    // Note: like on Windows, a write timeout of zero or the maximum value
+    // indicates that writes never time out.
+    this->_write_timeout = (config->write_timeout
+        == (std::numeric_limits<std::uint32_t>::max)())
+        ? std::chrono::milliseconds::zero()
+        : std::chrono::milliseconds(config->write_timeout);
+
+    // Open the port in non-blocking mode. This prevents the call from hanging
+    // until the carrier detect line is raised and allows us to implement the
+    // timeouts on our own.
+    this->_handle = ::open(path, O_RDWR | O_NOCTTY | O_NONBLOCK
+        | O_CLOEXEC);
+    if (this->_handle == invalid_handle) {
+        auto retval = static_cast<HRESULT>(-errno);
+        _benchlab_debug("Opening the serial port failed.\r\n");
+        return retval;
+    }
+
+    // Prevent other processes from opening the port while we are using it.
+    // This mirrors the exclusive sharing mode we use on Windows.
+    if (::ioctl(this->_handle, TIOCEXCL) != 0) {
+        _benchlab_debug("Acquiring exclusive access to the serial port "
+            "failed.\r\n");
+    }
+
+    {
+        auto hr = this->configure(config);
+        if (FAILED(hr)) {
+            this->close();
+            return hr;
+        }
+    }
+
+    return S_OK;
+#endif /* defined(_WIN32) */
+}
+
+
+/*
+ * serial_transport::read
+ */
+HRESULT serial_transport::read(_Out_writes_bytes_(cnt) void *dst,
+        _Inout_ std::size_t& cnt) noexcept {
+    assert(dst != nullptr);
+
+    if (!this->is_open()) {
+        cnt = 0;
+        return closed_error();
+    }
+
+#if defined(_WIN32)
+    DWORD read;
+
+    if (::ReadFile(this->_handle, dst, static_cast<DWORD>(cnt), &read,
+        nullptr)) {
+        cnt = read;
+        return S_OK;
+
+    } else {
+        cnt = 0;
+        _benchlab_debug("I/O erro while reading from COM.\r\n");
+        return HRESULT_FROM_WIN32(::GetLastError());
+    }
+
+#else /* defined(_WIN32) */
+    auto read = ::read(this->_handle, dst, cnt);
+    if (read < 0) {
+        cnt = 0;
+
+        // The port is non-blocking, so an empty input queue is not an error,
+        // but just means that nothing has been read yet.
+        if ((errno == EAGAIN) || (errno == EWOULDBLOCK) || (errno == EINTR)) {
+            return S_OK;
+        }
+
+        _benchlab_debug("I/O erro while reading from COM.\r\n");
+        return static_cast<HRESULT>(-errno);
+    } else {
+        cnt = static_cast<std::size_t>(read);
+        return S_OK;
+    }
+#endif /* defined(_WIN32) */
+}
+
+
+/*
+ * serial_transport::wait
+ */
+HRESULT serial_transport::wait(
+        _In_ const clock_type::time_point deadline) noexcept {
+    using namespace std::chrono;
+    const auto now = clock_type::now();
+
+    if (!this->is_open()) {
+        return closed_error();
+    }
+
+    if (now > deadline) {
+        return timeout_error();
+    }
+
+#if defined(_WIN32)
+    // ReadFile blocks until at least one byte has been received or the read
+    // timeout configured in the COMMTIMEOUTS expired, so there is nothing to
+    // wait for here.
+    return S_OK;
+
+#else /* defined(_WIN32) */
+    // Block until the input queue becomes non-empty, which allows us to
+    // return the response as soon as its last byte arrived. We use ppoll,
+    // because the millisecond resolution of poll would cause us to oversleep.
+    const auto dt = duration_cast<nanoseconds>(deadline - now);
+    const struct timespec timeout {
+        static_cast<time_t>(dt.count() / 1000000000),
+        static_cast<long>(dt.count() % 1000000000)
+    };
+    struct pollfd pfd { this->_handle, POLLIN, 0 };
+
+    auto status = ::ppoll(&pfd, 1, &timeout, nullptr);
+    if (status < 0) {
+        if (errno == EINTR) {
+            return S_OK;
+        }
+
+        auto retval = static_cast<HRESULT>(-errno);
+        _benchlab_debug("Waiting for input from COM port failed.\r\n");
+        return retval;
+    }
+
+    if (status == 0) {
+        return timeout_error();
+    }
+
+    // If the device has been unplugged, we get a hang-up without any data.
+    // Reading in this state would return immediately, so we must not retry.
+    if ((pfd.revents & POLLNVAL) != 0) {
+        return static_cast<HRESULT>(-EBADF);
+    }
+    if (((pfd.revents & POLLIN) == 0)
+            && ((pfd.revents & (POLLERR | POLLHUP)) != 0)) {
+        _benchlab_debug("The COM port was hung up.\r\n");
+        return static_cast<HRESULT>(-EIO);
+    }
+
+    return S_OK;
+#endif /* defined(_WIN32) */
+}
+
+
+/*
+ * serial_transport::write
+ */
+HRESULT serial_transport::write(_In_reads_bytes_(cnt) const void *data,
+        _In_ const std::size_t cnt) noexcept {
+    assert(data != nullptr);
+
+    if (!this->is_open()) {
+        return closed_error();
+    }
+
+#if defined(_WIN32)
+    auto cur = static_cast<const std::uint8_t *>(data);
+    auto rem = static_cast<DWORD>(cnt);
+    DWORD written = 0;
+
+    while (::WriteFile(this->_handle, cur, rem, &written, nullptr)) {
+        if (written == 0) {
+            return S_OK;
+        }
+
+        assert(written <= rem);
+        cur += written;
+        rem -= written;
+    }
+
+    auto retval = HRESULT_FROM_WIN32(::GetLastError());
+    _benchlab_debug("I/O error while writing to COM port.\r\n");
+    return retval;
+
+#else /* defined(_WIN32) */
+    auto cur = static_cast<const std::uint8_t *>(data);
+    auto rem = cnt;
+
+    const auto infinite = (this->_write_timeout
+        == std::chrono::milliseconds::zero());
+    const auto deadline = clock_type::now()
+        + this->_write_timeout;
+
+    while (rem > 0) {
+        auto written = ::write(this->_handle, cur, rem);
+
+        if (written < 0) {
+            if ((errno != EAGAIN) && (errno != EWOULDBLOCK)
+                    && (errno != EINTR)) {
+                auto hr = static_cast<HRESULT>(-errno);
+                _benchlab_debug("I/O error while writing to COM port.\r\n");
+                return hr;
+            }
+
+            // The output queue is full, so wait until there is space again or
+            // the write timeout expires.
+            int timeout = -1;
+            if (!infinite) {
+                auto dt = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    deadline - clock_type::now());
+                if (dt.count() <= 0) {
+                    _benchlab_debug("Timeout while writing to COM port.\r\n");
+                    return timeout_error();
+                }
+                timeout = static_cast<int>(dt.count());
+            }
+
+            struct pollfd pfd { this->_handle, POLLOUT, 0 };
+            if ((::poll(&pfd, 1, timeout) < 0) && (errno != EINTR)) {
+                auto hr = static_cast<HRESULT>(-errno);
+                _benchlab_debug("Waiting for the COM port failed.\r\n");
+                return hr;
+            }
+
+            continue;
+        }
+
+        assert(static_cast<std::size_t>(written) <= rem);
+        cur += written;
+        rem -= written;
+    }
+
+    return S_OK;
+#endif /* defined(_WIN32) */
+}
+
+
+#if !defined(_WIN32)
+/*
+ * serial_transport::configure
+ */
+HRESULT serial_transport::configure(
+        _In_ const benchlab_serial_configuration *config) noexcept {
+    assert(config != nullptr);
+
+    {
+        struct termios tio;
+
+        if (::tcgetattr(this->_handle, &tio) != 0) {
+            auto retval = static_cast<HRESULT>(-errno);
+            _benchlab_debug("Retrieving state of serial port failed.\r\n");
+            return retval;
+        }
+
+        // Put the terminal in raw mode, which disables any kind of character
+        // processing, echoing and line buffering.
+        ::cfmakeraw(&tio);
+        tio.c_cflag |= CLOCAL | CREAD;
+
+        {
+            speed_t speed;
+            auto hr = to_speed(speed, config->baud_rate);
+            if (FAILED(hr)) {
+                _benchlab_debug("The requested baud rate is not supported."
+                    "\r\n");
+                return hr;
+            }
+
+            ::cfsetispeed(&tio, speed);
+            ::cfsetospeed(&tio, speed);
+        }
+
+        tio.c_cflag &= ~CSIZE;
+        switch (config->data_bits) {
+            case 5: tio.c_cflag |= CS5; break;
+            case 6: tio.c_cflag |= CS6; break;
+            case 7: tio.c_cflag |= CS7; break;
+            case 8: tio.c_cflag |= CS8; break;
+            default:
+                _benchlab_debug("The requested number of data bits is not "
+                    "supported.\r\n");
+                return E_INVALIDARG;
+        }
+
+        tio.c_cflag &= ~(PARENB | PARODD | CMSPAR);
+        tio.c_iflag &= ~(INPCK | ISTRIP);
+        switch (config->parity) {
+            case benchlab_parity::none:
+                break;
+
+            case benchlab_parity::odd:
+                tio.c_cflag |= PARENB | PARODD;
+                tio.c_iflag |= INPCK;
+                break;
+
+            case benchlab_parity::even:
+                tio.c_cflag |= PARENB;
+                tio.c_iflag |= INPCK;
+                break;
+
+            case benchlab_parity::mark:
+                tio.c_cflag |= PARENB | PARODD | CMSPAR;
+                tio.c_iflag |= INPCK;
+                break;
+
+            case benchlab_parity::space:
+                tio.c_cflag |= PARENB | CMSPAR;
+                tio.c_iflag |= INPCK;
+                break;
+
+            default:
+                _benchlab_debug("The requested parity is not supported.\r\n");
+                return E_INVALIDARG;
+        }
+
+        // Note: termios cannot express 1.5 stop bits, which is in line with
+        // the behaviour of the .NET implementation on Unix.
+        switch (config->stop_bits) {
+            case benchlab_stop_bits::one:
+                tio.c_cflag &= ~CSTOPB;
+                break;
+
+            case benchlab_stop_bits::two:
+                tio.c_cflag |= CSTOPB;
+                break;
+
+            default:
+                _benchlab_debug("The requested number of stop bits is not "
+                    "supported.\r\n");
+                return E_INVALIDARG;
+        }
+
+        // Map the handshake like the .NET implementation does on Windows.
+        const auto rts = (config->handshake
+            == benchlab_handshake::request_to_send);
+        const auto rts_xon_xoff = (config->handshake
+            == benchlab_handshake::request_to_send_xon_xoff);
+        const auto xon_xoff = (config->handshake
+            == benchlab_handshake::xon_xoff);
+
+        if (rts || rts_xon_xoff) {
+            tio.c_cflag |= CRTSCTS;
+        } else {
+            tio.c_cflag &= ~CRTSCTS;
+        }
+
+        if (xon_xoff || rts_xon_xoff) {
+            tio.c_iflag |= IXON | IXOFF;
+        } else {
+            tio.c_iflag &= ~(IXON | IXOFF | IXANY);
+        }
+
+        // Make read return immediately with whatever is in the input queue.
+        // We implement the timeouts ourselves in the read method, because
+        // VTIME only has a resolution of 100 ms and measures the time
+        // between bytes rather than the total time of the operation.
+        tio.c_cc[VMIN] = 0;
+        tio.c_cc[VTIME] = 0;
+
+        if (::tcsetattr(this->_handle, TCSANOW, &tio) != 0) {
+            auto retval = static_cast<HRESULT>(-errno);
+            _benchlab_debug("Updating state of serial port failed.\r\n");
+            return retval;
+        }
+
+        // Set the modem control lines. Failing to do so is not fatal, because
+        // pseudo terminals and some USB adapters do not support them.
+        {
+            int line = TIOCM_DTR;
+            auto request = config->dtr_enable ? TIOCMBIS : TIOCMBIC;
+            if (::ioctl(this->_handle, request, &line) != 0) {
+                _benchlab_debug("Setting DTR failed.\r\n");
+            }
+        }
+
+        if (!rts && !rts_xon_xoff) {
+            int line = TIOCM_RTS;
+            auto request = config->rts_enable ? TIOCMBIS : TIOCMBIC;
+            if (::ioctl(this->_handle, request, &line) != 0) {
+                _benchlab_debug("Setting RTS failed.\r\n");
+            }
+        }
+    }
+
+    // Ask the driver to push received data to us immediately rather than
+    // batching them. This is only supported by real UART drivers (e.g. FTDI),
+    // so we silently ignore if it fails on CDC ACM devices or ptys.
+    {
+        struct serial_struct serial;
+        if (::ioctl(this->_handle, TIOCGSERIAL, &serial) == 0) {
+            serial.flags |= ASYNC_LOW_LATENCY;
+            ::ioctl(this->_handle, TIOCSSERIAL, &serial);
+        }
+    }
+
+    // Discard anything that might have been left over from a previous session
+    // such that the first response we read is the answer to our command.
+    ::tcflush(this->_handle, TCIOFLUSH);
+
+    return S_OK;
+}
+#endif /* !defined(_WIN32) */
@@ -0,0 +1,128 @@
+﻿// <copyright file="serial_transport.h" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2024 - 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#if !defined(_BENCHLAB_SERIAL_TRANSPORT_H)
+#define _BENCHLAB_SERIAL_TRANSPORT_H
+#pragma once
+
+#if defined(_WIN32)
+#include <Windows.h>
+#else /* defined(_WIN32) */
+#include <termios.h>
+#endif /* defined(_WIN32) */
+
+#include "benchlab_transport.h"
+
+
+/// <summary>
+/// Implements the <see cref="benchlab_transport" /> for a physical serial
+/// port, which is how a real Benchlab device is connected.
+/// </summary>
+class LIBBENCHLAB_TEST_API serial_transport : public benchlab_transport {
+
+public:
+
+#if defined(_WIN32)
+    typedef HANDLE handle_type;
+#else /* defined(_WIN32) */
+    typedef int handle_type;
+#endif /* defined(_WIN32) */
+
+#if defined(_WIN32)
+    static constexpr handle_type invalid_handle = INVALID_HANDLE_VALUE;
+#else /* defined(_WIN32) */
+    static constexpr handle_type invalid_handle = -1;
+#endif /* defined(_WIN32) */
+
+    /// <summary>
+    /// Initialises a new instance.
+    /// </summary>
+    serial_transport(void) noexcept;
+
+    serial_transport(const serial_transport&) = delete;
+
+    /// <summary>
+    /// Finalises the instance.
+    /// </summary>
+    virtual ~serial_transport(void) noexcept;
+
+    /// <inheritdoc />
+    HRESULT available(_Out_ std::size_t& cnt) noexcept override;
+
+    /// <inheritdoc />
+    HRESULT close(void) noexcept override;
+
+#if !defined(_WIN32)
+    /// <inheritdoc />
+    int descriptor(void) const noexcept override;
+#endif /* !defined(_WIN32) */
+
+    /// <inheritdoc />
+    inline bool is_event_driven(void) const noexcept override {
+        return this->_event_driven;
+    }
+
+    /// <inheritdoc />
+    inline bool is_open(void) const noexcept override {
+        return (this->_handle != invalid_handle);
+    }
+
+    /// <summary>
+    /// Opens the serial port at <paramref name="path" />.
+    /// </summary>
+    /// <param name="path">The path to the serial port, e.g. &quot;COM3&quot;
+    /// on Windows or &quot;/dev/ttyACM0&quot; on Linux.</param>
+    /// <param name="config">The configuration of the serial port.</param>
+    /// <returns><c>S_OK</c> in case of success, an error code otherwise.
+    /// </returns>
+    HRESULT open(_In_z_ const benchlab_char *path,
+        _In_ const benchlab_serial_configuration *config) noexcept;
+
+    /// <inheritdoc />
+    HRESULT read(_Out_writes_bytes_(cnt) void *dst,
+        _Inout_ std::size_t& cnt) noexcept override;
+
+    /// <inheritdoc />
+    HRESULT wait(_In_ const clock_type::time_point deadline) noexcept override;
+
+    /// <inheritdoc />
+    HRESULT write(_In_reads_bytes_(cnt) const void *data,
+        _In_ const std::size_t cnt) noexcept override;
+
+    serial_transport& operator =(const serial_transport&) = delete;
+
+protected:
+
+#if !defined(_WIN32)
+    /// <summary>
+    /// Applies the given <paramref name="config" /> to the terminal that has
+    /// just been opened.
+    /// </summary>
+    /// <remarks>
+    /// The caller is responsible for closing the handle if the method fails.
+    /// </remarks>
+    /// <param name="config">The configuration of the serial port.</param>
+    /// <returns><c>S_OK</c> in case of success, an error code otherwise.
+    /// </returns>
+    virtual HRESULT configure(
+        _In_ const benchlab_serial_configuration *config) noexcept;
+#endif /* !defined(_WIN32) */
+
+    /// <summary>
+    /// Answer the native handle of the port.
+    /// </summary>
+    inline handle_type handle(void) const noexcept {
+        return this->_handle;
+    }
+
+private:
+
+    bool _event_driven;
+    handle_type _handle;
+    std::chrono::milliseconds _write_timeout;
+};
+
+#endif /* !defined(_BENCHLAB_SERIAL_TRANSPORT_H) */
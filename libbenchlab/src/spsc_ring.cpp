@@ -0,0 +1,76 @@
+﻿// <copyright file="spsc_ring.cpp" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#include "spsc_ring.h"
+
+#include <algorithm>
+#include <climits>
+
+#if defined(_WIN32)
+#include <Windows.h>
+#else /* defined(_WIN32) */
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#endif /* defined(_WIN32) */
+
+
+/*
+ * ring_signal::notify
+ */
+void ring_signal::notify(void) noexcept {
+    // Both operations are sequentially consistent, which guarantees that
+    // either we see the waiter or the waiter sees the new sequence number.
+    this->_sequence.fetch_add(1, std::memory_order_seq_cst);
+
+    if (this->_waiters.load(std::memory_order_seq_cst) > 0) {
+#if defined(_WIN32)
+        ::WakeByAddressAll(&this->_sequence);
+#else /* defined(_WIN32) */
+        ::syscall(SYS_futex, &this->_sequence, FUTEX_WAKE_PRIVATE, INT_MAX,
+            nullptr, nullptr, 0);
+#endif /* defined(_WIN32) */
+    }
+}
+
+
+/*
+ * ring_signal::wait
+ */
+bool ring_signal::wait(_In_ const std::uint32_t sequence,
+        _In_ const clock_type::time_point deadline) noexcept {
+    using namespace std::chrono;
+    const auto now = clock_type::now();
+
+    if (now >= deadline) {
+        return false;
+    }
+
+    this->_waiters.fetch_add(1, std::memory_order_seq_cst);
+
+    if (this->_sequence.load(std::memory_order_seq_cst) == sequence) {
+        const auto dt = deadline - now;
+#if defined(_WIN32)
+        auto expected = sequence;
+        const auto ms = (std::min)(ceil<milliseconds>(dt).count(),
+            static_cast<milliseconds::rep>(INFINITE - 1));
+        ::WaitOnAddress(&this->_sequence, &expected, sizeof(expected),
+            static_cast<DWORD>(ms));
+#else /* defined(_WIN32) */
+        const auto ns = duration_cast<nanoseconds>(dt).count();
+        const struct timespec timeout {
+            static_cast<time_t>(ns / 1000000000),
+            static_cast<long>(ns % 1000000000)
+        };
+        ::syscall(SYS_futex, &this->_sequence, FUTEX_WAIT_PRIVATE, sequence,
+            &timeout, nullptr, 0);
+#endif /* defined(_WIN32) */
+    }
+
+    this->_waiters.fetch_sub(1, std::memory_order_seq_cst);
+    return true;
+}
@@ -0,0 +1,222 @@
+﻿// <copyright file="spsc_ring.h" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#if !defined(_BENCHLAB_SPSC_RING_H)
+#define _BENCHLAB_SPSC_RING_H
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+#include "libbenchlab/api.h"
+
+
+/// <summary>
+/// The size of a cache line, which is used to keep the indices of the
+/// producer and the consumer apart.
+/// </summary>
+constexpr std::size_t cache_line_size = 64;
+
+
+/// <summary>
+/// Allows a consumer to block until a producer signals that something has
+/// changed without the producer ever taking a lock.
+/// </summary>
+/// <remarks>
+/// <para>The consumer obtains the <see cref="sequence" /> before checking its
+/// condition and passes it to <see cref="wait" /> if the condition is not
+/// met. If the producer signalled in between, the wait returns immediately.
+/// </para>
+/// <para>The signal is implemented using futexes on Linux and
+/// <c>WaitOnAddress</c> on Windows. The producer only makes a system call if
+/// a consumer is actually waiting.</para>
+/// </remarks>
+class LIBBENCHLAB_TEST_API ring_signal final {
+
+public:
+
+    typedef std::chrono::steady_clock clock_type;
+
+    /// <summary>
+    /// Initialises a new instance.
+    /// </summary>
+    inline ring_signal(void) noexcept : _sequence(0), _waiters(0) { }
+
+    ring_signal(const ring_signal&) = delete;
+
+    /// <summary>
+    /// Wakes all threads blocked in <see cref="wait" />.
+    /// </summary>
+    void notify(void) noexcept;
+
+    /// <summary>
+    /// Answer the current sequence number, which is to be passed to
+    /// <see cref="wait" />.
+    /// </summary>
+    inline std::uint32_t sequence(void) const noexcept {
+        return this->_sequence.load(std::memory_order_seq_cst);
+    }
+
+    /// <summary>
+    /// Blocks until <see cref="notify" /> has been called after
+    /// <paramref name="sequence" /> was obtained, or until
+    /// <paramref name="deadline" /> has passed.
+    /// </summary>
+    /// <remarks>
+    /// The method might return spuriously, so callers need to check their
+    /// condition again.
+    /// </remarks>
+    /// <returns><c>false</c> if the deadline has passed, <c>true</c>
+    /// otherwise.</returns>
+    bool wait(_In_ const std::uint32_t sequence,
+        _In_ const clock_type::time_point deadline) noexcept;
+
+    ring_signal& operator =(const ring_signal&) = delete;
+
+private:
+
+    std::atomic<std::uint32_t> _sequence;
+    std::atomic<std::uint32_t> _waiters;
+};
+
+
+/// <summary>
+/// A fixed-capacity ring buffer for exactly one producer thread and one
+/// consumer thread, which neither locks nor allocates memory when elements
+/// are added or removed.
+/// </summary>
+/// <remarks>
+/// If the ring is full, new elements are rejected, because the producer must
+/// not modify the index owned by the consumer. Each side caches the index of
+/// the other side such that it only needs to touch the cache line of the
+/// other side if the cached value indicates that the ring is full or empty,
+/// respectively.
+/// </remarks>
+/// <typeparam name="TElement">The type of the elements, which must be
+/// trivially copyable.</typeparam>
+template<class TElement> class spsc_ring final {
+
+public:
+
+    typedef TElement element_type;
+    typedef ring_signal::clock_type clock_type;
+
+    /// <summary>
+    /// Creates a ring with at least the given capacity, which is rounded up
+    /// to the next power of two.
+    /// </summary>
+    /// <returns>The new ring, or <c>nullptr</c> if the memory could not be
+    /// allocated.</returns>
+    static std::unique_ptr<spsc_ring> create(
+        _In_ const std::size_t capacity) noexcept;
+
+    spsc_ring(const spsc_ring&) = delete;
+
+    /// <summary>
+    /// Answer the number of elements the ring can hold.
+    /// </summary>
+    inline std::size_t capacity(void) const noexcept {
+        return this->_mask + 1;
+    }
+
+    /// <summary>
+    /// Removes all elements from the ring and reopens it if it was closed.
+    /// </summary>
+    /// <remarks>
+    /// This method must only be called if there is neither a producer nor a
+    /// consumer.
+    /// </remarks>
+    void clear(void) noexcept;
+
+    /// <summary>
+    /// Indicates that the producer will not add any more elements and wakes
+    /// the consumer.
+    /// </summary>
+    inline void close(void) noexcept {
+        this->_closed.store(true, std::memory_order_seq_cst);
+        this->_signal.notify();
+    }
+
+    /// <summary>
+    /// Answer whether the producer has <see cref="close" />d the ring.
+    /// </summary>
+    /// <remarks>
+    /// Elements that have been added before the ring was closed can still be
+    /// removed.
+    /// </remarks>
+    inline bool closed(void) const noexcept {
+        return this->_closed.load(std::memory_order_seq_cst);
+    }
+
+    /// <summary>
+    /// Removes up to <paramref name="cnt" /> elements from the ring.
+    /// </summary>
+    /// <remarks>
+    /// This method must only be called by the consumer.
+    /// </remarks>
+    /// <returns>The number of elements written to
+    /// <paramref name="dst" />.</returns>
+    std::size_t pop(_Out_writes_to_(cnt, return) element_type *dst,
+        _In_ const std::size_t cnt) noexcept;
+
+    /// <summary>
+    /// Adds <paramref name="element" /> to the ring and wakes the consumer.
+    /// </summary>
+    /// <remarks>
+    /// This method must only be called by the producer.
+    /// </remarks>
+    /// <returns><c>true</c> if the element was added, <c>false</c> if the
+    /// ring is full.</returns>
+    bool push(_In_ const element_type& element) noexcept;
+
+    /// <summary>
+    /// Answer the sequence number of the signal that the consumer must
+    /// obtain before checking the ring in order to <see cref="wait" />.
+    /// </summary>
+    inline std::uint32_t sequence(void) const noexcept {
+        return this->_signal.sequence();
+    }
+
+    /// <summary>
+    /// Blocks the consumer until the producer added an element or called
+    /// <see cref="close" /> after <paramref name="sequence" /> was obtained,
+    /// or until <paramref name="deadline" /> has passed.
+    /// </summary>
+    inline bool wait(_In_ const std::uint32_t sequence,
+            _In_ const clock_type::time_point deadline) noexcept {
+        return this->_signal.wait(sequence, deadline);
+    }
+
+    spsc_ring& operator =(const spsc_ring&) = delete;
+
+private:
+
+    spsc_ring(_Inout_ std::unique_ptr<element_type[]>&& elements,
+        _In_ const std::size_t capacity) noexcept;
+
+    std::unique_ptr<element_type[]> _elements;
+    std::size_t _mask;
+
+    // Owned by the producer.
+    alignas(cache_line_size) std::atomic<std::size_t> _tail;
+    std::size_t _cached_head;
+
+    // Owned by the consumer.
+    alignas(cache_line_size) std::atomic<std::size_t> _head;
+    std::size_t _cached_tail;
+
+    alignas(cache_line_size) std::atomic<bool> _closed;
+    ring_signal _signal;
+};
+
+#include "spsc_ring.inl"
+
+#endif /* !defined(_BENCHLAB_SPSC_RING_H) */
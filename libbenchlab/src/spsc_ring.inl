@@ -0,0 +1,104 @@
+﻿// <copyright file="spsc_ring.inl" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+
+/*
+ * spsc_ring<TElement>::create
+ */
+template<class TElement>
+std::unique_ptr<spsc_ring<TElement>> spsc_ring<TElement>::create(
+        _In_ const std::size_t capacity) noexcept {
+    static_assert(std::is_trivially_copyable<TElement>::value,
+        "The elements of the ring must be trivially copyable.");
+    std::size_t size = 1;
+    while (size < capacity) {
+        size <<= 1;
+    }
+
+    std::unique_ptr<element_type[]> elements(
+        new (std::nothrow) element_type[size]);
+    if (elements == nullptr) {
+        return nullptr;
+    }
+
+    return std::unique_ptr<spsc_ring>(new (std::nothrow) spsc_ring(
+        std::move(elements), size));
+}
+
+
+/*
+ * spsc_ring<TElement>::clear
+ */
+template<class TElement>
+void spsc_ring<TElement>::clear(void) noexcept {
+    this->_head.store(0, std::memory_order_relaxed);
+    this->_tail.store(0, std::memory_order_relaxed);
+    this->_cached_head = 0;
+    this->_cached_tail = 0;
+    this->_closed.store(false, std::memory_order_relaxed);
+}
+
+
+/*
+ * spsc_ring<TElement>::pop
+ */
+template<class TElement>
+std::size_t spsc_ring<TElement>::pop(
+        _Out_writes_to_(cnt, return) element_type *dst,
+        _In_ const std::size_t cnt) noexcept {
+    const auto head = this->_head.load(std::memory_order_relaxed);
+
+    if (this->_cached_tail - head < cnt) {
+        this->_cached_tail = this->_tail.load(std::memory_order_acquire);
+    }
+
+    const auto available = this->_cached_tail - head;
+    const auto retval = (available < cnt) ? available : cnt;
+
+    for (std::size_t i = 0; i < retval; ++i) {
+        dst[i] = this->_elements[(head + i) & this->_mask];
+    }
+
+    this->_head.store(head + retval, std::memory_order_release);
+    return retval;
+}
+
+
+/*
+ * spsc_ring<TElement>::push
+ */
+template<class TElement>
+bool spsc_ring<TElement>::push(_In_ const element_type& element) noexcept {
+    const auto tail = this->_tail.load(std::memory_order_relaxed);
+
+    if (tail - this->_cached_head > this->_mask) {
+        this->_cached_head = this->_head.load(std::memory_order_acquire);
+        if (tail - this->_cached_head > this->_mask) {
+            return false;
+        }
+    }
+
+    this->_elements[tail & this->_mask] = element;
+    this->_tail.store(tail + 1, std::memory_order_release);
+    this->_signal.notify();
+    return true;
+}
+
+
+/*
+ * spsc_ring<TElement>::spsc_ring
+ */
+template<class TElement>
+spsc_ring<TElement>::spsc_ring(
+        _Inout_ std::unique_ptr<element_type[]>&& elements,
+        _In_ const std::size_t capacity) noexcept
+    : _elements(std::move(elements)),
+        _mask(capacity - 1),
+        _tail(0),
+        _cached_head(0),
+        _head(0),
+        _cached_tail(0),
+        _closed(false) { }
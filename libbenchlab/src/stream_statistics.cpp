@@ -0,0 +1,51 @@
+﻿// <copyright file="stream_statistics.cpp" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#include "stream_statistics.h"
+
+
+/*
+ * stream_statistics::get
+ */
+void stream_statistics::get(
+        _Out_ benchlab_streaming_statistics& dst) const noexcept {
+    using namespace std::chrono;
+
+    dst.samples = this->_samples.load(std::memory_order_acquire);
+
+    const clock_type::duration dt(this->_last.load(std::memory_order_relaxed)
+        - this->_first.load(std::memory_order_relaxed));
+    dst.elapsed = (dst.samples > 1)
+        ? static_cast<std::uint64_t>(duration_cast<microseconds>(dt).count())
+        : 0;
+
+    // The rate is determined from the intervals between the samples, which
+    // is why the first sample does not count.
+    dst.sample_rate = (dst.elapsed > 0)
+        ? static_cast<float>((dst.samples - 1) / duration<double>(dt).count())
+        : 0.0f;
+
+    dst.failures = this->_failures.load(std::memory_order_relaxed);
+    dst.discarded = this->_discarded.load(std::memory_order_relaxed);
+    dst.recovery_time = this->_recovery_time.load(std::memory_order_relaxed);
+    dst.overflows = this->_overflows.load(std::memory_order_relaxed);
+    dst.overruns = this->_overruns.load(std::memory_order_relaxed);
+}
+
+
+/*
+ * stream_statistics::reset
+ */
+void stream_statistics::reset(void) noexcept {
+    this->_discarded.store(0, std::memory_order_relaxed);
+    this->_failures.store(0, std::memory_order_relaxed);
+    this->_first.store(0, std::memory_order_relaxed);
+    this->_last.store(0, std::memory_order_relaxed);
+    this->_overflows.store(0, std::memory_order_relaxed);
+    this->_overruns.store(0, std::memory_order_relaxed);
+    this->_recovery_time.store(0, std::memory_order_relaxed);
+    this->_samples.store(0, std::memory_order_release);
+}
@@ -0,0 +1,116 @@
+﻿// <copyright file="stream_statistics.h" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#if !defined(_BENCHLAB_STREAM_STATISTICS_H)
+#define _BENCHLAB_STREAM_STATISTICS_H
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <cstddef>
+
+#include "libbenchlab/streaming.h"
+
+
+/// <summary>
+/// Collects the statistics of the streaming thread in <see cref="device" />.
+/// </summary>
+/// <remarks>
+/// The statistics are written by the streaming thread only, but can be read
+/// by any thread at any time. Readers are not guaranteed to see a consistent
+/// snapshot of all counters, but each counter is valid on its own.
+/// </remarks>
+class stream_statistics final {
+
+public:
+
+    typedef std::chrono::steady_clock clock_type;
+
+    /// <summary>
+    /// Initialises a new instance.
+    /// </summary>
+    inline stream_statistics(void) noexcept {
+        this->reset();
+    }
+
+    /// <summary>
+    /// Records that <paramref name="cnt" /> bytes of input have been
+    /// discarded.
+    /// </summary>
+    inline void discarded(_In_ const std::size_t cnt) noexcept {
+        this->_discarded.fetch_add(cnt, std::memory_order_relaxed);
+    }
+
+    /// <summary>
+    /// Records that a sample has been lost.
+    /// </summary>
+    inline void failed(void) noexcept {
+        this->_failures.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /// <summary>
+    /// Copies the current statistics into <paramref name="dst" />.
+    /// </summary>
+    void get(_Out_ benchlab_streaming_statistics& dst) const noexcept;
+
+    /// <summary>
+    /// Records that a sample could not be buffered.
+    /// </summary>
+    inline void overflowed(void) noexcept {
+        this->_overflows.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /// <summary>
+    /// Records that <paramref name="cnt" /> deadlines have been overrun.
+    /// </summary>
+    inline void overran(_In_ const std::uint64_t cnt) noexcept {
+        if (cnt > 0) {
+            this->_overruns.fetch_add(cnt, std::memory_order_relaxed);
+        }
+    }
+
+    /// <summary>
+    /// Records that streaming recovered after a series of failures that
+    /// took <paramref name="duration" />.
+    /// </summary>
+    inline void recovered(_In_ const clock_type::duration duration) noexcept {
+        const auto us = std::chrono::duration_cast<std::chrono::microseconds>(
+            duration).count();
+        this->_recovery_time.fetch_add(us, std::memory_order_relaxed);
+    }
+
+    /// <summary>
+    /// Records that a sample has been delivered at <paramref name="now" />.
+    /// </summary>
+    inline void record(_In_ const clock_type::time_point now
+            = clock_type::now()) noexcept {
+        const auto t = now.time_since_epoch().count();
+        if (this->_samples.load(std::memory_order_relaxed) == 0) {
+            this->_first.store(t, std::memory_order_relaxed);
+        }
+        this->_last.store(t, std::memory_order_relaxed);
+        this->_samples.fetch_add(1, std::memory_order_release);
+    }
+
+    /// <summary>
+    /// Resets all counters to zero.
+    /// </summary>
+    void reset(void) noexcept;
+
+private:
+
+    std::atomic<std::uint64_t> _discarded;
+    std::atomic<std::uint64_t> _failures;
+    std::atomic<clock_type::rep> _first;
+    std::atomic<clock_type::rep> _last;
+    std::atomic<std::uint64_t> _overflows;
+    std::atomic<std::uint64_t> _overruns;
+    std::atomic<std::uint64_t> _recovery_time;
+    std::atomic<std::uint64_t> _samples;
+};
+
+#endif /* !defined(_BENCHLAB_STREAM_STATISTICS_H) */
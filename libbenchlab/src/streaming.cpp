@@ -0,0 +1,42 @@
+﻿// <copyright file="streaming.cpp" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#include "libbenchlab/streaming.h"
+
+
+/*
+ * ::benchlab_initialise_streaming_configuration
+ */
+HRESULT LIBBENCHLAB_API benchlab_initialise_streaming_configuration(
+        _In_ benchlab_streaming_configuration *config) {
+    if (config == nullptr) {
+        return E_POINTER;
+    }
+
+    switch (config->version) {
+        case 1:
+            config->acquisition_mode = benchlab_acquisition_mode::stop_and_wait;
+            config->batch_callback = nullptr;
+            config->batch_latency = 100;
+            config->batch_size = 32;
+            config->buffer_size = 0;
+            ::benchlab_select_all_channels(&config->channels);
+            config->callback = nullptr;
+            config->clock = benchlab_clock::system;
+            config->compact_callback = nullptr;
+            config->context = nullptr;
+            config->max_failures = 10;
+            config->overrun_policy = benchlab_overrun_policy::skip;
+            config->period = 10;
+            config->reactor = nullptr;
+            config->readings_callback = nullptr;
+            config->timestamp_point = benchlab_timestamp_point::completion;
+            return S_OK;
+
+        default:
+            return E_INVALIDARG;
+    }
+}
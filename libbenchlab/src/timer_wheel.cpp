@@ -0,0 +1,96 @@
+﻿// <copyright file="timer_wheel.cpp" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#include "timer_wheel.h"
+
+#include <algorithm>
+
+
+/*
+ * timer_wheel::timer_wheel
+ */
+timer_wheel::timer_wheel(_In_ const clock_type::time_point now) noexcept
+    : _current(0), _origin(now), _size(0) { }
+
+
+/*
+ * timer_wheel::~timer_wheel
+ */
+timer_wheel::~timer_wheel(void) noexcept {
+    for (auto& head : this->_slots) {
+        while (head.is_scheduled()) {
+            unlink(*head.next);
+        }
+    }
+}
+
+
+/*
+ * timer_wheel::cancel
+ */
+void timer_wheel::cancel(_Inout_ timer_wheel_entry& entry) noexcept {
+    if (entry.is_scheduled()) {
+        unlink(entry);
+        --this->_size;
+    }
+}
+
+
+/*
+ * timer_wheel::next_expiry
+ */
+timer_wheel::clock_type::time_point timer_wheel::next_expiry(
+        void) const noexcept {
+    auto retval = (clock_type::time_point::max)();
+
+    if (this->_size == 0) {
+        return retval;
+    }
+
+    // Walk the wheel starting at the current tick. The first slot holding a
+    // timer of the tick we are looking at contains the earliest timer, but
+    // other timers of that slot might be a revolution ahead.
+    for (std::size_t i = 0; i < slots; ++i) {
+        const auto t = this->_current + i;
+        auto& head = this->_slots[t % slots];
+
+        for (auto e = head.next; e != &head; e = e->next) {
+            if (this->tick(e->due) <= t) {
+                retval = (std::min)(retval, e->due);
+            }
+        }
+
+        if (retval != (clock_type::time_point::max)()) {
+            return retval;
+        }
+    }
+
+    // All timers are more than a revolution ahead, so we need to find the
+    // earliest one the hard way.
+    for (auto& head : this->_slots) {
+        for (auto e = head.next; e != &head; e = e->next) {
+            retval = (std::min)(retval, e->due);
+        }
+    }
+
+    return retval;
+}
+
+
+/*
+ * timer_wheel::schedule
+ */
+void timer_wheel::schedule(_Inout_ timer_wheel_entry& entry,
+        _In_ const clock_type::time_point due) noexcept {
+    this->cancel(entry);
+
+    // Timers that are already overdue are put into the current slot such that
+    // they expire with the next call to expire().
+    entry.due = due;
+    const auto t = (std::max)(this->tick(due), this->_current);
+    link(this->_slots[t % slots], entry);
+    ++this->_size;
+}
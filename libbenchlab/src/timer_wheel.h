@@ -0,0 +1,193 @@
+﻿// <copyright file="timer_wheel.h" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#if !defined(_BENCHLAB_TIMER_WHEEL_H)
+#define _BENCHLAB_TIMER_WHEEL_H
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cinttypes>
+#include <cstddef>
+
+#include "libbenchlab/api.h"
+
+
+/// <summary>
+/// An entry in a <see cref="timer_wheel" />, which is intended to be used as
+/// base class of the objects that need to be woken up.
+/// </summary>
+/// <remarks>
+/// The entries are linked into the slots of the wheel, i.e. scheduling and
+/// cancelling timers never allocates any memory. An entry can be scheduled in
+/// at most one wheel at a time.
+/// </remarks>
+struct timer_wheel_entry {
+
+    typedef std::chrono::steady_clock clock_type;
+
+    /// <summary>
+    /// Initialises a new instance.
+    /// </summary>
+    inline timer_wheel_entry(void) noexcept
+        : next(this), prev(this) { }
+
+    timer_wheel_entry(const timer_wheel_entry&) = delete;
+
+    /// <summary>
+    /// Answer whether the entry is currently scheduled.
+    /// </summary>
+    inline bool is_scheduled(void) const noexcept {
+        return (this->next != this);
+    }
+
+    timer_wheel_entry& operator =(const timer_wheel_entry&) = delete;
+
+    /// <summary>
+    /// The point in time when the timer expires.
+    /// </summary>
+    clock_type::time_point due;
+
+    /// <summary>
+    /// The next entry in the slot, or the entry itself if unlinked.
+    /// </summary>
+    timer_wheel_entry *next;
+
+    /// <summary>
+    /// The previous entry in the slot, or the entry itself if unlinked.
+    /// </summary>
+    timer_wheel_entry *prev;
+};
+
+
+/// <summary>
+/// A hashed timing wheel, which schedules and cancels timers in constant time
+/// irrespective of the number of timers.
+/// </summary>
+/// <remarks>
+/// Timers are hashed into the slot of the tick they expire in. Timers that
+/// are more than a full revolution of the wheel ahead share the slots with
+/// the near ones and are skipped until their tick has come.
+/// </remarks>
+class LIBBENCHLAB_TEST_API timer_wheel final {
+
+public:
+
+    typedef timer_wheel_entry::clock_type clock_type;
+
+    /// <summary>
+    /// The granularity of the wheel.
+    /// </summary>
+    static constexpr std::chrono::microseconds resolution
+        = std::chrono::microseconds(1000);
+
+    /// <summary>
+    /// The number of slots, which determines how far ahead timers can be
+    /// scheduled before they share slots with nearer ones.
+    /// </summary>
+    static constexpr std::size_t slots = 256;
+
+    /// <summary>
+    /// Initialises a new instance.
+    /// </summary>
+    /// <param name="now">The point in time the wheel starts at.</param>
+    explicit timer_wheel(_In_ const clock_type::time_point now
+        = clock_type::now()) noexcept;
+
+    timer_wheel(const timer_wheel&) = delete;
+
+    /// <summary>
+    /// Finalises the instance.
+    /// </summary>
+    /// <remarks>
+    /// All entries that are still scheduled are unlinked.
+    /// </remarks>
+    ~timer_wheel(void) noexcept;
+
+    /// <summary>
+    /// Removes <paramref name="entry" /> from the wheel if it is scheduled.
+    /// </summary>
+    void cancel(_Inout_ timer_wheel_entry& entry) noexcept;
+
+    /// <summary>
+    /// Answer whether no timer is scheduled.
+    /// </summary>
+    inline bool empty(void) const noexcept {
+        return (this->_size == 0);
+    }
+
+    /// <summary>
+    /// Removes all timers that are due at <paramref name="now" /> from the
+    /// wheel and invokes <paramref name="callback" /> for each of them.
+    /// </summary>
+    /// <remarks>
+    /// The expired timers are unlinked before the first callback is invoked,
+    /// so the callback can reschedule its entry.
+    /// </remarks>
+    template<class TCallback>
+    void expire(_In_ const clock_type::time_point now, _In_ TCallback callback);
+
+    /// <summary>
+    /// Answer when the next timer expires.
+    /// </summary>
+    /// <returns>The due time of the next timer, or
+    /// <c>clock_type::time_point::max()</c> if no timer is scheduled.
+    /// </returns>
+    clock_type::time_point next_expiry(void) const noexcept;
+
+    /// <summary>
+    /// Schedules <paramref name="entry" /> to expire at
+    /// <paramref name="due" />, which cancels any previous timer of the
+    /// entry.
+    /// </summary>
+    void schedule(_Inout_ timer_wheel_entry& entry,
+        _In_ const clock_type::time_point due) noexcept;
+
+    timer_wheel& operator =(const timer_wheel&) = delete;
+
+private:
+
+    /// <summary>
+    /// Links <paramref name="entry" /> at the end of the list headed by
+    /// <paramref name="head" />.
+    /// </summary>
+    static inline void link(_Inout_ timer_wheel_entry& head,
+            _Inout_ timer_wheel_entry& entry) noexcept {
+        entry.prev = head.prev;
+        entry.next = &head;
+        head.prev->next = &entry;
+        head.prev = &entry;
+    }
+
+    /// <summary>
+    /// Unlinks <paramref name="entry" /> from the list it is in.
+    /// </summary>
+    static inline void unlink(_Inout_ timer_wheel_entry& entry) noexcept {
+        entry.prev->next = entry.next;
+        entry.next->prev = entry.prev;
+        entry.next = entry.prev = &entry;
+    }
+
+    /// <summary>
+    /// Converts <paramref name="time" /> into the number of the tick it falls
+    /// into.
+    /// </summary>
+    inline std::uint64_t tick(
+            _In_ const clock_type::time_point time) const noexcept {
+        return (time <= this->_origin)
+            ? 0
+            : static_cast<std::uint64_t>((time - this->_origin) / resolution);
+    }
+
+    std::uint64_t _current;
+    clock_type::time_point _origin;
+    std::size_t _size;
+    std::array<timer_wheel_entry, slots> _slots;
+};
+
+#include "timer_wheel.inl"
+
+#endif /* !defined(_BENCHLAB_TIMER_WHEEL_H) */
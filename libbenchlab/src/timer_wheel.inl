@@ -0,0 +1,46 @@
+﻿// <copyright file="timer_wheel.inl" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+
+/*
+ * timer_wheel::expire
+ */
+template<class TCallback>
+void timer_wheel::expire(_In_ const clock_type::time_point now,
+        _In_ TCallback callback) {
+    const auto last = this->tick(now);
+    timer_wheel_entry expired;
+
+    // If we fell behind by more than a revolution, every slot needs to be
+    // checked once, but not more often than that.
+    const auto first = ((last - this->_current) >= slots)
+        ? last - slots + 1
+        : this->_current;
+
+    for (auto t = first; (t <= last) && (this->_size > 0); ++t) {
+        auto& head = this->_slots[t % slots];
+
+        for (auto e = head.next; e != &head;) {
+            auto n = e->next;
+            if (e->due <= now) {
+                unlink(*e);
+                link(expired, *e);
+            }
+            e = n;
+        }
+    }
+
+    this->_current = last;
+
+    // The expired timers remain counted until they are called, because a
+    // callback might cancel one that has not been called yet.
+    while (expired.is_scheduled()) {
+        auto e = expired.next;
+        unlink(*e);
+        --this->_size;
+        callback(*e);
+    }
+}
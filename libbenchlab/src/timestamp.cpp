@@ -6,48 +6,18 @@
 
 #include "libbenchlab/timestamp.h"
 
-#include <chrono>
+#include "libbenchlab/conversion.h"
 
 #if defined(_WIN32)
 #include <Windows.h>
 #endif /* defined(_WIN32) */
 
 
-/// <summary>
-/// The 100ns period defining the reolution of <see cref="FILETIME" />.
-/// </summary>
-typedef std::ratio<1, 10000000> filetime_period;
-
-
-/// <summary>
-/// The STL representation of <see cref="FILETIME" />.
-/// </summary>
-typedef std::chrono::duration<benchlab_timestamp, filetime_period>
-    filetime_duration;
-
-
 /*
  * ::_benchlab_make_timestamp
  */
 benchlab_timestamp LIBBENCHLAB_TEST_API _benchlab_make_timestamp(void) {
-    using namespace std::chrono;
-
-    // Make the timestamp.
-    const auto timestamp = system_clock::now();
-
-    // The offset of the FILETIME epoch to the UNIX epoch as copied from
-    // StackOverflow.
-    const filetime_duration dz(116444736000000000LL);
-
-    // Find out what the difference between the time point and the UNIX
-    // epoch is. Because we cannot rely on the epoch of the STL clock being the
-    // UNIX epoch (until C++ 20), use time_t, which is guaranteed to represent
-    // the UNIX epoch.
-    auto dt = duration_cast<filetime_duration>(timestamp
-        - system_clock::from_time_t(0));
-
-    // Transform the origin of the timestamp clock to the origin of FILETIME.
-    return (dt + dz).count();
+    return visus::benchlab::make_timestamp();
 }
 
 
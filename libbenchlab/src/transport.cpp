@@ -0,0 +1,228 @@
+﻿// <copyright file="transport.cpp" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#include "libbenchlab/transport.h"
+
+#include <cstring>
+#include <new>
+
+#include "benchlab_transport.h"
+#include "debug.h"
+#include "loopback_transport.h"
+#include "pty_transport.h"
+#include "replay_transport.h"
+#include "serial_transport.h"
+
+
+/// <summary>
+/// Opens the transport of type <typeparamref name="TTransport" /> at
+/// <paramref name="path" /> and stores it in
+/// <paramref name="transport" /> on success.
+/// </summary>
+template<class TTransport>
+static HRESULT open_transport(
+        _Out_ std::unique_ptr<benchlab_transport>& transport,
+        _In_z_ const benchlab_char *path,
+        _In_ const benchlab_serial_configuration *config) noexcept {
+    std::unique_ptr<TTransport> retval(new (std::nothrow) TTransport());
+    if (retval == nullptr) {
+        _benchlab_debug("Insufficient memory for transport.\r\n");
+        return E_OUTOFMEMORY;
+    }
+
+    auto hr = retval->open(path, config);
+    if (SUCCEEDED(hr)) {
+        transport = std::move(retval);
+    }
+
+    return hr;
+}
+
+
+/*
+ * benchlab_transport::create
+ */
+HRESULT benchlab_transport::create(
+        _Out_ std::unique_ptr<benchlab_transport>& transport,
+        _In_z_ const benchlab_char *path,
+        _In_ const benchlab_serial_configuration *config) noexcept {
+#if !defined(_WIN32)
+    static constexpr const char pts[] = "/dev/pts/";
+    if (std::strncmp(path, pts, sizeof(pts) - 1) == 0) {
+        return open_transport<pty_transport>(transport, path, config);
+    }
+#endif /* !defined(_WIN32) */
+
+    return open_transport<serial_transport>(transport, path, config);
+}
+
+
+/*
+ * ::benchlab_create_loopback_transport
+ */
+HRESULT LIBBENCHLAB_API benchlab_create_loopback_transport(
+        _Out_ benchlab_transport_handle *out_transport,
+        _In_opt_ benchlab_loopback_handler handler,
+        _In_opt_ void *context) {
+    if (out_transport == nullptr) {
+        _benchlab_debug("Invalid storage location for transport provided."
+            "\r\n");
+        return E_POINTER;
+    }
+
+    *out_transport = new (std::nothrow) loopback_transport(handler, context);
+    return (*out_transport != nullptr) ? S_OK : E_OUTOFMEMORY;
+}
+
+
+/*
+ * ::benchlab_create_pty_transport
+ */
+HRESULT LIBBENCHLAB_API benchlab_create_pty_transport(
+        _Out_ benchlab_transport_handle *out_transport,
+        _In_z_ const benchlab_char *path) {
+    if (out_transport == nullptr) {
+        _benchlab_debug("Invalid storage location for transport provided."
+            "\r\n");
+        return E_POINTER;
+    }
+
+    *out_transport = nullptr;
+
+    if (path == nullptr) {
+        _benchlab_debug("Invalid pseudo-terminal provided.\r\n");
+        return E_INVALIDARG;
+    }
+
+#if defined(_WIN32)
+    return E_NOTIMPL;
+#else /* defined(_WIN32) */
+    benchlab_serial_configuration config;
+    config.version = 1;
+    ::benchlab_initialise_serial_configuration(&config);
+
+    std::unique_ptr<benchlab_transport> transport;
+    auto hr = open_transport<pty_transport>(transport, path, &config);
+    *out_transport = transport.release();
+    return hr;
+#endif /* defined(_WIN32) */
+}
+
+
+/*
+ * ::benchlab_create_replay_transport
+ */
+HRESULT LIBBENCHLAB_API benchlab_create_replay_transport(
+        _Out_ benchlab_transport_handle *out_transport,
+        _In_z_ const benchlab_char *path,
+        _In_ const benchlab_replay_mode mode) {
+    if (out_transport == nullptr) {
+        _benchlab_debug("Invalid storage location for transport provided."
+            "\r\n");
+        return E_POINTER;
+    }
+
+    *out_transport = nullptr;
+
+    if (path == nullptr) {
+        _benchlab_debug("Invalid recording provided.\r\n");
+        return E_INVALIDARG;
+    }
+
+    std::unique_ptr<replay_transport> transport(
+        new (std::nothrow) replay_transport(mode));
+    if (transport == nullptr) {
+        _benchlab_debug("Insufficient memory for transport.\r\n");
+        return E_OUTOFMEMORY;
+    }
+
+    auto hr = transport->load(path);
+    if (SUCCEEDED(hr)) {
+        *out_transport = transport.release();
+    }
+
+    return hr;
+}
+
+
+/*
+ * ::benchlab_create_serial_transport
+ */
+HRESULT LIBBENCHLAB_API benchlab_create_serial_transport(
+        _Out_ benchlab_transport_handle *out_transport,
+        _In_z_ const benchlab_char *path,
+        _In_opt_ const benchlab_serial_configuration *config) {
+    if (out_transport == nullptr) {
+        _benchlab_debug("Invalid storage location for transport provided."
+            "\r\n");
+        return E_POINTER;
+    }
+
+    *out_transport = nullptr;
+
+    if (path == nullptr) {
+        _benchlab_debug("Invalid COM port provided.\r\n");
+        return E_INVALIDARG;
+    }
+
+    benchlab_serial_configuration dft_conf;
+    if (config == nullptr) {
+        dft_conf.version = 1;
+        auto hr = ::benchlab_initialise_serial_configuration(&dft_conf);
+        if (FAILED(hr)) {
+            _benchlab_debug("Failed to initialise default serial "
+                "configuration.\r\n");
+            return hr;
+        }
+    }
+
+    std::unique_ptr<benchlab_transport> transport;
+    auto hr = open_transport<serial_transport>(transport, path,
+        (config != nullptr) ? config : &dft_conf);
+    *out_transport = transport.release();
+    return hr;
+}
+
+
+/*
+ * ::benchlab_destroy_transport
+ */
+HRESULT LIBBENCHLAB_API benchlab_destroy_transport(
+        _In_ benchlab_transport_handle transport) {
+    if (transport == nullptr) {
+        _benchlab_debug("The transport handle is invalid.\r\n");
+        return E_HANDLE;
+    }
+
+    delete transport;
+    return S_OK;
+}
+
+
+/*
+ * ::benchlab_loopback_respond
+ */
+HRESULT LIBBENCHLAB_API benchlab_loopback_respond(
+        _In_ benchlab_transport_handle transport,
+        _In_reads_bytes_(cnt) const void *data,
+        _In_ const size_t cnt) {
+    if (transport == nullptr) {
+        _benchlab_debug("The transport handle is invalid.\r\n");
+        return E_HANDLE;
+    }
+    if (data == nullptr) {
+        _benchlab_debug("The response is an invalid pointer.\r\n");
+        return E_INVALIDARG;
+    }
+
+    auto loopback = dynamic_cast<loopback_transport *>(transport);
+    if (loopback == nullptr) {
+        _benchlab_debug("The transport is not a loopback transport.\r\n");
+        return E_INVALIDARG;
+    }
+
+    return loopback->push(data, cnt);
+}
@@ -0,0 +1,276 @@
+﻿// <copyright file="reactorbench.cpp" company="Visualisierungsinstitut der Universität Stuttgart">
+// Copyright © 2026 Visualisierungsinstitut der Universität Stuttgart.
+// Licensed under the MIT licence. See LICENCE file for details.
+// </copyright>
+// <author>Christoph Müller</author>
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <spawn.h>
+#include <unistd.h>
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+#include "libbenchlab/benchlab.h"
+
+
+/// <summary>
+/// An emulator process serving as device for the benchmark.
+/// </summary>
+struct emulator_process {
+    std::string port;
+    pid_t pid;
+};
+
+
+/// <summary>
+/// Answer the argument following the switch <paramref name="name" /> or
+/// <paramref name="fallback" /> if the switch was not specified.
+/// </summary>
+static const char *find_argument(_In_ const int argc,
+        _In_reads_(argc) const char **argv,
+        _In_z_ const char *name,
+        _In_opt_z_ const char *fallback) {
+    for (int i = 1; i < argc - 1; ++i) {
+        if (std::strcmp(argv[i], name) == 0) {
+            return argv[i + 1];
+        }
+    }
+
+    return fallback;
+}
+
+
+/// <summary>
+/// Answer the CPU time the process has consumed so far.
+/// </summary>
+static std::chrono::microseconds cpu_time(void) {
+    using namespace std::chrono;
+    struct rusage usage;
+    ::getrusage(RUSAGE_SELF, &usage);
+    return seconds(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec)
+        + microseconds(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec);
+}
+
+
+/// <summary>
+/// Counts the samples delivered by all devices.
+/// </summary>
+static void on_sample(_In_ benchlab_handle,
+        _In_ const benchlab_sample *,
+        _In_opt_ void *ctx) {
+    auto samples = static_cast<std::atomic<std::uint64_t> *>(ctx);
+    samples->fetch_add(1, std::memory_order_relaxed);
+}
+
+
+/// <summary>
+/// Starts the emulator at <paramref name="path" /> and retrieves the path of
+/// the pseudo-terminal it created.
+/// </summary>
+static bool spawn_emulator(_Out_ emulator_process& emulator,
+        _In_z_ const char *path,
+        _In_z_ const char *latency) {
+    int pipe[2];
+    if (::pipe(pipe) != 0) {
+        std::perror("pipe");
+        return false;
+    }
+
+    posix_spawn_file_actions_t actions;
+    ::posix_spawn_file_actions_init(&actions);
+    ::posix_spawn_file_actions_adddup2(&actions, pipe[1], STDOUT_FILENO);
+    ::posix_spawn_file_actions_addclose(&actions, pipe[0]);
+
+    const char *argv[] = { path, "--report", "0", "--latency", latency,
+        nullptr };
+    auto status = ::posix_spawn(&emulator.pid, path, &actions, nullptr,
+        const_cast<char **>(argv), environ);
+    ::posix_spawn_file_actions_destroy(&actions);
+    ::close(pipe[1]);
+
+    if (status != 0) {
+        std::fprintf(stderr, "Starting the emulator failed with error %d.\n",
+            status);
+        ::close(pipe[0]);
+        return false;
+    }
+
+    // The emulator prints the path of the terminal on the first line.
+    emulator.port.clear();
+    char c;
+    while ((::read(pipe[0], &c, 1) == 1) && (c != '\n')) {
+        emulator.port += c;
+    }
+
+    ::close(pipe[0]);
+    return !emulator.port.empty();
+}
+
+
+/// <summary>
+/// Streams from all <paramref name="devices" /> for
+/// <paramref name="time" />, either on a thread per device or via
+/// <paramref name="reactor" />, and prints the CPU time this took.
+/// </summary>
+static void measure(_In_ const std::vector<benchlab_handle>& devices,
+        _In_opt_ benchlab_reactor_handle reactor,
+        _In_ const std::uint32_t period,
+        _In_ const std::chrono::seconds time) {
+    using namespace std::chrono;
+    std::atomic<std::uint64_t> samples(0);
+
+    benchlab_streaming_configuration config;
+    config.version = 1;
+    ::benchlab_initialise_streaming_configuration(&config);
+    config.callback = on_sample;
+    config.context = &samples;
+    config.period = period;
+    config.reactor = reactor;
+
+    const auto cpu_start = cpu_time();
+    const auto wall_start = steady_clock::now();
+
+    for (auto d : devices) {
+        auto hr = ::benchlab_start_streaming_ex(d, &config);
+        if (FAILED(hr)) {
+            std::fprintf(stderr, "Starting to stream failed with error "
+                "%ld.\n", static_cast<long>(hr));
+        }
+    }
+
+    std::this_thread::sleep_for(time);
+
+    for (auto d : devices) {
+        ::benchlab_stop_streaming(d);
+    }
+
+    const auto cpu = duration_cast<microseconds>(cpu_time() - cpu_start);
+    const auto wall = duration<double>(steady_clock::now() - wall_start);
+    const auto cnt = samples.load(std::memory_order_relaxed);
+
+    std::printf("%7zu  %-8s  %12.1f  %12.2f  %12.2f  %12.1f\n",
+        devices.size(),
+        (reactor != nullptr) ? "reactor" : "threads",
+        cnt / wall.count(),
+        100.0 * duration<double>(cpu).count() / wall.count(),
+        100.0 * duration<double>(cpu).count() / wall.count()
+            / devices.size(),
+        (cnt > 0) ? static_cast<double>(cpu.count()) / cnt : 0.0);
+    std::fflush(stdout);
+}
+
+
+/// <summary>
+/// The entry point of the benchmark, which compares the CPU load of streaming
+/// from an increasing number of emulated devices with one thread per device
+/// to streaming via a reactor.
+/// </summary>
+/// <param name="argc">The number of command line arguments.</param>
+/// <param name="argv">The list of command line arguments.</param>
+/// <returns>Zero in case of success, a non-zero value otherwise.</returns>
+int main(_In_ const int argc, _In_reads_(argc) const char **argv) {
+    using namespace std::chrono;
+
+    const auto emulator = ::find_argument(argc, argv, "--emulator", nullptr);
+    if (emulator == nullptr) {
+        std::printf("Usage: %s --emulator <path> [options]\n"
+            "  --devices <n>          Maximum number of emulated devices "
+            "(default: 32).\n"
+            "  --duration <s>         Duration of each measurement "
+            "(default: 5).\n"
+            "  --latency <us>         Response latency of the emulators "
+            "(default: 0).\n"
+            "  --period <ms>          Sampling period of each device "
+            "(default: 10).\n"
+            "  --threads <n>          Number of threads of the reactor "
+            "(default: 1).\n",
+            argv[0]);
+        return 0;
+    }
+
+    const auto max_devices = static_cast<std::size_t>(std::atoi(
+        ::find_argument(argc, argv, "--devices", "32")));
+    const seconds time(std::atoi(
+        ::find_argument(argc, argv, "--duration", "5")));
+    const auto latency = ::find_argument(argc, argv, "--latency", "0");
+    const auto period = static_cast<std::uint32_t>(std::atoi(
+        ::find_argument(argc, argv, "--period", "10")));
+
+    benchlab_reactor_configuration reactor_config;
+    reactor_config.version = 1;
+    ::benchlab_initialise_reactor_configuration(&reactor_config);
+    reactor_config.threads = static_cast<std::uint32_t>(std::atoi(
+        ::find_argument(argc, argv, "--threads", "1")));
+
+    visus::benchlab::unique_reactor reactor;
+    {
+        benchlab_reactor_handle handle;
+        auto hr = ::benchlab_create_reactor(&handle, &reactor_config);
+        if (FAILED(hr)) {
+            std::fprintf(stderr, "Creating the reactor failed with error "
+                "%ld.\n", static_cast<long>(hr));
+            return -1;
+        }
+        reactor.reset(handle);
+    }
+
+    std::vector<emulator_process> emulators;
+    std::vector<visus::benchlab::unique_handle> devices;
+    auto retval = 0;
+
+    for (std::size_t i = 0; i < max_devices; ++i) {
+        emulator_process e;
+        if (!::spawn_emulator(e, emulator, latency)) {
+            retval = -1;
+            break;
+        }
+        emulators.push_back(e);
+
+        visus::benchlab::unique_handle device;
+        auto hr = visus::benchlab::open(device, e.port.c_str(), nullptr);
+        if (FAILED(hr)) {
+            std::fprintf(stderr, "Opening %s failed with error %ld.\n",
+                e.port.c_str(), static_cast<long>(hr));
+            retval = -1;
+            break;
+        }
+        devices.push_back(std::move(device));
+    }
+
+    if (retval == 0) {
+        std::printf("%7s  %-8s  %12s  %12s  %12s  %12s\n",
+            "devices", "mode", "samples/s", "CPU %", "CPU %/device",
+            "CPU us/sample");
+
+        for (std::size_t n = 1; n <= devices.size(); n *= 2) {
+            std::vector<benchlab_handle> handles;
+            for (std::size_t i = 0; i < n; ++i) {
+                handles.push_back(devices[i].get());
+            }
+
+            ::measure(handles, nullptr, period, time);
+            ::measure(handles, reactor.get(), period, time);
+        }
+    }
+
+    devices.clear();
+
+    for (auto& e : emulators) {
+        ::kill(e.pid, SIGTERM);
+        ::waitpid(e.pid, nullptr, 0);
+    }
+
+    return retval;
+}